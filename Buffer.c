@@ -14,14 +14,24 @@
 #include <stdbool.h>
 #include <string.h>
 #include <ctype.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 #include "HurdLib.h"
 #include "Origin.h"
 #include "Fibsequence.h"
 #include "Buffer.h"
+#include "Checksum.h"
 
 /* State initialization macro. */
-#define STATE(var) CO(Buffer_State, var) = this->state
+#define STATE(var) CO(Buffer_State, var) = _state(this)
 
 
 /* Verify library/object header file inclusions. */
@@ -34,6 +44,78 @@
 #endif
 
 
+/* The smallest allocation made by the geometric growth policies. */
+#define BUFFER_MINIMUM 16
+
+/* The default increment of the fixed chunk growth policy. */
+#define BUFFER_CHUNK 4096
+
+/* The size of the storage held within the object state. */
+#define BUFFER_INLINE 64
+
+/* The number of bytes hexadecimal encoded at a time for output. */
+#define BUFFER_HEX_CHUNK 512
+
+/*
+ * The size classes of the locked memory pool used by secure buffers,
+ * from 64 bytes through 32 KiB, and the size of the slabs the classes
+ * are carved from.  Larger secure buffers are mapped individually.
+ */
+#define BUFFER_SECURE_MINIMUM 64
+#define BUFFER_SECURE_CLASSES 10
+#define BUFFER_SECURE_SLAB (64 * 1024)
+
+/* Select AVX2 support, which is enabled at run time if available. */
+#if defined(__x86_64__) && defined(__GNUC__)
+#define BUFFER_AVX2 1
+#endif
+
+/* The byte order of the host. */
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BUFFER_NATIVE Buffer_endian_big
+#else
+#define BUFFER_NATIVE Buffer_endian_little
+#endif
+
+/* The longest LEB128 encoding of a 64 bit integer. */
+#define BUFFER_VARINT_MAXIMUM 10
+
+
+/**
+ * The memory of a Buffer which has been shared with other Buffer
+ * objects.  The memory is copied by any of the sharing objects which
+ * modify it and is released when the last of them releases it.
+ */
+struct buffer_store
+{
+	/* The number of objects sharing the memory. */
+	atomic_uint refs;
+
+	/* The shared memory and its size. */
+	unsigned char *bf;
+	size_t allocated;
+
+	/*
+	 * The extent of the memory which held contents when it was
+	 * shared, including contents left in place by a clear.
+	 */
+	size_t used;
+};
+
+
+/**
+ * The pool of locked memory used by secure buffers.  Each size class
+ * has a list of free blocks, which is linked through the first bytes
+ * of each block.
+ */
+static struct {
+	pthread_mutex_t lock;
+	void *free[BUFFER_SECURE_CLASSES];
+} Secure_pool = {
+	.lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+
 /** Buffer private state information. */
 struct HurdLib_Buffer_State
 {
@@ -52,11 +134,58 @@ struct HurdLib_Buffer_State
 	/* The current allocation size. */
 	size_t used;
 
+	/* The extent of contents left in place by the clear method. */
+	size_t dirty;
+
+	/* The number of bytes consumed from the front of the memory. */
+	size_t head;
+
+	/* The number of bytes removed from the front of the contents. */
+	size_t consumed;
+
  	/* A pointer to the memory buffer implemented by the object. */
 	unsigned char *bf;
 
+	/* The allocated capacity of the memory buffer. */
+	size_t allocated;
+
 	/* The Fibonacci sequence used to implement dynamic object size. */
 	Fibsequence seqn;
+
+	/* The policy used to size the buffer as it grows. */
+	enum Buffer_growth growth;
+
+	/* The allocation increment of the fixed chunk policy. */
+	size_t chunk;
+
+	/* Re-allocation statistics. */
+	unsigned long int reallocs;
+	size_t copied;
+
+	/* Flag to indicate the buffer holds secret contents. */
+	_Bool secure;
+
+	/* Flag to indicate the memory is a mapping of a file. */
+	_Bool mapped;
+
+	/* The number of references to the object. */
+	atomic_uint refs;
+
+	/* The buffer which a read-only view refers to. */
+	Buffer parent;
+
+	/* The position of a view in the contents of its parent. */
+	size_t offset;
+
+	/* The memory being shared with other objects. */
+	struct buffer_store *store;
+
+	/* The checksum of the bytes added and the extent it covers. */
+	Checksum checksum;
+	size_t summed;
+
+	/* Storage used for small buffers without a heap allocation. */
+	_Alignas(16) unsigned char small[BUFFER_INLINE];
 };
 
 
@@ -76,289 +205,3507 @@ static void _init_state(CO(Buffer_State, S)) {
 	S->objid = HurdLib_Buffer_OBJID;
 
 	S->poisoned = false;
-	S->used = 0;
-	S->bf   = NULL;
+	S->used  = 0;
+	S->dirty = 0;
+	S->head	 = 0;
+	S->bf    = NULL;
+
+	S->consumed = 0;
+
+	S->allocated = 0;
+
+	S->growth = Buffer_growth_fibonacci;
+	S->chunk  = BUFFER_CHUNK;
+
+	S->reallocs = 0;
+	S->copied   = 0;
+	S->secure   = false;
+	S->mapped   = false;
+
+	atomic_init(&S->refs, 1);
+	S->parent = NULL;
+	S->offset = 0;
+	S->store  = NULL;
+
+	S->checksum = NULL;
+	S->summed   = 0;
 
 	return;
 }
 
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Buffer Buffer_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Buffer object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Buffer_State _state(CO(Buffer, this))
+
+{
+	const struct HurdLib_Buffer *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Buffer_methods )
+		return ((Buffer_Compact) this)->state;
+	return this->state;
+}
+
+
 
 /**
  * Internal private method.
  *
- * This method allocates or re-allocates memory allocation for this
- * buffer.
- * 
- * \param S	A pointer to the state of the buffer whose memory allocation
- *		is being modified.
+ * This method releases a reference to shared memory.  The memory is
+ * cleared and freed by the release of the last reference.
  *
- * \return	A boolean value is used to indicate whether or not the
- *		re-allocation was successful.  A true value indicates
- *		success.
+ * \param this		A pointer to the object releasing the memory.
+ *
+ * \param store		A pointer to the shared memory being released.
  */
 
-static _Bool _do_alloc(CO(Buffer_State, S))
+static void _release(CO(Buffer, this), struct buffer_store * const store)
 
 {
+	STATE(S);
 
-	S->bf = realloc(S->bf, S->seqn->get(S->seqn));
-	if (S->bf == NULL ) {
-		S->poisoned = true;
-		return false;
-	}
 
-	return true;
+	if ( atomic_fetch_sub(&store->refs, 1) != 1 )
+		return;
+
+	explicit_bzero(store->bf, store->used);
+	free(store->bf);
+	S->root->account(S->root, this, -(long int) store->allocated);
+	free(store);
+
+	return;
 }
 
 
 /**
- * External public method.
+ * Internal private function.
  *
- * This method implements the addition of bytes to the buffer.  If
- * the buffer supports dynamic sizing the size of the buffer in the
- * object's private state structure is expanded to accomodate the
- * required addition to the buffer.
+ * This function returns the extent of the memory of a buffer which
+ * may hold contents, including contents left in place by a clear.
  *
- * \param this	A pointer to the buffer object which bytes are being
- *		added to.
+ * \param S	A pointer to the state of the buffer.
  *
- * \param src	A pointer to the area of memory from which the bytes are
- *		to be copied.
+ * \return	The number of bytes which need to be wiped.
+ */
+
+static inline size_t _extent(CO(Buffer_State, S))
+
+{
+	return S->used > S->dirty ? S->used : S->dirty;
+}
+
+
+/**
+ * Internal private function.
  *
- * \param cnt	The number of characters to move from the source area
- *		to the buffer.
+ * This function returns the read position of a buffer to the start
+ * of its memory and discards the contents.  The bytes which have been
+ * consumed are included in the extent so they are wiped along with
+ * the remainder of the contents.
  *
- * \return	A boolean value is used to indicate the success or
- *		failure of the addition of elements to the buffer.  A
- *		true value indicates success.
+ * \param S	A pointer to the state of the buffer.
  */
 
-static _Bool add(CO(Buffer, this), CO(unsigned char *, src), size_t const cnt)
+static void _rewind(CO(Buffer_State, S))
 
 {
-	STATE(S);
+	if ( S->head == 0 )
+		return;
+
+	if ( (S->store == NULL) && !S->mapped )
+		S->dirty = S->head + _extent(S);
+	else
+		S->dirty = 0;
+
+	S->bf	     -= S->head;
+	S->allocated += S->head;
+	S->used	      = 0;
+	S->head	      = 0;
+	S->summed     = 0;
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function adds the contents which have not yet been checksummed
+ * to the checksum attached to a buffer.  Most additions are summed as
+ * soon as they are copied into the buffer, the region returned by the
+ * extend method is summed when the buffer is next modified or by the
+ * sum method.
+ *
+ * \param S	A pointer to the state of the buffer.
+ */
+
+static inline void _sum(CO(Buffer_State, S))
+
+{
+	if ( (S->checksum != NULL) && (S->used > S->summed) )
+		S->checksum->update(S->checksum, S->bf + S->summed, \
+				    S->used - S->summed);
+	S->summed = S->used;
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function moves the contents of a buffer with private memory
+ * back to the start of the memory, reclaiming the bytes which have
+ * been consumed from its front.
+ *
+ * \param S	A pointer to the state of the buffer.
+ */
+
+static void _compact(CO(Buffer_State, S))
+
+{
+	if ( S->head == 0 )
+		return;
+
+	memmove(S->bf - S->head, S->bf, S->used);
+	S->dirty      = S->head + _extent(S);
+	S->bf	     -= S->head;
+	S->allocated += S->head;
+	S->head	      = 0;
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function verifies an object is usable for reading.  For a view
+ * the window is checked against the current contents of its parent
+ * and the address of the window is refreshed, since the parent may
+ * have been re-allocated or consumed from since the view was created.
+ * A view whose window is no longer covered by its parent is poisoned.
+ *
+ * \param S	A pointer to the state of the object to be verified.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		contents of the object can be read.
+ */
+
+static _Bool _valid(CO(Buffer_State, S))
+
+{
+	size_t offset;
 
-	size_t free = S->seqn->get(S->seqn) - S->used;
+	Buffer_State P;
 
 
 	if ( S->poisoned )
 		return false;
+	if ( S->parent == NULL )
+		return true;
+
+	/* The position of the view is rebased on the unconsumed contents. */
+	P = S->parent->state;
+	if ( P->poisoned || (S->offset < P->consumed) )
+		goto poisoned;
+	offset = S->offset - P->consumed;
+	if ( (offset > P->used) || (S->used > P->used - offset) )
+		goto poisoned;
+
+	S->bf = P->bf == NULL ? NULL : P->bf + offset;
+	return true;
 
-	if ( cnt > free )
-		do {
-			S->seqn->next(S->seqn);
-			free = S->seqn->get(S->seqn) - S->used;
-		} while ( cnt > free );
 
-	if ( !_do_alloc(S) )
-		return false;
-	memcpy(S->bf + S->used, src, cnt);
-	S->used += cnt;
+ poisoned:
+	S->poisoned = true;
+	return false;
+}
 
-	return true;
+
+/**
+ * Internal private function.
+ *
+ * This function rounds a size up to a multiple of an increment.
+ *
+ * \param size		The size to be rounded.
+ *
+ * \param increment	The increment the size is to be rounded to.
+ *
+ * \return		The rounded size, or the original size if the
+ *			rounded size cannot be represented.
+ */
+
+static inline size_t _round(size_t const size, size_t const increment)
+
+{
+	size_t pad = (increment - size % increment) % increment;
+
+
+	if ( pad > SIZE_MAX - size )
+		return size;
+	return size + pad;
 }
 
 
 /**
- * External public method.
+ * Internal private method.
  *
- * This method implements the addition of bytes to the buffer by a
- * second Buffer object.  It is simply a fronting function for the
- * add method of the object.
+ * This method computes the capacity which the buffer is to be grown
+ * to in order to hold the specified number of bytes, according to the
+ * growth policy of the buffer.  A policy which would overflow the
+ * size of the allocation falls back to the requested size.
  *
- * \param this	A pointer to the buffer object which bytes are being
- *		added to.
+ * \param S	A pointer to the state of the buffer which is to be
+ *		grown.
  *
- * \param bf	The Buffer object which is to be added to the current
- *		Buffer.
+ * \param need	The number of bytes the buffer must hold.
  *
- * \return	A boolean value is used to indicate the success or
- *		failure of the addition of elements to the buffer.  A
- *		true value indicates success.
+ * \return	The new capacity of the buffer.
  */
 
-static _Bool add_Buffer(CO(Buffer, this), CO(Buffer, bf))
+static size_t _capacity(CO(Buffer_State, S), size_t const need)
 
 {
-	return add(this, bf->get(bf), bf->size(bf));
+	size_t size = S->allocated;
+
+	static size_t page = 0;
+
+
+	if ( (S->bf == NULL) && (need <= BUFFER_INLINE) && !S->secure )
+		return BUFFER_INLINE;
+
+	switch ( S->growth ) {
+		case Buffer_growth_fibonacci:
+			size = S->seqn->getAbove(S->seqn, need);
+			break;
+
+		case Buffer_growth_geometric_15:
+		case Buffer_growth_geometric_2:
+			if ( size < BUFFER_MINIMUM )
+				size = BUFFER_MINIMUM;
+			while ( size < need ) {
+				if ( size > SIZE_MAX / 2 ) {
+					size = need;
+					break;
+				}
+				if ( S->growth == Buffer_growth_geometric_2 )
+					size *= 2;
+				else
+					size += size / 2;
+			}
+			break;
+
+		case Buffer_growth_page:
+			if ( page == 0 )
+				page = sysconf(_SC_PAGESIZE);
+			size = _round(need, page);
+			break;
+
+		case Buffer_growth_chunk:
+			size = _round(need, S->chunk);
+			break;
+	}
+
+	return size;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function maps memory which is locked against being paged out
+ * and excluded from core dumps.
+ *
+ * \param size	The size of the mapping, a multiple of the page size.
+ *
+ * \return	A pointer to the mapped memory.  A NULL value indicates
+ *		the memory could not be mapped or locked.
+ */
+
+static void *_secure_map(size_t const size)
+
+{
+	void *mp;
+
+
+	mp = mmap(NULL, size, PROT_READ | PROT_WRITE, \
+		  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if ( mp == MAP_FAILED )
+		return NULL;
+
+	if ( mlock(mp, size) != 0 ) {
+		munmap(mp, size);
+		return NULL;
+	}
+#if defined(MADV_DONTDUMP)
+	madvise(mp, size, MADV_DONTDUMP);
+#endif
+
+	return mp;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function allocates a block of locked memory for a secure
+ * buffer.  Requests up to the largest size class are taken from the
+ * free list of the class, which is refilled a slab at a time, so the
+ * typical allocation costs only a list operation.
+ *
+ * \param size	A pointer to the requested size, which is updated
+ *		to the size of the block which was allocated.
+ *
+ * \return	A pointer to the allocated block.  A NULL value
+ *		indicates the allocation failed.
+ */
+
+static unsigned char *_secure_alloc(size_t * const size)
+
+{
+	unsigned int slot = 0;
+
+	size_t lp,
+	       block = BUFFER_SECURE_MINIMUM;
+
+	unsigned char *bp = NULL,
+		      *slab;
+
+
+	while ( (block < *size) && (slot < BUFFER_SECURE_CLASSES) ) {
+		block <<= 1;
+		++slot;
+	}
+
+	/* Map large buffers individually. */
+	if ( slot == BUFFER_SECURE_CLASSES ) {
+		block = _round(*size, sysconf(_SC_PAGESIZE));
+		if ( (block < *size) || ((bp = _secure_map(block)) == NULL) )
+			return NULL;
+		*size = block;
+		return bp;
+	}
+
+	pthread_mutex_lock(&Secure_pool.lock);
+	if ( Secure_pool.free[slot] == NULL ) {
+		if ( (slab = _secure_map(BUFFER_SECURE_SLAB)) == NULL )
+			goto done;
+		for (lp= 0; lp < BUFFER_SECURE_SLAB; lp += block) {
+			*(void **) (slab + lp) = Secure_pool.free[slot];
+			Secure_pool.free[slot] = slab + lp;
+		}
+	}
+
+	bp = Secure_pool.free[slot];
+	Secure_pool.free[slot] = *(void **) bp;
+	*(void **) bp = NULL;
+	*size = block;
+
+
+ done:
+	pthread_mutex_unlock(&Secure_pool.lock);
+	return bp;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function wipes a block of locked memory and returns it to the
+ * pool, or unmaps it if it was mapped individually.
+ *
+ * \param bp	A pointer to the block to be released.
+ *
+ * \param size	The size of the block.
+ */
+
+static void _secure_free(unsigned char * const bp, size_t const size)
+
+{
+	unsigned int slot = 0;
+
+	size_t block = BUFFER_SECURE_MINIMUM;
+
+
+	explicit_bzero(bp, size);
+
+	while ( (block < size) && (slot < BUFFER_SECURE_CLASSES) ) {
+		block <<= 1;
+		++slot;
+	}
+	if ( slot == BUFFER_SECURE_CLASSES ) {
+		munmap(bp, size);
+		return;
+	}
+
+	pthread_mutex_lock(&Secure_pool.lock);
+	*(void **) bp = Secure_pool.free[slot];
+	Secure_pool.free[slot] = bp;
+	pthread_mutex_unlock(&Secure_pool.lock);
+
+	return;
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method moves the contents of a secure buffer to a larger
+ * block of locked memory.  The contents are copied explicitly and
+ * the previous block is wiped, so no copy of the contents is left
+ * behind in memory which has been released.
+ *
+ * \param this	A pointer to the buffer whose memory is to be grown.
+ *
+ * \param size	The new capacity of the buffer.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		memory was allocated.
+ */
+
+static _Bool _secure_grow(CO(Buffer, this), size_t size)
+
+{
+	STATE(S);
+
+	unsigned char *bf;
+
+
+	if ( (bf = _secure_alloc(&size)) == NULL ) {
+		S->poisoned = true;
+		return false;
+	}
+
+	if ( S->bf != NULL ) {
+		memcpy(bf, S->bf, S->used);
+		_secure_free(S->bf, S->allocated);
+		++S->reallocs;
+		S->copied += S->used;
+	}
+
+	S->root->account(S->root, this, (long int) size - \
+			 (long int) S->allocated);
+	S->bf	     = bf;
+	S->allocated = size;
+
+	return true;
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method allocates or re-allocates memory allocation for this
+ * buffer.  An initial allocation which fits in the storage held in
+ * the object state uses that storage, the contents are moved to the
+ * heap once they outgrow it.  The change in the size of the heap
+ * allocation is reported to the root object.  The existing
+ * allocation is retained if the re-allocation fails so that it is
+ * released when the object is destroyed.
+ * 
+ * \param this	A pointer to the buffer whose memory allocation is
+ *		being modified.
+ *
+ * \param size	The new capacity of the buffer.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		re-allocation was successful.  A true value indicates
+ *		success.
+ */
+
+static _Bool _do_alloc(CO(Buffer, this), size_t const size)
+
+{
+	STATE(S);
+
+	size_t held = S->allocated;
+
+	unsigned char *bf;
+
+
+	if ( S->secure )
+		return _secure_grow(this, size);
+
+	/* Use the inline storage for a small initial allocation. */
+	if ( (S->bf == NULL) && (size <= sizeof(S->small)) ) {
+		S->bf	     = S->small;
+		S->allocated = sizeof(S->small);
+		return true;
+	}
+
+	if ( S->bf == S->small ) {
+		if ( (bf = malloc(size)) == NULL ) {
+			S->poisoned = true;
+			return false;
+		}
+		memcpy(bf, S->small, S->used);
+		memset(S->small, '\0', _extent(S));
+		S->dirty = 0;
+		held	 = 0;
+	}
+	else if ( (bf = realloc(S->bf, size)) == NULL ) {
+		S->poisoned = true;
+		return false;
+	}
+
+	if ( S->bf != NULL ) {
+		++S->reallocs;
+		S->copied += S->used;
+	}
+
+	S->root->account(S->root, this, (long int) size - (long int) held);
+	S->bf	     = bf;
+	S->allocated = size;
+
+	return true;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function converts a hexadecimal character to the value of
+ * the nybble which it encodes.
+ *
+ * \param c	The character to be converted.
+ *
+ * \return	The value of the nybble is returned.  A negative value
+ *		indicates the character is not a hexadecimal digit.
+ */
+
+static inline int _nybble(unsigned char c)
+
+{
+	if ( (unsigned char) (c - '0') < 10 )
+		return c - '0';
+
+	c |= 0x20;
+	if ( (unsigned char) (c - 'a') < 6 )
+		return c - 'a' + 10;
+
+	return -1;
+}
+
+
+#if defined(__SSE2__)
+/**
+ * Internal private function.
+ *
+ * This function converts the nybble values in a vector to lower case
+ * hexadecimal characters.
+ *
+ * \param v	The vector of nybble values.
+ *
+ * \return	The vector of hexadecimal characters.
+ */
+
+static inline __m128i _hex_chars_sse2(__m128i const v)
+
+{
+	__m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(9)), \
+				      _mm_set1_epi8('a' - '0' - 10));
+
+
+	return _mm_add_epi8(_mm_add_epi8(v, _mm_set1_epi8('0')), alpha);
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function converts a vector of hexadecimal characters to the
+ * values of the nybbles which they encode.
+ *
+ * \param c	The vector of characters.
+ *
+ * \param valid	A pointer to the vector which will be set to a mask
+ *		of the characters which are valid hexadecimal digits.
+ *
+ * \return	The vector of nybble values.
+ */
+
+static inline __m128i _hex_values_sse2(__m128i const c, __m128i * const valid)
+
+{
+	__m128i digit,
+		alpha,
+		lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+
+
+	digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), \
+			      _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+	alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), \
+			      _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+	*valid = _mm_or_si128(digit, alpha);
+
+	return _mm_or_si128(_mm_and_si128(digit, \
+			    _mm_sub_epi8(c, _mm_set1_epi8('0'))), \
+			    _mm_and_si128(alpha, _mm_sub_epi8(lower, \
+			    _mm_set1_epi8('a' - 10))));
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function hexadecimal encodes blocks of 16 bytes using SSE2
+ * instructions.
+ *
+ * \param src	A pointer to the bytes to be encoded.
+ *
+ * \param cnt	The number of bytes available to be encoded.
+ *
+ * \param dest	A pointer to the memory which the characters are to be
+ *		written to.
+ *
+ * \return	The number of bytes which were encoded.
+ */
+
+static size_t _hex_encode_sse2(unsigned char const *src, size_t const cnt, \
+			       char *dest)
+
+{
+	size_t lp;
+
+	__m128i v,
+		hi,
+		lo,
+		mask = _mm_set1_epi8(0x0f);
+
+
+	for (lp= 0; lp + 16 <= cnt; lp += 16) {
+		v  = _mm_loadu_si128((__m128i const *) (src + lp));
+		hi = _hex_chars_sse2(_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+		lo = _hex_chars_sse2(_mm_and_si128(v, mask));
+
+		_mm_storeu_si128((__m128i *) (dest + 2 * lp), \
+				 _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *) (dest + 2 * lp + 16), \
+				 _mm_unpackhi_epi8(hi, lo));
+	}
+
+	return lp;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function decodes blocks of 32 hexadecimal characters using
+ * SSE2 instructions.  Decoding stops at the first block containing an
+ * invalid character.
+ *
+ * \param src	A pointer to the characters to be decoded.
+ *
+ * \param cnt	The number of bytes available to be decoded.
+ *
+ * \param dest	A pointer to the memory which the bytes are to be
+ *		written to.
+ *
+ * \return	The number of bytes which were decoded.
+ */
+
+static size_t _hex_decode_sse2(char const *src, size_t const cnt, \
+			       unsigned char *dest)
+
+{
+	size_t lp;
+
+	__m128i a,
+		b,
+		valid_a,
+		valid_b,
+		mask = _mm_set1_epi16(0x00ff);
+
+
+	for (lp= 0; lp + 16 <= cnt; lp += 16) {
+		a = _mm_loadu_si128((__m128i const *) (src + 2 * lp));
+		b = _mm_loadu_si128((__m128i const *) (src + 2 * lp + 16));
+
+		a = _hex_values_sse2(a, &valid_a);
+		b = _hex_values_sse2(b, &valid_b);
+		if ( _mm_movemask_epi8(_mm_and_si128(valid_a, valid_b)) != \
+		     0xffff )
+			break;
+
+		/* Combine the high and low nybble of each byte. */
+		a = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(a, 4), \
+					       _mm_srli_epi16(a, 8)), mask);
+		b = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(b, 4), \
+					       _mm_srli_epi16(b, 8)), mask);
+		_mm_storeu_si128((__m128i *) (dest + lp), \
+				 _mm_packus_epi16(a, b));
+	}
+
+	return lp;
+}
+#endif
+
+
+#if defined(BUFFER_AVX2)
+/**
+ * Internal private function.
+ *
+ * This function hexadecimal encodes blocks of 32 bytes using AVX2
+ * instructions.
+ *
+ * \param src	A pointer to the bytes to be encoded.
+ *
+ * \param cnt	The number of bytes available to be encoded.
+ *
+ * \param dest	A pointer to the memory which the characters are to be
+ *		written to.
+ *
+ * \return	The number of bytes which were encoded.
+ */
+
+static __attribute__((target("avx2"))) size_t \
+_hex_encode_avx2(unsigned char const *src, size_t const cnt, char *dest)
+
+{
+	size_t lp;
+
+	__m256i v,
+		hi,
+		lo,
+		first,
+		second,
+		mask  = _mm256_set1_epi8(0x0f),
+		nine  = _mm256_set1_epi8(9),
+		zero  = _mm256_set1_epi8('0'),
+		alpha = _mm256_set1_epi8('a' - '0' - 10);
+
+
+	for (lp= 0; lp + 32 <= cnt; lp += 32) {
+		v  = _mm256_loadu_si256((__m256i const *) (src + lp));
+		hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask);
+		lo = _mm256_and_si256(v, mask);
+
+		hi = _mm256_add_epi8(_mm256_add_epi8(hi, zero), \
+			_mm256_and_si256(_mm256_cmpgt_epi8(hi, nine), alpha));
+		lo = _mm256_add_epi8(_mm256_add_epi8(lo, zero), \
+			_mm256_and_si256(_mm256_cmpgt_epi8(lo, nine), alpha));
+
+		/* The unpack operates within lanes, restore the order. */
+		first  = _mm256_unpacklo_epi8(hi, lo);
+		second = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i *) (dest + 2 * lp), \
+				    _mm256_permute2x128_si256(first, second, \
+							      0x20));
+		_mm256_storeu_si256((__m256i *) (dest + 2 * lp + 32), \
+				    _mm256_permute2x128_si256(first, second, \
+							      0x31));
+	}
+
+	return lp;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function decodes blocks of 64 hexadecimal characters using
+ * AVX2 instructions.  Decoding stops at the first block containing
+ * an invalid character.
+ *
+ * \param src	A pointer to the characters to be decoded.
+ *
+ * \param cnt	The number of bytes available to be decoded.
+ *
+ * \param dest	A pointer to the memory which the bytes are to be
+ *		written to.
+ *
+ * \return	The number of bytes which were decoded.
+ */
+
+static __attribute__((target("avx2"))) size_t \
+_hex_decode_avx2(char const *src, size_t const cnt, unsigned char *dest)
+
+{
+	size_t lp;
+
+	__m256i c[2],
+		lower,
+		digit,
+		alpha,
+		valid,
+		mask = _mm256_set1_epi16(0x00ff);
+
+	unsigned int lp1;
+
+
+	for (lp= 0; lp + 32 <= cnt; lp += 32) {
+		valid = _mm256_set1_epi8(-1);
+
+		for (lp1= 0; lp1 < 2; ++lp1) {
+			c[lp1] = _mm256_loadu_si256((__m256i const *) \
+						    (src + 2 * lp + 32 * lp1));
+			lower  = _mm256_or_si256(c[lp1], \
+						 _mm256_set1_epi8(0x20));
+
+			digit = _mm256_and_si256(_mm256_cmpgt_epi8(c[lp1], \
+				_mm256_set1_epi8('0' - 1)), \
+				_mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), \
+						  c[lp1]));
+			alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, \
+				_mm256_set1_epi8('a' - 1)), \
+				_mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), \
+						  lower));
+			valid = _mm256_and_si256(valid, \
+						 _mm256_or_si256(digit, alpha));
+
+			c[lp1] = _mm256_or_si256(_mm256_and_si256(digit, \
+				_mm256_sub_epi8(c[lp1], _mm256_set1_epi8('0'))), \
+				_mm256_and_si256(alpha, _mm256_sub_epi8(lower, \
+				_mm256_set1_epi8('a' - 10))));
+			c[lp1] = _mm256_and_si256(_mm256_or_si256( \
+				_mm256_slli_epi16(c[lp1], 4), \
+				_mm256_srli_epi16(c[lp1], 8)), mask);
+		}
+
+		if ( _mm256_movemask_epi8(valid) != -1 )
+			break;
+
+		/* The pack operates within lanes, restore the order. */
+		_mm256_storeu_si256((__m256i *) (dest + lp), \
+				    _mm256_permute4x64_epi64( \
+				    _mm256_packus_epi16(c[0], c[1]), 0xd8));
+	}
+
+	return lp;
+}
+#endif
+
+
+/**
+ * Internal private function.
+ *
+ * This function encodes bytes as lower case hexadecimal characters
+ * using the widest vector instructions supported by the processor.
+ *
+ * \param src	A pointer to the bytes to be encoded.
+ *
+ * \param cnt	The number of bytes to be encoded.
+ *
+ * \param dest	A pointer to the memory which the characters are to be
+ *		written to, it must hold twice the number of bytes.
+ */
+
+static void _hex_encode(unsigned char const *src, size_t const cnt, \
+			char *dest)
+
+{
+	static char const digits[] = "0123456789abcdef";
+
+	size_t lp = 0;
+
+
+#if defined(BUFFER_AVX2)
+	if ( __builtin_cpu_supports("avx2") )
+		lp = _hex_encode_avx2(src, cnt, dest);
+#endif
+#if defined(__SSE2__)
+	lp += _hex_encode_sse2(src + lp, cnt - lp, dest + 2 * lp);
+#endif
+
+	for (; lp < cnt; ++lp) {
+		dest[2 * lp]	 = digits[src[lp] >> 4];
+		dest[2 * lp + 1] = digits[src[lp] & 0x0f];
+	}
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function decodes hexadecimal characters, in either case, using
+ * the widest vector instructions supported by the processor.
+ *
+ * \param src	A pointer to the characters to be decoded, it must hold
+ *		twice the number of bytes to be decoded.
+ *
+ * \param cnt	The number of bytes to be decoded.
+ *
+ * \param dest	A pointer to the memory which the bytes are to be
+ *		written to.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		characters were decoded.  A false value indicates an
+ *		invalid character was encountered.
+ */
+
+static _Bool _hex_decode(char const *src, size_t const cnt, \
+			 unsigned char *dest)
+
+{
+	int hi,
+	    lo;
+
+	size_t lp = 0;
+
+
+#if defined(BUFFER_AVX2)
+	if ( __builtin_cpu_supports("avx2") )
+		lp = _hex_decode_avx2(src, cnt, dest);
+#endif
+#if defined(__SSE2__)
+	lp += _hex_decode_sse2(src + 2 * lp, cnt - lp, dest + lp);
+#endif
+
+	for (; lp < cnt; ++lp) {
+		hi = _nybble(src[2 * lp]);
+		lo = _nybble(src[2 * lp + 1]);
+		if ( (hi | lo) < 0 )
+			return false;
+		dest[lp] = (hi << 4) | lo;
+	}
+
+	return true;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the alphabet used for base64 encoding.
+ *
+ * \param url	A flag indicating whether or not the URL and filename
+ *		safe alphabet is to be used.
+ *
+ * \return	A pointer to the 64 characters of the alphabet.
+ */
+
+static inline char const *_base64_set(_Bool const url)
+
+{
+	static char const set[2][65] = {
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ" \
+		"abcdefghijklmnopqrstuvwxyz0123456789+/",
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZ" \
+		"abcdefghijklmnopqrstuvwxyz0123456789-_"
+	};
+
+
+	return set[url];
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function computes the number of characters needed to base64
+ * encode a number of bytes.  The standard alphabet is padded to a
+ * multiple of four characters while the URL alphabet is unpadded.
+ *
+ * \param cnt	The number of bytes to be encoded.
+ *
+ * \param url	A flag indicating whether or not the URL alphabet is
+ *		to be used.
+ *
+ * \return	The number of characters in the encoding.
+ */
+
+static inline size_t _base64_length(size_t const cnt, _Bool const url)
+
+{
+	if ( (cnt % 3) == 0 )
+		return 4 * (cnt / 3);
+	return 4 * (cnt / 3) + (url ? cnt % 3 + 1 : 4);
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function converts a base64 character into its value.
+ *
+ * \param c	The character to be converted.
+ *
+ * \param set	The alphabet in use.
+ *
+ * \return	The value of the character or -1 if the character is
+ *		not a member of the alphabet.
+ */
+
+static inline int _base64_value(unsigned char const c, char const *set)
+
+{
+	if ( (unsigned char) (c - 'A') < 26 )
+		return c - 'A';
+	if ( (unsigned char) (c - 'a') < 26 )
+		return c - 'a' + 26;
+	if ( (unsigned char) (c - '0') < 10 )
+		return c - '0' + 52;
+	if ( c == (unsigned char) set[62] )
+		return 62;
+	if ( c == (unsigned char) set[63] )
+		return 63;
+
+	return -1;
+}
+
+
+#if defined(BUFFER_AVX2)
+/**
+ * Internal private function.
+ *
+ * This function base64 encodes blocks of 24 bytes using AVX2
+ * instructions.  Each lane of the vector converts 12 bytes into 16
+ * characters, so 28 bytes must be readable for each block.
+ *
+ * \param src	A pointer to the bytes to be encoded.
+ *
+ * \param cnt	The number of bytes available to be encoded.
+ *
+ * \param dest	A pointer to the memory which the characters are to be
+ *		written to.
+ *
+ * \param set	The alphabet to be used.
+ *
+ * \return	The number of bytes which were encoded.
+ */
+
+static __attribute__((target("avx2"))) size_t \
+_base64_encode_avx2(unsigned char const *src, size_t const cnt, \
+		    char *dest, char const *set)
+
+{
+	size_t lp;
+
+	char const c62 = set[62] - 62,
+		   c63 = set[63] - 63,
+		   c52 = '0' - 52,
+		   c26 = 'a' - 26;
+
+	__m256i v,
+		hi,
+		lo,
+		spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, \
+					  7, 6, 8, 7, 10, 9, 11, 10, \
+					  1, 0, 2, 1, 4, 3, 5, 4, \
+					  7, 6, 8, 7, 10, 9, 11, 10),
+		shift  = _mm256_setr_epi8(c26, c52, c52, c52, c52, c52, \
+					  c52, c52, c52, c52, c52, c62, \
+					  c63, 'A', 0, 0, \
+					  c26, c52, c52, c52, c52, c52, \
+					  c52, c52, c52, c52, c52, c62, \
+					  c63, 'A', 0, 0);
+
+
+	for (lp= 0; lp + 28 <= cnt; lp += 24) {
+		v = _mm256_inserti128_si256(_mm256_castsi128_si256( \
+			_mm_loadu_si128((__m128i const *) (src + lp))), \
+			_mm_loadu_si128((__m128i const *) (src + lp + 12)), 1);
+
+		/* Split each group of three bytes into four sextets. */
+		v  = _mm256_shuffle_epi8(v, spread);
+		hi = _mm256_mulhi_epu16(_mm256_and_si256(v, \
+			_mm256_set1_epi32(0x0fc0fc00)), \
+			_mm256_set1_epi32(0x04000040));
+		lo = _mm256_mullo_epi16(_mm256_and_si256(v, \
+			_mm256_set1_epi32(0x003f03f0)), \
+			_mm256_set1_epi32(0x01000010));
+		v  = _mm256_or_si256(hi, lo);
+
+		/*
+		 * Select the offset which maps each range of sextet
+		 * values onto its characters.
+		 */
+		hi = _mm256_subs_epu8(v, _mm256_set1_epi8(51));
+		hi = _mm256_or_si256(hi, _mm256_and_si256( \
+			_mm256_cmpgt_epi8(_mm256_set1_epi8(26), v), \
+			_mm256_set1_epi8(13)));
+		v  = _mm256_add_epi8(v, _mm256_shuffle_epi8(shift, hi));
+
+		_mm256_storeu_si256((__m256i *) (dest + 4 * (lp / 3)), v);
+	}
+
+	return lp;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function decodes blocks of 32 base64 characters using AVX2
+ * instructions.  Decoding stops at the first block containing a
+ * character which is not in the alphabet.
+ *
+ * \param src	A pointer to the characters to be decoded.
+ *
+ * \param cnt	The number of characters available to be decoded.
+ *
+ * \param dest	A pointer to the memory which the bytes are to be
+ *		written to.
+ *
+ * \param set	The alphabet to be used.
+ *
+ * \return	The number of characters which were decoded.
+ */
+
+static __attribute__((target("avx2"))) size_t \
+_base64_decode_avx2(char const *src, size_t const cnt, \
+		    unsigned char *dest, char const *set)
+
+{
+	size_t lp;
+
+	__m256i c,
+		upper,
+		lower,
+		digit,
+		c62,
+		c63,
+		v,
+		s62 = _mm256_set1_epi8(set[62]),
+		s63 = _mm256_set1_epi8(set[63]),
+		o62 = _mm256_set1_epi8(62 - set[62]),
+		o63 = _mm256_set1_epi8(63 - set[63]);
+
+
+	/*
+	 * The alphabet is held in registers since the stores through
+	 * the destination could otherwise alias it.
+	 */
+	for (lp= 0; lp + 32 <= cnt; lp += 32) {
+		c = _mm256_loadu_si256((__m256i const *) (src + lp));
+
+		upper = _mm256_and_si256(_mm256_cmpgt_epi8(c, \
+			_mm256_set1_epi8('A' - 1)), \
+			_mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), c));
+		lower = _mm256_and_si256(_mm256_cmpgt_epi8(c, \
+			_mm256_set1_epi8('a' - 1)), \
+			_mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), c));
+		digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, \
+			_mm256_set1_epi8('0' - 1)), \
+			_mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+		c62 = _mm256_cmpeq_epi8(c, s62);
+		c63 = _mm256_cmpeq_epi8(c, s63);
+
+		v = _mm256_or_si256(_mm256_or_si256(upper, lower), \
+				    _mm256_or_si256(digit, \
+				    _mm256_or_si256(c62, c63)));
+		if ( _mm256_movemask_epi8(v) != -1 )
+			break;
+
+		v = _mm256_or_si256(_mm256_or_si256( \
+			_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), \
+			_mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))), \
+			_mm256_or_si256(_mm256_and_si256(digit, \
+			_mm256_set1_epi8(52 - '0')), _mm256_or_si256( \
+			_mm256_and_si256(c62, o62), \
+			_mm256_and_si256(c63, o63))));
+		v = _mm256_add_epi8(c, v);
+
+		/* Merge each group of four sextets into three bytes. */
+		v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+		v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+		v = _mm256_shuffle_epi8(v, _mm256_setr_epi8( \
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, \
+			-1, -1, -1, -1, \
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, \
+			-1, -1, -1, -1));
+		v = _mm256_permutevar8x32_epi32(v, \
+				_mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+
+		_mm_storeu_si128((__m128i *) (dest + 3 * (lp / 4)), \
+				 _mm256_castsi256_si128(v));
+		_mm_storel_epi64((__m128i *) (dest + 3 * (lp / 4) + 16), \
+				 _mm256_extracti128_si256(v, 1));
+	}
+
+	return lp;
+}
+#endif
+
+
+/**
+ * Internal private function.
+ *
+ * This function base64 encodes bytes using the widest vector
+ * instructions supported by the processor.
+ *
+ * \param src	A pointer to the bytes to be encoded.
+ *
+ * \param cnt	The number of bytes to be encoded.
+ *
+ * \param dest	A pointer to the memory which the characters are to be
+ *		written to, it must hold the length of the encoding.
+ *
+ * \param url	A flag indicating whether or not the unpadded URL
+ *		alphabet is to be used.
+ */
+
+static void _base64_encode(unsigned char const *src, size_t const cnt, \
+			   char *dest, _Bool const url)
+
+{
+	char const *set = _base64_set(url);
+
+	uint32_t v;
+
+	size_t lp = 0;
+
+
+#if defined(BUFFER_AVX2)
+	if ( __builtin_cpu_supports("avx2") )
+		lp = _base64_encode_avx2(src, cnt, dest, set);
+#endif
+	dest += 4 * (lp / 3);
+
+	for (; lp + 3 <= cnt; lp += 3) {
+		v = (src[lp] << 16) | (src[lp + 1] << 8) | src[lp + 2];
+		*dest++ = set[v >> 18];
+		*dest++ = set[(v >> 12) & 0x3f];
+		*dest++ = set[(v >> 6) & 0x3f];
+		*dest++ = set[v & 0x3f];
+	}
+
+	if ( lp == cnt )
+		return;
+
+	v = src[lp] << 16;
+	if ( (cnt - lp) == 2 )
+		v |= src[lp + 1] << 8;
+	*dest++ = set[v >> 18];
+	*dest++ = set[(v >> 12) & 0x3f];
+	if ( (cnt - lp) == 2 )
+		*dest++ = set[(v >> 6) & 0x3f];
+	else if ( !url )
+		*dest++ = '=';
+	if ( !url )
+		*dest = '=';
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function decodes base64 characters, with any padding removed,
+ * using the widest vector instructions supported by the processor.
+ *
+ * \param src	A pointer to the characters to be decoded.
+ *
+ * \param cnt	The number of characters to be decoded, the remainder
+ *		of dividing it by four cannot be one.
+ *
+ * \param dest	A pointer to the memory which the bytes are to be
+ *		written to.
+ *
+ * \param url	A flag indicating whether or not the URL alphabet is
+ *		to be used.
+ *
+ * \param strict	A flag indicating whether or not unused bits in
+ *			the final character must be zero.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		characters were decoded.  A false value indicates an
+ *		invalid character or encoding was encountered.
+ */
+
+static _Bool _base64_decode(char const *src, size_t const cnt, \
+			    unsigned char *dest, _Bool const url, \
+			    _Bool const strict)
+
+{
+	char const *set = _base64_set(url);
+
+	int a,
+	    b,
+	    c,
+	    d;
+
+	size_t lp = 0;
+
+
+#if defined(BUFFER_AVX2)
+	if ( __builtin_cpu_supports("avx2") )
+		lp = _base64_decode_avx2(src, cnt, dest, set);
+#endif
+	dest += 3 * (lp / 4);
+
+	for (; lp + 4 <= cnt; lp += 4) {
+		a = _base64_value(src[lp], set);
+		b = _base64_value(src[lp + 1], set);
+		c = _base64_value(src[lp + 2], set);
+		d = _base64_value(src[lp + 3], set);
+		if ( (a | b | c | d) < 0 )
+			return false;
+
+		*dest++ = (a << 2) | (b >> 4);
+		*dest++ = (b << 4) | (c >> 2);
+		*dest++ = (c << 6) | d;
+	}
+
+	if ( lp == cnt )
+		return true;
+
+	a = _base64_value(src[lp], set);
+	b = _base64_value(src[lp + 1], set);
+	c = (cnt - lp) == 3 ? _base64_value(src[lp + 2], set) : 0;
+	if ( (a | b | c) < 0 )
+		return false;
+
+	*dest++ = (a << 2) | (b >> 4);
+	if ( (cnt - lp) == 3 ) {
+		*dest = (b << 4) | (c >> 2);
+		if ( strict && ((c & 0x03) != 0) )
+			return false;
+	}
+	else if ( strict && ((b & 0x0f) != 0) )
+		return false;
+
+	return true;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function verifies the description of a fixed width integer.
+ *
+ * \param width	The number of bytes in the integer.
+ *
+ * \param order	The byte order of the integer.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		integer is one of the supported widths and orders.
+ */
+
+static inline _Bool _int_format(size_t const width, \
+				enum Buffer_endian const order)
+
+{
+	if ( (order != Buffer_endian_big) && (order != Buffer_endian_little) )
+		return false;
+	return (width == 1) || (width == 2) || (width == 4) || (width == 8);
+}
+
+
+#if defined(BUFFER_AVX2)
+/**
+ * Internal private function.
+ *
+ * This function reverses the byte order of the integers in blocks of
+ * 32 bytes using AVX2 instructions.
+ *
+ * \param dest	A pointer to the memory which the integers are to be
+ *		written to.
+ *
+ * \param src	A pointer to the integers to be converted.
+ *
+ * \param cnt	The number of bytes available to be converted.
+ *
+ * \param width	The width of the integers, which must be two, four
+ *		or eight bytes.
+ *
+ * \return	The number of bytes which were converted.
+ */
+
+static __attribute__((target("avx2"))) size_t \
+_swap_ints_avx2(unsigned char *dest, unsigned char const *src, \
+		size_t const cnt, size_t const width)
+
+{
+	size_t lp;
+
+	__m256i mask;
+
+
+	/* The shuffle operates within lanes so each lane has the mask. */
+	if ( width == 2 )
+		mask = _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 3, 2, \
+			5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+	else if ( width == 4 )
+		mask = _mm256_broadcastsi128_si256(_mm_setr_epi8(3, 2, 1, 0, \
+			7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+	else
+		mask = _mm256_broadcastsi128_si256(_mm_setr_epi8(7, 6, 5, 4, \
+			3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
+
+	for (lp= 0; lp + 32 <= cnt; lp += 32) {
+		_mm256_storeu_si256((__m256i *) (dest + lp), \
+			_mm256_shuffle_epi8(_mm256_loadu_si256( \
+				(__m256i const *) (src + lp)), mask));
+	}
+
+	return lp;
+}
+#endif
+
+
+/**
+ * Internal private function.
+ *
+ * This function copies an array of fixed width integers, reversing
+ * the bytes of each integer if the requested byte order is not the
+ * order of the host.  The conversion is its own inverse so it is used
+ * for both serialization and de-serialization.
+ *
+ * \param dest	A pointer to the memory which the integers are to be
+ *		written to.
+ *
+ * \param src	A pointer to the integers to be converted.
+ *
+ * \param count	The number of integers to be converted.
+ *
+ * \param width	The width of the integers.
+ *
+ * \param order	The byte order of the serialized integers.
+ */
+
+static void _order_ints(unsigned char *dest, unsigned char const *src, \
+			size_t const count, size_t const width, \
+			enum Buffer_endian const order)
+
+{
+	size_t lp = 0,
+	       cnt = count * width;
+
+	uint16_t v16;
+
+	uint32_t v32;
+
+	uint64_t v64;
+
+
+	if ( cnt == 0 )
+		return;
+	if ( (order == BUFFER_NATIVE) || (width == 1) ) {
+		memcpy(dest, src, cnt);
+		return;
+	}
+
+#if defined(BUFFER_AVX2)
+	if ( __builtin_cpu_supports("avx2") )
+		lp = _swap_ints_avx2(dest, src, cnt, width);
+#endif
+
+	for (; lp < cnt; lp += width) {
+		switch ( width ) {
+			case 2:
+				memcpy(&v16, src + lp, sizeof(v16));
+				v16 = __builtin_bswap16(v16);
+				memcpy(dest + lp, &v16, sizeof(v16));
+				break;
+			case 4:
+				memcpy(&v32, src + lp, sizeof(v32));
+				v32 = __builtin_bswap32(v32);
+				memcpy(dest + lp, &v32, sizeof(v32));
+				break;
+			default:
+				memcpy(&v64, src + lp, sizeof(v64));
+				v64 = __builtin_bswap64(v64);
+				memcpy(dest + lp, &v64, sizeof(v64));
+				break;
+		}
+	}
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the length of the LEB128 encoding of an
+ * integer.
+ *
+ * \param value	The integer to be encoded.
+ *
+ * \return	The number of bytes in the encoding.
+ */
+
+static inline size_t _varint_length(uint64_t const value)
+
+{
+	return 1 + (63 - __builtin_clzll(value | 1)) / 7;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function LEB128 encodes an integer, seven bits at a time
+ * starting with the least significant bits.
+ *
+ * \param dest	A pointer to the memory the encoding is to be written
+ *		to, which must hold the length of the encoding.
+ *
+ * \param value	The integer to be encoded.
+ *
+ * \return	A pointer to the byte following the encoding.
+ */
+
+static inline unsigned char *_varint_encode(unsigned char *dest, \
+					    uint64_t value)
+
+{
+	while ( value >= 0x80 ) {
+		*dest++ = value | 0x80;
+		value >>= 7;
+	}
+	*dest++ = value;
+
+	return dest;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function decodes a LEB128 encoded integer.
+ *
+ * \param src	A pointer to the encoding.
+ *
+ * \param limit	The number of bytes which can be examined, which
+ *		cannot exceed the maximum length of an encoding.
+ *		Callers which know the maximum length is available
+ *		pass it as a constant so no other bounds are checked.
+ *
+ * \param value	A pointer to the variable which will be set to the
+ *		decoded integer.
+ *
+ * \return	The number of bytes in the encoding.  A value of zero
+ *		indicates the encoding was truncated or does not fit
+ *		in 64 bits.
+ */
+
+static inline size_t _varint_decode(unsigned char const *src, \
+				    size_t const limit, \
+				    uint64_t * const value)
+
+{
+	size_t lp;
+
+	uint64_t v = 0;
+
+
+	for (lp= 0; lp < limit; ++lp) {
+		v |= (uint64_t) (src[lp] & 0x7f) << (7 * lp);
+		if ( src[lp] < 0x80 ) {
+			if ( (lp == BUFFER_VARINT_MAXIMUM - 1) && (src[lp] > 1) )
+				return 0;
+			*value = v;
+			return lp + 1;
+		}
+	}
+
+	return 0;
+}
+
+
+#if defined(__SSE2__)
+/**
+ * Internal private function.
+ *
+ * This function locates the first 16 byte block in which two areas
+ * of memory differ using SSE2 instructions.
+ *
+ * \param a	A pointer to the first area of memory.
+ *
+ * \param b	A pointer to the second area of memory.
+ *
+ * \param cnt	The number of bytes to be compared.
+ *
+ * \return	The offset of the first differing byte, or of the
+ *		residual bytes which were not compared.
+ */
+
+static size_t _mismatch_sse2(unsigned char const *a, \
+			     unsigned char const *b, size_t const cnt)
+
+{
+	size_t lp;
+
+	unsigned int mask;
+
+
+	for (lp= 0; cnt - lp >= 16; lp += 16) {
+		mask = _mm_movemask_epi8(_mm_cmpeq_epi8( \
+			_mm_loadu_si128((__m128i const *) (a + lp)), \
+			_mm_loadu_si128((__m128i const *) (b + lp))));
+		if ( mask != 0xffff )
+			return lp + __builtin_ctz(~mask);
+	}
+
+	return lp;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function accumulates the differences between two areas of
+ * memory in blocks of 16 bytes using SSE2 instructions.  Every block
+ * is examined regardless of where the areas differ.
+ *
+ * \param a	A pointer to the first area of memory.
+ *
+ * \param b	A pointer to the second area of memory.
+ *
+ * \param cnt	The number of bytes to be compared.
+ *
+ * \param done	A pointer to the variable which will be set to the
+ *		number of bytes which were compared.
+ *
+ * \return	A non-zero value if the areas differ.
+ */
+
+static unsigned int _difference_sse2(unsigned char const *a, \
+				     unsigned char const *b, \
+				     size_t const cnt, size_t * const done)
+
+{
+	size_t lp;
+
+	__m128i diff = _mm_setzero_si128();
+
+
+	for (lp= 0; cnt - lp >= 16; lp += 16)
+		diff = _mm_or_si128(diff, _mm_xor_si128( \
+			_mm_loadu_si128((__m128i const *) (a + lp)), \
+			_mm_loadu_si128((__m128i const *) (b + lp))));
+
+	*done = lp;
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, \
+						 _mm_setzero_si128())) ^ 0xffff;
+}
+#endif
+
+
+#if defined(BUFFER_AVX2)
+/**
+ * Internal private function.
+ *
+ * This function locates the first 32 byte block in which two areas
+ * of memory differ using AVX2 instructions.  The areas are scanned
+ * 64 bytes at a time with the differing block located once a
+ * difference is found.
+ *
+ * \param a	A pointer to the first area of memory.
+ *
+ * \param b	A pointer to the second area of memory.
+ *
+ * \param cnt	The number of bytes to be compared.
+ *
+ * \return	The offset of the first differing byte, or of the
+ *		residual bytes which were not compared.
+ */
+
+static __attribute__((target("avx2"))) size_t \
+_mismatch_avx2(unsigned char const *a, unsigned char const *b, \
+	       size_t const cnt)
+
+{
+	size_t lp;
+
+	unsigned int mask;
+
+	__m256i eq1,
+		eq2;
+
+
+	for (lp= 0; cnt - lp >= 64; lp += 64) {
+		eq1 = _mm256_cmpeq_epi8( \
+			_mm256_loadu_si256((__m256i const *) (a + lp)), \
+			_mm256_loadu_si256((__m256i const *) (b + lp)));
+		eq2 = _mm256_cmpeq_epi8( \
+			_mm256_loadu_si256((__m256i const *) (a + lp + 32)), \
+			_mm256_loadu_si256((__m256i const *) (b + lp + 32)));
+		if ( _mm256_movemask_epi8(_mm256_and_si256(eq1, eq2)) == -1 )
+			continue;
+
+		if ( (mask = _mm256_movemask_epi8(eq1)) != 0xffffffff )
+			return lp + __builtin_ctz(~mask);
+		mask = _mm256_movemask_epi8(eq2);
+		return lp + 32 + __builtin_ctz(~mask);
+	}
+
+	if ( cnt - lp >= 32 ) {
+		mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8( \
+			_mm256_loadu_si256((__m256i const *) (a + lp)), \
+			_mm256_loadu_si256((__m256i const *) (b + lp))));
+		if ( mask != 0xffffffff )
+			return lp + __builtin_ctz(~mask);
+		lp += 32;
+	}
+
+	return lp;
+}
+#endif
+
+
+#if defined(BUFFER_AVX2)
+/**
+ * Internal private function.
+ *
+ * This function accumulates the differences between two areas of
+ * memory in blocks of 64 bytes using AVX2 instructions.  Every block
+ * is examined regardless of where the areas differ.
+ *
+ * \param a	A pointer to the first area of memory.
+ *
+ * \param b	A pointer to the second area of memory.
+ *
+ * \param cnt	The number of bytes to be compared.
+ *
+ * \param done	A pointer to the variable which will be set to the
+ *		number of bytes which were compared.
+ *
+ * \return	A non-zero value if the areas differ.
+ */
+
+static __attribute__((target("avx2"))) unsigned int \
+_difference_avx2(unsigned char const *a, unsigned char const *b, \
+		 size_t const cnt, size_t * const done)
+
+{
+	size_t lp;
+
+	__m256i diff1 = _mm256_setzero_si256(),
+		diff2 = _mm256_setzero_si256();
+
+
+	for (lp= 0; cnt - lp >= 64; lp += 64) {
+		diff1 = _mm256_or_si256(diff1, _mm256_xor_si256( \
+			_mm256_loadu_si256((__m256i const *) (a + lp)), \
+			_mm256_loadu_si256((__m256i const *) (b + lp))));
+		diff2 = _mm256_or_si256(diff2, _mm256_xor_si256( \
+			_mm256_loadu_si256((__m256i const *) (a + lp + 32)), \
+			_mm256_loadu_si256((__m256i const *) (b + lp + 32))));
+	}
+
+	*done = lp;
+	diff1 = _mm256_or_si256(diff1, diff2);
+	return !_mm256_testz_si256(diff1, diff1);
+}
+#endif
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the offset of the first byte at which two
+ * areas of memory differ using the widest vector instructions
+ * supported by the processor.
+ *
+ * \param a	A pointer to the first area of memory.
+ *
+ * \param b	A pointer to the second area of memory.
+ *
+ * \param cnt	The number of bytes to be compared.
+ *
+ * \return	The offset of the first differing byte.  The count of
+ *		bytes is returned if the areas are identical.
+ */
+
+static size_t _mismatch(unsigned char const *a, unsigned char const *b, \
+			size_t const cnt)
+
+{
+	size_t lp = 0;
+
+
+#if defined(BUFFER_AVX2)
+	if ( __builtin_cpu_supports("avx2") )
+		lp = _mismatch_avx2(a, b, cnt);
+#endif
+#if defined(__SSE2__)
+	lp += _mismatch_sse2(a + lp, b + lp, cnt - lp);
+#endif
+
+	while ( (lp < cnt) && (a[lp] == b[lp]) )
+		++lp;
+
+	return lp;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function determines whether two areas of memory differ in a
+ * time which depends only on the number of bytes compared, so that
+ * the position of a difference is not revealed.
+ *
+ * \param a	A pointer to the first area of memory.
+ *
+ * \param b	A pointer to the second area of memory.
+ *
+ * \param cnt	The number of bytes to be compared.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		areas are identical.
+ */
+
+static _Bool _equal_ct(unsigned char const *a, unsigned char const *b, \
+		       size_t const cnt)
+
+{
+	size_t lp = 0,
+	       done;
+
+	unsigned int diff = 0;
+
+
+#if defined(BUFFER_AVX2)
+	if ( __builtin_cpu_supports("avx2") )
+		diff = _difference_avx2(a, b, cnt, &lp);
+#endif
+#if defined(__SSE2__)
+	diff |= _difference_sse2(a + lp, b + lp, cnt - lp, &done);
+	lp   += done;
+#endif
+	for (; lp < cnt; ++lp)
+		diff |= a[lp] ^ b[lp];
+
+	/* Prevent the accumulation from being short circuited. */
+	__asm__ volatile ("" : "+r" (diff));
+
+	return diff == 0;
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method gives an object which is sharing its memory, or whose
+ * memory is a mapping of a file, a private copy before the memory is
+ * modified.  If the object holds the last reference to shared memory
+ * it takes ownership of the memory rather than copying it.
+ *
+ * \param this	A pointer to the object which is to be modified.
+ *
+ * \param cnt	The number of bytes which the modification will add
+ *		so the copy can be sized for them.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		object holds private memory.  A false value indicates
+ *		the copy could not be allocated.
+ */
+
+static _Bool _unshare(CO(Buffer, this), size_t const cnt)
+
+{
+	STATE(S);
+
+	size_t size = S->allocated;
+
+	unsigned char *bf = S->bf;
+
+	struct buffer_store *store = S->store;
+
+
+	/* Copy the contents of a mapping and release the mapping. */
+	if ( S->mapped ) {
+		S->bf	     = NULL;
+		S->allocated = 0;
+		S->mapped    = false;
+		if ( !_do_alloc(this, _capacity(S, S->used + cnt)) ) {
+			S->bf	     = bf;
+			S->allocated = size;
+			S->mapped    = true;
+			return false;
+		}
+
+		memcpy(S->bf, bf, S->used);
+		S->copied += S->used;
+		munmap(bf - S->head, size + S->head);
+		S->head	 = 0;
+		S->dirty = 0;
+		return true;
+	}
+
+	if ( store == NULL )
+		return true;
+
+	/*
+	 * The memory which is taken over may hold contents cleared
+	 * before it was shared, which are to be wiped with it.
+	 */
+	if ( atomic_load(&store->refs) == 1 ) {
+		S->allocated = store->allocated - S->head;
+		if ( store->used > S->head + S->dirty )
+			S->dirty = store->used - S->head;
+		S->store     = NULL;
+		free(store);
+		return true;
+	}
+
+	/* Copy the contents to a private allocation. */
+	S->store     = NULL;
+	S->bf	     = NULL;
+	S->allocated = 0;
+	if ( !_do_alloc(this, _capacity(S, S->used + cnt)) ) {
+		S->store     = store;
+		S->bf	     = bf;
+		S->allocated = size;
+		return false;
+	}
+
+	memcpy(S->bf, bf, S->used);
+	S->copied += S->used;
+	S->head	   = 0;
+	S->dirty   = 0;
+	_release(this, store);
+
+	return true;
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method ensures the buffer has capacity for the addition of
+ * the specified number of bytes, growing the allocation if needed.
+ *
+ * \param this	A pointer to the buffer which is to be grown.
+ *
+ * \param cnt	The number of bytes to be added to the buffer.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		buffer has capacity for the addition.  A true value
+ *		indicates success.
+ */
+
+static _Bool _grow(CO(Buffer, this), size_t const cnt)
+
+{
+	STATE(S);
+
+	_Bool paid;
+
+	size_t need;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( S->parent != NULL ) {
+		S->poisoned = true;
+		return false;
+	}
+	if ( cnt > SIZE_MAX - S->used )
+		return false;
+	if ( !_unshare(this, cnt) )
+		return false;
+	_sum(S);
+
+	/* Grow the allocation only if the addition does not fit. */
+	if ( (cnt <= S->allocated - S->used) && (S->bf != NULL) )
+		return true;
+	need = S->used + cnt;
+
+	/*
+	 * Reclaim the bytes consumed from the front of the buffer.  The
+	 * move is paid for by the consumed bytes if they are at least as
+	 * large as the contents, otherwise the buffer is also grown so
+	 * that compaction is not repeated for each small addition.
+	 */
+	if ( S->head > 0 ) {
+		paid = S->head >= S->used;
+		_compact(S);
+		if ( need <= S->allocated ) {
+			if ( paid )
+				return true;
+			need = S->allocated + 1;
+		}
+	}
+
+	return _do_alloc(this, _capacity(S, need));
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of bytes to the buffer.  If
+ * the buffer supports dynamic sizing the size of the buffer in the
+ * object's private state structure is expanded to accomodate the
+ * required addition to the buffer.
+ *
+ * \param this	A pointer to the buffer object which bytes are being
+ *		added to.
+ *
+ * \param src	A pointer to the area of memory from which the bytes are
+ *		to be copied.
+ *
+ * \param cnt	The number of characters to move from the source area
+ *		to the buffer.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition of elements to the buffer.  A
+ *		true value indicates success.
+ */
+
+static _Bool add(CO(Buffer, this), CO(unsigned char *, src), size_t const cnt)
+
+{
+	STATE(S);
+
+
+	if ( !_grow(this, cnt) )
+		return false;
+
+	memcpy(S->bf + S->used, src, cnt);
+	S->used += cnt;
+	_sum(S);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method extends the used size of the buffer by the specified
+ * number of bytes and returns a pointer to the added region.  This
+ * allows a caller to generate content directly in the buffer rather
+ * than in an intermediate copy.  The contents of the region are
+ * undefined and are expected to be populated by the caller.  The
+ * region is added to an attached checksum by the sum method.
+ *
+ * \param this	A pointer to the buffer object which is to be
+ *		extended.
+ *
+ * \param cnt	The number of bytes by which the buffer is to be
+ *		extended.
+ *
+ * \return	A pointer to the start of the added region is returned.
+ *		A NULL value indicates the buffer could not be extended.
+ */
+
+static unsigned char *extend(CO(Buffer, this), size_t const cnt)
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+
+	if ( !_grow(this, cnt) )
+		return NULL;
+
+	bp	 = S->bf + S->used;
+	S->used += cnt;
+
+	return bp;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method ensures the buffer has capacity for a total of the
+ * specified number of bytes.  Callers which know the final size of
+ * the buffer can use this to allocate it once rather than growing it
+ * incrementally.  The capacity of the buffer is never reduced.
+ *
+ * \param this	A pointer to the buffer object whose capacity is to
+ *		be reserved.
+ *
+ * \param cnt	The number of bytes the buffer is to hold.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		capacity was reserved.  A true value indicates success.
+ */
+
+static _Bool reserve(CO(Buffer, this), size_t const cnt)
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return false;
+	if ( S->parent != NULL ) {
+		S->poisoned = true;
+		return false;
+	}
+	if ( !_unshare(this, cnt > S->used ? cnt - S->used : 0) )
+		return false;
+	if ( cnt <= S->allocated )
+		return true;
+
+	_compact(S);
+	if ( cnt <= S->allocated )
+		return true;
+
+	/* Continue Fibonacci growth from above the reserved size. */
+	if ( S->growth == Buffer_growth_fibonacci )
+		S->seqn->getAbove(S->seqn, cnt);
+
+	return _do_alloc(this, cnt);
+}
+
+
+/**
+ * External public method.
+ *
+ * This method selects the policy used to size the buffer when it
+ * needs to grow.  The policy applies to subsequent growth, the
+ * current allocation is not changed.
+ *
+ * \param this		A pointer to the buffer object whose growth
+ *			policy is to be set.
+ *
+ * \param growth	The growth policy to be used.
+ *
+ * \param chunk		The allocation increment used by the fixed
+ *			chunk policy.  A value of zero selects the
+ *			default increment, the value is ignored by
+ *			the other policies.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the policy was set.  A false value indicates
+ *			the object is poisoned or the policy is not
+ *			valid.
+ */
+
+static _Bool set_growth(CO(Buffer, this), enum Buffer_growth const growth, \
+			size_t const chunk)
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return false;
+	if ( (growth < Buffer_growth_fibonacci) || \
+	     (growth > Buffer_growth_chunk) )
+		return false;
+
+	S->growth = growth;
+	S->chunk  = chunk == 0 ? BUFFER_CHUNK : chunk;
+
+	return true;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function converts an access pattern into the equivalent
+ * memory advice.
+ *
+ * \param access	The access pattern to be converted.
+ *
+ * \return		The advice for the madvise system call.  A value
+ *			of -1 indicates the access pattern is invalid.
+ */
+
+static int _advice(enum Buffer_access const access)
+
+{
+	switch ( access ) {
+		case Buffer_access_normal:
+			return MADV_NORMAL;
+		case Buffer_access_sequential:
+			return MADV_SEQUENTIAL;
+		case Buffer_access_random:
+			return MADV_RANDOM;
+		case Buffer_access_willneed:
+			return MADV_WILLNEED;
+	}
+
+	return -1;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method makes an empty buffer refer to a memory mapping of the
+ * contents of a file, so the contents can be read without being
+ * copied and the page cache is shared with other processes.
+ *
+ * A read-only buffer maps the file shared and must not be written
+ * through the address returned by the get method.  A writable buffer
+ * maps the file privately so the contents can be modified in place
+ * without affecting the file.  In either case methods which add to
+ * the buffer first copy the contents to memory of its own.
+ *
+ * \param this		A pointer to the buffer object which is to map
+ *			the file.
+ *
+ * \param fd		The file descriptor of the file to be mapped.
+ *
+ * \param writable	A flag used to indicate the contents are to be
+ *			modifiable.
+ *
+ * \param access	The pattern in which the contents are expected
+ *			to be accessed.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the file was mapped.  A false value
+ *			indicates the buffer was not empty, is secure
+ *			or the file could not be mapped, in which case
+ *			errno describes the error.
+ */
+
+static _Bool map(CO(Buffer, this), int const fd, _Bool const writable, \
+		 enum Buffer_access const access)
+
+{
+	STATE(S);
+
+	int advice = _advice(access);
+
+	void *mp;
+
+	struct stat statbuf;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( (S->bf != NULL) || (S->parent != NULL) || S->secure || \
+	     (advice == -1) )
+		return false;
+
+	if ( fstat(fd, &statbuf) == -1 )
+		return false;
+	if ( (uintmax_t) statbuf.st_size > SIZE_MAX )
+		return false;
+	if ( statbuf.st_size == 0 )
+		return true;
+
+	if ( writable )
+		mp = mmap(NULL, statbuf.st_size, PROT_READ | PROT_WRITE, \
+			  MAP_PRIVATE, fd, 0);
+	else
+		mp = mmap(NULL, statbuf.st_size, PROT_READ, MAP_SHARED, fd, \
+			  0);
+	if ( mp == MAP_FAILED )
+		return false;
+	madvise(mp, statbuf.st_size, advice);
+
+	S->bf	     = mp;
+	S->used	     = statbuf.st_size;
+	S->allocated = statbuf.st_size;
+	S->mapped    = true;
+	_sum(S);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method changes the expected access pattern of a buffer which
+ * maps a file.
+ *
+ * \param this		A pointer to the buffer object whose access
+ *			pattern is to be set.
+ *
+ * \param access	The pattern in which the contents are expected
+ *			to be accessed.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the advice was applied.  A false value
+ *			indicates the buffer does not map a file.
+ */
+
+static _Bool advise(CO(Buffer, this), enum Buffer_access const access)
+
+{
+	STATE(S);
+
+	int advice = _advice(access);
+
+
+	if ( S->poisoned || !S->mapped || (advice == -1) )
+		return false;
+
+	return madvise(S->bf - S->head, S->allocated + S->head, advice) == 0;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method places the buffer in secure mode, which is intended for
+ * keys and other secret contents.  The buffer is held in memory which
+ * is locked against being paged out and excluded from core dumps.
+ * The memory is drawn from a pool of page-aligned locked slabs which
+ * are shared by all secure buffers.  Growth copies the contents to a
+ * new block and wipes the old one rather than re-allocating it, and
+ * the memory is wiped when it is released.
+ *
+ * \param this	A pointer to the buffer object which is to be made
+ *		secure.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		buffer was made secure.  A false value indicates the
+ *		buffer already holds memory or is a view.
+ */
+
+static _Bool set_secure(CO(Buffer, this))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return false;
+	if ( (S->bf != NULL) || (S->parent != NULL) )
+		return false;
+
+	S->secure = true;
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method attaches a checksum to the buffer.  The bytes added to
+ * the buffer after the checksum is attached are added to the checksum
+ * as they are copied in, while they are still in cache, so a digest
+ * of the contents is available without another pass over them.  The
+ * bytes remain in the checksum if they are later removed from the
+ * buffer, so a buffer used as a queue computes the checksum of the
+ * stream of bytes passed through it.  The checksum is not owned by
+ * the buffer and must remain valid while it is attached.
+ *
+ * The bytes written into a region returned by the extend method are
+ * only summed when the buffer is next modified or when the sum method
+ * is called.  The sum method must be called before the value of the
+ * checksum is read if the last bytes were added with extend.
+ *
+ * \param this		A pointer to the buffer object which the
+ *			checksum is to be attached to.
+ *
+ * \param checksum	The checksum to be attached.  A null value
+ *			detaches the current checksum.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the checksum was attached.  A false value
+ *			indicates the object is poisoned or is a view.
+ */
+
+static _Bool set_checksum(CO(Buffer, this), CO(Checksum, checksum))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned || (S->parent != NULL) )
+		return false;
+
+	_sum(S);
+	S->checksum = checksum;
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method adds the bytes written into regions returned by the
+ * extend method to the checksum attached to the buffer.
+ *
+ * \param this	A pointer to the buffer object whose contents are to
+ *		be summed.
+ */
+
+static void sum(CO(Buffer, this))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return;
+	_sum(S);
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the allocation statistics of the buffer.  The
+ * number of bytes copied is the content which had to be preserved by
+ * each re-allocation, whether or not the system allocator was able
+ * to extend the allocation in place.
+ *
+ * \param this		A pointer to the buffer object whose statistics
+ *			are to be returned.
+ *
+ * \param stats		A pointer to the structure which will be
+ *			populated with the statistics.
+ */
+
+static void stats(CO(Buffer, this), struct HurdLib_Buffer_Stats * const stats)
+
+{
+	STATE(S);
+
+
+	stats->capacity = S->allocated + S->head;
+	stats->reallocs = S->reallocs;
+	stats->copied	= S->copied;
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of bytes to the buffer by a
+ * second Buffer object.  It is simply a fronting function for the
+ * add method of the object.
+ *
+ * \param this	A pointer to the buffer object which bytes are being
+ *		added to.
+ *
+ * \param bf	The Buffer object which is to be added to the current
+ *		Buffer.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition of elements to the buffer.  A
+ *		true value indicates success.
+ */
+
+static _Bool add_Buffer(CO(Buffer, this), CO(Buffer, bf))
+
+{
+	return add(this, bf->get(bf), bf->size(bf));
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of bytes to a buffer based on a
+ * hexadecimal string.  This method ultimately calls the add method so
+ * dynamic buffer sizing is supported.
+ *
+ * The detection of a character which is not in the character set
+ * [0-9a-f] will generate an error condition on the object.  The method
+ * also tests to make sure an even number of characters are in the
+ * input text string.  An odd number of characters also sets an
+ * error condition on the object.
+ *
+ * \param this	A pointer to the buffer object which the text string
+ *		encoded bytes will be added to.
+ *
+ * \param text	A pointer a character string containing the hex characters
+ *		to be encoded into the buffer.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition of elements to the buffer.  A
+ *		true value indicates success.
+ */
+
+static _Bool add_hexstring(CO(Buffer, this), CO(char *,hexbufr))
+
+{
+	STATE(S);
+
+	_Bool retn = false;
+
+	unsigned char *bp;
+
+	size_t hexbufr_length;
+
+
+	/* Don't move forward if the object has had an error. */
+	if ( S->poisoned )
+		goto done;
+
+	/* Sanity check the string. */
+	if ( hexbufr == NULL ) {
+		S->poisoned = true;
+		goto done;
+	}
+
+	hexbufr_length = strlen(hexbufr);
+	if ( (hexbufr_length == 0) || ((hexbufr_length % 2) != 0) ) {
+		S->poisoned = true;
+		goto done;
+	}
+
+
+	/*
+	 * Decode directly into the buffer.  The output buffer is
+	 * big-endian.  An invalid character causes a failure of the
+	 * conversion.
+	 */
+	if ( (bp = extend(this, hexbufr_length / 2)) == NULL )
+		goto done;
+	if ( !_hex_decode(hexbufr, hexbufr_length / 2, bp) ) {
+		S->poisoned = true;
+		goto done;
+	}
+	_sum(S);
+	retn = true;
+
+
+done:
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements encoding the contents of the buffer as a
+ * null-terminated string of lower case hexadecimal characters in
+ * memory supplied by the caller.
+ *
+ * \param this	A pointer to the buffer object whose contents are to
+ *		be encoded.
+ *
+ * \param dest	A pointer to the memory which the string is to be
+ *		written to.
+ *
+ * \param size	The size of the destination memory, it must be at
+ *		least twice the size of the buffer plus one.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		contents were encoded.  A false value indicates the
+ *		object is poisoned or the destination is too small.
+ */
+
+static _Bool encode_hex(CO(Buffer, this), char * const dest, \
+			size_t const size)
+
+{
+	STATE(S);
+
+
+	if ( !_valid(S) || (dest == NULL) )
+		return false;
+	if ( (S->used > (SIZE_MAX - 1) / 2) || (size < 2 * S->used + 1) )
+		return false;
+
+	_hex_encode(S->bf, S->used, dest);
+	dest[2 * S->used] = '\0';
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of bytes to a buffer based on a
+ * base64 encoded string.  The bytes are decoded directly into the
+ * capacity of the buffer so dynamic buffer sizing is supported.
+ *
+ * The standard alphabet and the URL and filename safe alphabet of
+ * RFC 4648 are supported.  Padding is accepted but not required
+ * unless strict validation is requested.  Under strict validation a
+ * standard encoding must be padded, a URL encoding must not be
+ * padded and the unused bits of the final character must be zero.
+ * A character which is not in the alphabet or an encoding with an
+ * invalid length sets an error condition on the object.
+ *
+ * \param this	A pointer to the buffer object which the decoded bytes
+ *		will be added to.
+ *
+ * \param text	A pointer to the null-terminated string containing the
+ *		base64 characters to be decoded.
+ *
+ * \param mode	The alphabet and validation options which are to be
+ *		used.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition of elements to the buffer.  A
+ *		true value indicates success.
+ */
+
+static _Bool add_base64(CO(Buffer, this), CO(char *, text), \
+			enum Buffer_base64 const mode)
+
+{
+	STATE(S);
+
+	_Bool retn   = false,
+	      url    = (mode & Buffer_base64_url) != 0,
+	      strict = (mode & Buffer_base64_strict) != 0;
+
+	unsigned char *bp;
+
+	size_t pad = 0,
+	       length;
+
+
+	/* Don't move forward if the object has had an error. */
+	if ( S->poisoned )
+		goto done;
+
+	/* Sanity check the string and its padding. */
+	if ( text == NULL ) {
+		S->poisoned = true;
+		goto done;
+	}
+
+	length = strlen(text);
+	while ( (pad < 2) && (pad < length) && \
+		(text[length - pad - 1] == '=') )
+		++pad;
+
+	if ( pad > 0 ) {
+		if ( (url && strict) || ((length % 4) != 0) ) {
+			S->poisoned = true;
+			goto done;
+		}
+	}
+	else if ( !url && strict && ((length % 4) != 0) ) {
+		S->poisoned = true;
+		goto done;
+	}
+
+	length -= pad;
+	if ( (length % 4) == 1 ) {
+		S->poisoned = true;
+		goto done;
+	}
+
+
+	/* Decode directly into the buffer. */
+	if ( (bp = extend(this, 3 * (length / 4) + \
+			  ((length % 4) ? length % 4 - 1 : 0))) == NULL )
+		goto done;
+	if ( !_base64_decode(text, length, bp, url, strict) ) {
+		S->poisoned = true;
+		goto done;
+	}
+	_sum(S);
+	retn = true;
+
+
+done:
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements encoding the contents of the buffer as a
+ * null-terminated base64 string in memory supplied by the caller.
+ * The standard alphabet is padded to a multiple of four characters
+ * while the URL and filename safe alphabet is left unpadded.
+ *
+ * \param this	A pointer to the buffer object whose contents are to
+ *		be encoded.
+ *
+ * \param dest	A pointer to the memory which the string is to be
+ *		written to.
+ *
+ * \param size	The size of the destination memory, it must hold the
+ *		encoding and the terminating null character.
+ *
+ * \param mode	The alphabet to be used, the validation option is
+ *		ignored.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		contents were encoded.  A false value indicates the
+ *		object is poisoned or the destination is too small.
+ */
+
+static _Bool encode_base64(CO(Buffer, this), char * const dest, \
+			   size_t const size, enum Buffer_base64 const mode)
+
+{
+	STATE(S);
+
+	_Bool url = (mode & Buffer_base64_url) != 0;
+
+	size_t length;
+
+
+	if ( !_valid(S) || (dest == NULL) )
+		return false;
+	if ( S->used / 3 > (SIZE_MAX - 5) / 4 )
+		return false;
+
+	length = _base64_length(S->used, url);
+	if ( size < length + 1 )
+		return false;
+
+	_base64_encode(S->bf, S->used, dest, url);
+	dest[length] = '\0';
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of a fixed width integer to
+ * the buffer in the specified byte order.
+ *
+ * \param this	A pointer to the buffer object which the integer is to
+ *		be added to.
+ *
+ * \param value	The integer to be added.
+ *
+ * \param width	The number of bytes in the serialized integer, which
+ *		must be one, two, four or eight.
+ *
+ * \param order	The byte order of the serialized integer.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		integer was added.  A false value indicates the width or
+ *		order is not valid, the value does not fit in the width
+ *		or the buffer could not be extended.
+ */
+
+static _Bool add_int(CO(Buffer, this), uint64_t const value, \
+		     size_t const width, enum Buffer_endian const order)
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+	size_t lp;
+
+
+	if ( !_int_format(width, order) )
+		return false;
+	if ( (width < sizeof(value)) && ((value >> (8 * width)) != 0) )
+		return false;
+	if ( !_grow(this, width) )
+		return false;
+
+	bp = S->bf + S->used;
+	for (lp= 0; lp < width; ++lp) {
+		if ( order == Buffer_endian_little )
+			bp[lp] = value >> (8 * lp);
+		else
+			bp[width - lp - 1] = value >> (8 * lp);
+	}
+	S->used += width;
+	_sum(S);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of an array of fixed width
+ * integers to the buffer in the specified byte order.  The buffer is
+ * grown once for the entire array and the integers are converted
+ * directly into it.
+ *
+ * \param this		A pointer to the buffer object which the
+ *			integers are to be added to.
+ *
+ * \param values	A pointer to the array of integers, each of
+ *			which is an unsigned integer of the specified
+ *			width in the byte order of the host.
+ *
+ * \param count		The number of integers in the array.
+ *
+ * \param width		The width of the integers, which must be one,
+ *			two, four or eight bytes.
+ *
+ * \param order		The byte order of the serialized integers.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the integers were added.  A false value
+ *			indicates the width or order is not valid or
+ *			the buffer could not be extended.
+ */
+
+static _Bool add_ints(CO(Buffer, this), CO(void *, values), \
+		      size_t const count, size_t const width, \
+		      enum Buffer_endian const order)
+
+{
+	STATE(S);
+
+
+	if ( !_int_format(width, order) || (count > SIZE_MAX / width) )
+		return false;
+	if ( (values == NULL) && (count > 0) )
+		return false;
+	if ( !_grow(this, count * width) )
+		return false;
+
+	_order_ints(S->bf + S->used, values, count, width, order);
+	S->used += count * width;
+	_sum(S);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of an unsigned LEB128 encoded
+ * integer to the buffer.  The encoding uses one byte for each seven
+ * bits of the value.
+ *
+ * \param this	A pointer to the buffer object which the integer is to
+ *		be added to.
+ *
+ * \param value	The integer to be added.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		integer was added.  A false value indicates the buffer
+ *		could not be extended.
+ */
+
+static _Bool add_varint(CO(Buffer, this), uint64_t const value)
+
+{
+	STATE(S);
+
+	size_t length = _varint_length(value);
+
+
+	if ( !_grow(this, length) )
+		return false;
+
+	_varint_encode(S->bf + S->used, value);
+	S->used += length;
+	_sum(S);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of an array of unsigned LEB128
+ * encoded integers to the buffer.  The length of the encodings is
+ * summed so the buffer is grown once, after which the integers are
+ * encoded directly into it.
+ *
+ * \param this		A pointer to the buffer object which the
+ *			integers are to be added to.
+ *
+ * \param values	A pointer to the array of integers.
+ *
+ * \param count		The number of integers in the array.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the integers were added.  A false value
+ *			indicates the buffer could not be extended.
+ */
+
+static _Bool add_varints(CO(Buffer, this), CO(uint64_t *, values), \
+			 size_t const count)
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+	size_t lp,
+	       length = 0;
+
+
+	if ( (values == NULL) && (count > 0) )
+		return false;
+	if ( count > SIZE_MAX / BUFFER_VARINT_MAXIMUM )
+		return false;
+
+	for (lp= 0; lp < count; ++lp)
+		length += _varint_length(values[lp]);
+	if ( !_grow(this, length) )
+		return false;
+
+	bp = S->bf + S->used;
+	for (lp= 0; lp < count; ++lp)
+		bp = _varint_encode(bp, values[lp]);
+	S->used += length;
+	_sum(S);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements reading a fixed width integer from the
+ * buffer at the position of a cursor.  The cursor is an offset into
+ * the buffer which is advanced past the integer, allowing a sequence
+ * of fields to be read without modifying the buffer.
+ *
+ * \param this	A pointer to the buffer object which the integer is to
+ *		be read from.
+ *
+ * \param posn	A pointer to the cursor.  The cursor is unchanged if
+ *		the integer could not be read.
+ *
+ * \param value	A pointer to the variable which will be set to the
+ *		integer.
+ *
+ * \param width	The number of bytes in the serialized integer, which
+ *		must be one, two, four or eight.
+ *
+ * \param order	The byte order of the serialized integer.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		integer was read.  A false value indicates the object is
+ *		poisoned, the width or order is not valid or the buffer
+ *		does not hold the integer.
+ */
+
+static _Bool get_int(CO(Buffer, this), size_t * const posn, \
+		     uint64_t * const value, size_t const width, \
+		     enum Buffer_endian const order)
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+	size_t lp;
+
+	uint64_t v = 0;
+
+
+	if ( !_valid(S) || (posn == NULL) || (value == NULL) )
+		return false;
+	if ( !_int_format(width, order) )
+		return false;
+	if ( (*posn > S->used) || (width > S->used - *posn) )
+		return false;
+
+	bp = S->bf + *posn;
+	for (lp= 0; lp < width; ++lp) {
+		if ( order == Buffer_endian_little )
+			v |= (uint64_t) bp[lp] << (8 * lp);
+		else
+			v = (v << 8) | bp[lp];
+	}
+
+	*value = v;
+	*posn += width;
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements reading an array of fixed width integers
+ * from the buffer at the position of a cursor.  The bounds of the
+ * buffer are checked once for the entire array.
+ *
+ * \param this		A pointer to the buffer object which the
+ *			integers are to be read from.
+ *
+ * \param posn		A pointer to the cursor, which is advanced
+ *			past the integers.  The cursor is unchanged if
+ *			the integers could not be read.
+ *
+ * \param values	A pointer to the array which the integers are
+ *			to be written to, as unsigned integers of the
+ *			specified width in the byte order of the host.
+ *
+ * \param count		The number of integers to be read.
+ *
+ * \param width		The width of the integers, which must be one,
+ *			two, four or eight bytes.
+ *
+ * \param order		The byte order of the serialized integers.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the integers were read.  A false value
+ *			indicates the object is poisoned, the width or
+ *			order is not valid or the buffer does not hold
+ *			the integers.
+ */
+
+static _Bool get_ints(CO(Buffer, this), size_t * const posn, \
+		      void * const values, size_t const count, \
+		      size_t const width, enum Buffer_endian const order)
+
+{
+	STATE(S);
+
+
+	if ( !_valid(S) || (posn == NULL) || !_int_format(width, order) )
+		return false;
+	if ( (values == NULL) && (count > 0) )
+		return false;
+	if ( (*posn > S->used) || (count > (S->used - *posn) / width) )
+		return false;
+
+	_order_ints(values, S->bf + *posn, count, width, order);
+	*posn += count * width;
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements reading an unsigned LEB128 encoded integer
+ * from the buffer at the position of a cursor.
+ *
+ * \param this	A pointer to the buffer object which the integer is to
+ *		be read from.
+ *
+ * \param posn	A pointer to the cursor, which is advanced past the
+ *		encoding.  The cursor is unchanged if the integer could
+ *		not be read.
+ *
+ * \param value	A pointer to the variable which will be set to the
+ *		integer.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		integer was read.  A false value indicates the object is
+ *		poisoned or the encoding is truncated or does not fit
+ *		in 64 bits.
+ */
+
+static _Bool get_varint(CO(Buffer, this), size_t * const posn, \
+			uint64_t * const value)
+
+{
+	STATE(S);
+
+	size_t left,
+	       length;
+
+
+	if ( !_valid(S) || (posn == NULL) || (value == NULL) )
+		return false;
+	if ( *posn > S->used )
+		return false;
+
+	left = S->used - *posn;
+	if ( left > BUFFER_VARINT_MAXIMUM )
+		left = BUFFER_VARINT_MAXIMUM;
+	if ( (length = _varint_decode(S->bf + *posn, left, value)) == 0 )
+		return false;
+	*posn += length;
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements reading an array of unsigned LEB128 encoded
+ * integers from the buffer at the position of a cursor.  Rather than
+ * checking the bounds of the buffer for each byte, the integers are
+ * decoded in runs which the remaining contents are known to hold even
+ * if every encoding has the maximum length.  Only the encodings which
+ * are less than that length from the end of the buffer are checked
+ * individually.
+ *
+ * \param this		A pointer to the buffer object which the
+ *			integers are to be read from.
+ *
+ * \param posn		A pointer to the cursor, which is advanced
+ *			past the encodings.  The cursor is unchanged if
+ *			the integers could not be read.
+ *
+ * \param values	A pointer to the array which the integers are
+ *			to be written to.  The contents of the array
+ *			are undefined if the integers could not be read.
+ *
+ * \param count		The number of integers to be read.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the integers were read.  A false value
+ *			indicates the object is poisoned or an encoding
+ *			is truncated or does not fit in 64 bits.
+ */
+
+static _Bool get_varints(CO(Buffer, this), size_t * const posn, \
+			 uint64_t * const values, size_t const count)
+
+{
+	STATE(S);
+
+	unsigned char const *bp;
+
+	size_t lp = 0,
+	       run,
+	       left,
+	       length;
+
+
+	if ( !_valid(S) || (posn == NULL) )
+		return false;
+	if ( (values == NULL) && (count > 0) )
+		return false;
+	if ( *posn > S->used )
+		return false;
+
+	bp   = S->bf + *posn;
+	left = S->used - *posn;
+
+	while ( lp < count ) {
+		run = left / BUFFER_VARINT_MAXIMUM;
+		if ( run > count - lp )
+			run = count - lp;
+
+		if ( run == 0 ) {
+			length = _varint_decode(bp, left, &values[lp++]);
+			if ( length == 0 )
+				return false;
+			bp   += length;
+			left -= length;
+			continue;
+		}
+
+		for (run += lp; lp < run; ++lp) {
+			length = _varint_decode(bp, BUFFER_VARINT_MAXIMUM, \
+						&values[lp]);
+			if ( length == 0 )
+				return false;
+			bp   += length;
+			left -= length;
+		}
+	}
+
+	*posn = bp - S->bf;
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method converts an empty object into a read-only view of a
+ * range of bytes in another Buffer.  The view refers to the memory
+ * of its parent rather than a copy of it and holds a reference which
+ * keeps the parent alive until the view is destroyed.  A view can be
+ * read with any of the accessor methods and passed wherever a Buffer
+ * is consumed, while methods which would add to it poison the view.
+ * Shrinking or resetting a view only narrows its window.
+ *
+ * A view is only valid while its parent holds the range of bytes it
+ * covers.  The view follows its bytes when the parent consumes bytes
+ * in front of them, while a view whose parent has been reduced below
+ * the range, or has consumed or discarded any of it, is poisoned when
+ * it is next accessed.
+ *
+ * \param this		A pointer to the object which is to be converted
+ *			into a view.
+ *
+ * \param parent	The object which is to be viewed.
+ *
+ * \param offset	The offset of the view into the parent.
+ *
+ * \param length	The number of bytes covered by the view.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the view was created.  A false value
+ *			indicates the object was not empty or the range
+ *			is not within the parent.
+ */
+
+static _Bool view(CO(Buffer, this), CO(Buffer, parent), size_t offset, \
+		  size_t const length)
+
+{
+	STATE(S);
+
+	_Bool retn = false;
+
+	Buffer bf = parent;
+
+	Buffer_State P = parent->state;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( (bf == this) || (S->parent != NULL) || (S->bf != NULL) )
+		goto done;
+
+	/* Verify the range against the parent. */
+	if ( !_valid(P) )
+		goto done;
+	if ( (offset > P->used) || (length > P->used - offset) )
+		goto done;
+
+	/* A view of a view refers directly to the underlying buffer. */
+	if ( P->parent != NULL ) {
+		offset += P->offset;
+		bf	= P->parent;
+	}
+	else
+		offset += P->consumed;
+
+	atomic_fetch_add(&bf->state->refs, 1);
+	S->parent = bf;
+	S->offset = offset;
+	S->used	  = length;
+	retn = true;
+
+
+ done:
+	if ( !retn )
+		S->poisoned = true;
+
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method makes an empty object share the contents of another
+ * Buffer.  Rather than copying the contents both objects refer to
+ * the same memory, which is copied by whichever of them is modified
+ * first.  The sharing is reference counted atomically so the objects
+ * may be used by different threads.  Contents held in the storage of
+ * a small buffer, by a view, by a file mapping, or by or for a secure
+ * buffer are copied.
+ *
+ * The copy is only made when the contents are modified through the
+ * methods of an object.  Writing through the pointer returned by the
+ * get method of a sharing object modifies the contents seen by every
+ * object which shares them.
+ *
+ * \param this		A pointer to the object which is to share the
+ *			contents.
+ *
+ * \param src		The object whose contents are to be shared.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the contents are shared.  A false value
+ *			indicates the object was not empty or memory
+ *			could not be allocated.
+ */
+
+static _Bool share(CO(Buffer, this), CO(Buffer, src))
+
+{
+	STATE(S);
+
+	_Bool retn = false;
+
+	Buffer_State P = src->state;
+
+	struct buffer_store *store;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( (src == this) || (S->parent != NULL) || (S->bf != NULL) )
+		goto done;
+	if ( !_valid(P) )
+		goto done;
+
+	/* Copy contents which cannot be shared. */
+	if ( P->used == 0 )
+		return true;
+	if ( (P->parent != NULL) || (P->bf == P->small) || S->secure || \
+	     P->secure || P->mapped || (P->head > 0) )
+		return add(this, P->bf, P->used);
+
+	if ( (store = P->store) == NULL ) {
+		if ( (store = malloc(sizeof(struct buffer_store))) == NULL )
+			goto done;
+		atomic_init(&store->refs, 1);
+		store->bf	 = P->bf;
+		store->allocated = P->allocated;
+		store->used	 = _extent(P);
+		P->store = store;
+	}
+
+	atomic_fetch_add(&store->refs, 1);
+	S->store     = store;
+	S->bf	     = store->bf;
+	S->allocated = store->allocated;
+	S->used	     = P->used;
+	_sum(S);
+	retn = true;
+
+
+ done:
+	if ( !retn )
+		S->poisoned = true;
+
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the comparison of the contents of one buffer
+ * to another.  In a depart from the standard memcmp function this
+ * comparison only returns true and false since this seems to be the
+ * most commonly requested action.
+ *
+ * \param this	A pointer to the buffer object which will be used for
+ *		the comparison.
+ *
+ * \param bufr	The buffer which the object buffer will be compared to.
+ *
+ * \return	A boolean value is used to indicate where or not the
+ *		buffers are equivalent.  A true value indicates they
+ *		match in size and content.  A false value indicates
+ *		they are different.
+ */
+
+static _Bool equal(CO(Buffer, this), CO(Buffer, bufr))
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+
+	/* Status checks. */
+	if ( !_valid(S) )
+		return false;
+	if ( bufr->poisoned(bufr) ) {
+		S->poisoned = true;
+		return false;
+	}
+
+	/* Do size and content comparisons. */
+	if ( S->used != bufr->size(bufr) )
+		return false;
+	if ( S->used == 0 )
+		return true;
+	if ( (bp = bufr->get(bufr)) == NULL )
+		return false;
+	if ( S->bf == bp )
+		return true;
+	if ( memcmp(S->bf, bp, S->used) != 0 )
+		return false;
+
+	return true;
 }
 
 
 /**
  * External public method.
  *
- * This method implements the addition of bytes to a buffer based on a
- * hexadecimal string.  This method ultimately calls the add method so
- * dynamic buffer sizing is supported.
- *
- * The detection of a character which is not in the character set
- * [0-9a-f] will generate an error condition on the object.  The method
- * also tests to make sure an even number of characters are in the
- * input text string.  An odd number of characters also sets an
- * error condition on the object.
+ * This method implements a comparison of the contents of two buffers
+ * which takes the same time wherever the contents differ.  It is
+ * intended for the comparison of secret values such as message
+ * authentication codes.  The sizes of the buffers are not considered
+ * secret and buffers of different sizes are rejected immediately.
  *
- * \param this	A pointer to the buffer object which the text string
- *		encoded bytes will be added to.
+ * \param this	A pointer to the buffer object which will be used for
+ *		the comparison.
  *
- * \param text	A pointer a character string containing the hex characters
- *		to be encoded into the buffer.
+ * \param bufr	The buffer which the object buffer will be compared to.
  *
- * \return	A boolean value is used to indicate the success or
- *		failure of the addition of elements to the buffer.  A
- *		true value indicates success.
+ * \return	A boolean value is used to indicate where or not the
+ *		buffers are equivalent.  A true value indicates they
+ *		match in size and content.
  */
 
-static _Bool add_hexstring(CO(Buffer, this), CO(char *,hexbufr))
+static _Bool equal_ct(CO(Buffer, this), CO(Buffer, bufr))
 
 {
 	STATE(S);
 
-	_Bool retn	   = false,
-	      first_nybble = true;
-
-	unsigned char nybble,
-		      byte[1];
-
-	size_t lp,
-	       hexbufr_length;
-
-
-	/* Don't move forward if the object has had an error. */
-	if ( S->poisoned )
-		goto done;
+	unsigned char *bp;
 
-	/* Sanity check the string. */
-	if ( hexbufr == NULL ) {
-		S->poisoned = true;
-		goto done;
-	}
 
-	hexbufr_length = strlen(hexbufr);
-	if ( (hexbufr_length == 0) || ((hexbufr_length % 2) != 0) ) {
+	if ( !_valid(S) )
+		return false;
+	if ( bufr->poisoned(bufr) ) {
 		S->poisoned = true;
-		goto done;
-	}
-
-
-	/*
-	 * The somewhat brute force conversion occurs below.  The output
-	 * buffer is big-endian.  An invalid character causes a failure
-	 * of the conversion.
-	 */
-	for (lp= 0; lp < hexbufr_length; ++lp) {
-		switch ( toupper(hexbufr[lp]) )
-		{
-			case '0':
-				nybble = 0;
-				break;
-			case '1':
-				nybble = 1;
-				break;
-			case '2':
-				nybble = 2;
-				break;
-		    	case '3':
-				nybble = 3;
-				break;
-		    	case '4':
-				nybble = 4;
-				break;
-		    	case '5':
-				nybble = 5;
-				break;
-	    		case '6':
-				nybble = 6;
-				break;
-		    	case '7':
-				nybble = 7;
-				break;
-		    	case '8':
-				nybble = 8;
-				break;
-	    		case '9':
-				nybble = 9;
-				break;
-	    		case 'A':
-				nybble = 10;
-				break;
-		    	case 'B':
-				nybble = 11;
-				break;
-	    		case 'C':
-				nybble = 12;
-				break;
-		    	case 'D':
-				nybble = 13;
-				break;
-		    	case 'E':
-				nybble = 14;
-				break;
-		    	case 'F':
-				nybble = 15;
-				break;
-	    		default:
-				this->state->poisoned = true;
-				goto done;
-		}
-
-		if ( first_nybble ) {
-			byte[0] = nybble << 4;
-			first_nybble = false;
-		}		
-		else {
-			byte[0] = (byte[0] | nybble);
-			add(this, byte, sizeof(byte));
-			first_nybble = true;
-		}
+		return false;
 	}
-	retn = true;
 
+	if ( S->used != bufr->size(bufr) )
+		return false;
+	if ( S->used == 0 )
+		return true;
+	if ( (bp = bufr->get(bufr)) == NULL )
+		return false;
 
-done:
-	return retn;
+	return _equal_ct(S->bf, bp, S->used);
 }
 
 
 /**
  * External public method.
  *
- * This method implements the comparison of the contents of one buffer
- * to another.  In a depart from the standard memcmp function this
- * comparison only returns true and false since this seems to be the
- * most commonly requested action.
+ * This method implements a comparison of the contents of two buffers
+ * which locates the first byte at which they differ.
  *
  * \param this	A pointer to the buffer object which will be used for
  *		the comparison.
  *
  * \param bufr	The buffer which the object buffer will be compared to.
  *
+ * \param offset	A pointer to the variable which will be set to the
+ *		offset of the first byte which differs.  If one buffer
+ *		is a prefix of the other this is the size of the
+ *		shorter buffer.
+ *
  * \return	A boolean value is used to indicate where or not the
- *		buffers are equivalent.  A true value indicates they
- *		match in size and content.  A false value indicates
- *		they are different.
+ *		buffers are equivalent.  A false value with an offset of
+ *		zero is also returned if either object is poisoned.
  */
 
-static _Bool equal(CO(Buffer, this), CO(Buffer, bufr))
+static _Bool compare(CO(Buffer, this), CO(Buffer, bufr), size_t * const offset)
 
 {
 	STATE(S);
 
+	unsigned char *bp;
 
-	/* Status checks. */
-	if ( S->poisoned )
+	size_t size;
+
+
+	*offset = 0;
+	if ( !_valid(S) )
 		return false;
 	if ( bufr->poisoned(bufr) ) {
 		S->poisoned = true;
 		return false;
 	}
 
-	/* Do size and content comparisons. */
-	if ( S->used != bufr->size(bufr) )
-		return false;
-	if ( memcmp(S->bf, bufr->get(bufr), S->used) != 0 )
-		return false;
+	size = bufr->size(bufr);
+	if ( S->used < size )
+		size = S->used;
+	if ( size > 0 ) {
+		if ( (bp = bufr->get(bufr)) == NULL )
+			return false;
+		*offset = S->bf == bp ? size : _mismatch(S->bf, bp, size);
+	}
 
-	return true;
+	return (*offset == S->used) && (*offset == bufr->size(bufr));
 }
 
 			
@@ -368,7 +3715,9 @@ static _Bool equal(CO(Buffer, this), CO(Buffer, bufr))
  * This method implements reducing the effective size of the internal
  * memory buffer. It does this by decrementing the used size count of
  * the buffer.  NOTE that it does not physically reallocate the size
- * of the memory allocation for the internal buffer.
+ * of the memory allocation for the internal buffer.  The bytes which
+ * are removed are cleared so that no content remains beyond the used
+ * size of the buffer.
  *
  * \param this	A pointer to the buffer object whose size is being
  *		reduced.
@@ -391,10 +3740,117 @@ static void shrink(CO(Buffer, this), size_t const cnt)
 		return;
 
 	S->used -= cnt;
+	if ( S->summed > S->used )
+		S->summed = S->used;
+	if ( (S->parent == NULL) && (S->store == NULL) && !S->mapped )
+		memset(S->bf + S->used, '\0', cnt);
+
 	return;
 }
 
 
+/**
+ * External public method.
+ *
+ * This method implements the removal of bytes from the front of the
+ * buffer, which allows a buffer to be used as a first-in first-out
+ * queue of bytes.  The removal only advances a read position so it
+ * takes constant time.  The memory in front of the read position is
+ * reclaimed when an addition to the buffer would otherwise need to
+ * grow it, and a buffer which is emptied is re-filled from the start
+ * of its memory.  The bytes which are removed from a secure buffer
+ * are wiped, while other buffers wipe them when the buffer is reset
+ * or destroyed.  Consuming from a view narrows its window.
+ *
+ * \param this	A pointer to the buffer object from which bytes are
+ *		to be removed.
+ *
+ * \param dest	A pointer to the memory which the removed bytes are to
+ *		be copied to.  A null value discards the bytes.
+ *
+ * \param cnt	The number of bytes which are to be removed.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		bytes were removed.  A false value indicates the object
+ *		is poisoned or holds fewer bytes than were requested.
+ */
+
+static _Bool consume(CO(Buffer, this), unsigned char * const dest, \
+		     size_t const cnt)
+
+{
+	STATE(S);
+
+
+	if ( !_valid(S) || (cnt > S->used) )
+		return false;
+	if ( cnt == 0 )
+		return true;
+
+	if ( dest != NULL )
+		memcpy(dest, S->bf, cnt);
+
+	if ( S->parent != NULL ) {
+		S->offset += cnt;
+		S->bf	  += cnt;
+		S->used	  -= cnt;
+		return true;
+	}
+
+	_sum(S);
+	if ( S->secure )
+		explicit_bzero(S->bf, cnt);
+
+	S->summed    -= cnt;
+	S->bf	     += cnt;
+	S->used	     -= cnt;
+	S->allocated -= cnt;
+	S->dirty      = S->dirty > cnt ? S->dirty - cnt : 0;
+	S->head	     += cnt;
+	S->consumed  += cnt;
+
+	if ( S->used == 0 )
+		_rewind(S);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements copying bytes from the front of the buffer
+ * without removing them.
+ *
+ * \param this	A pointer to the buffer object whose bytes are to be
+ *		copied.
+ *
+ * \param dest	A pointer to the memory which the bytes are to be
+ *		copied to.
+ *
+ * \param cnt	The number of bytes which are to be copied.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		bytes were copied.  A false value indicates the object
+ *		is poisoned or holds fewer bytes than were requested.
+ */
+
+static _Bool peek(CO(Buffer, this), unsigned char * const dest, \
+		  size_t const cnt)
+
+{
+	STATE(S);
+
+
+	if ( !_valid(S) || (dest == NULL) || (cnt > S->used) )
+		return false;
+
+	if ( cnt > 0 )
+		memcpy(dest, S->bf, cnt);
+	return true;
+}
+
+
 /**
  * External public method.
  *
@@ -413,7 +3869,7 @@ static size_t size(CO(Buffer, this))
 	STATE(S);
 
 
-	if ( S->poisoned )
+	if ( !_valid(S) )
 		return 0;
 	return S->used;
 }
@@ -439,8 +3895,65 @@ static void reset(CO(Buffer, this))
 	if ( S->poisoned )
 		return;
 
-	memset(S->bf, '\0', S->used);
-	S->used = 0;
+	_sum(S);
+	S->consumed += S->used;
+	_rewind(S);
+	if ( S->store != NULL ) {
+		_release(this, S->store);
+		S->store     = NULL;
+		S->bf	     = NULL;
+		S->allocated = 0;
+	}
+	else if ( S->mapped ) {
+		munmap(S->bf, S->allocated);
+		S->mapped    = false;
+		S->bf	     = NULL;
+		S->allocated = 0;
+	}
+	else if ( (S->parent == NULL) && (S->bf != NULL) )
+		memset(S->bf, '\0', _extent(S));
+	S->used	  = 0;
+	S->dirty  = 0;
+	S->summed = 0;
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method empties the buffer without clearing its contents, so a
+ * buffer used as scratch space can be re-used without a pass over
+ * its memory.  The contents which are left in place are still wiped
+ * when the buffer is reset or destroyed.  A secure buffer is always
+ * cleared, this method is equivalent to the reset method for it.
+ *
+ * \param this	A pointer to the buffer object which is to be
+ *		emptied.
+ */
+
+static void clear(CO(Buffer, this))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return;
+
+	if ( S->secure || S->mapped || (S->store != NULL) || \
+	     (S->parent != NULL) ) {
+		reset(this);
+		return;
+	}
+
+	_sum(S);
+	S->consumed += S->used;
+	_rewind(S);
+	S->dirty  = _extent(S);
+	S->used	  = 0;
+	S->summed = 0;
 
 	return;
 }
@@ -463,7 +3976,7 @@ static unsigned char *get(CO(Buffer, this))
 	STATE(S);
 
 
-	if ( S->poisoned )
+	if ( !_valid(S) )
 		return NULL;
 	return S->bf;
 }
@@ -484,17 +3997,23 @@ static void print(CO(Buffer,this))
 {
 	STATE(S);
 
-	size_t lp = 0;
+	char bufr[2 * BUFFER_HEX_CHUNK];
 
+	size_t lp,
+	       cnt;
 
-	if ( S->poisoned ) {
+
+	if ( !_valid(S) ) {
 		fputs("* POISONED *\n", stderr);
 		return;
 	}
 
-	while ( lp < S->used ) {
-		fprintf(stdout, "%02x", *(S->bf+lp));
-		++lp;
+	for (lp= 0; lp < S->used; lp += cnt) {
+		cnt = S->used - lp;
+		if ( cnt > BUFFER_HEX_CHUNK )
+			cnt = BUFFER_HEX_CHUNK;
+		_hex_encode(S->bf + lp, cnt, bufr);
+		fwrite(bufr, 2, cnt, stdout);
 	}
 	fputc('\n', stdout);
 
@@ -531,7 +4050,7 @@ static void hprint(CO(Buffer,this))
 	       lp1;
 
 
-	if ( S->poisoned ) {
+	if ( !_valid(S) ) {
 		fputs("* POISONED *\n", stderr);
 		return;
 	}
@@ -601,26 +4120,37 @@ static void dump(CO(Buffer, this), int offset)
 {
 	STATE(S);
 
-	Origin root = this->state->root;
+	Origin root = _state(this)->root;
 
 
 	if ( offset == 0 )
 		offset = 1;
 
+	_valid(S);
 	root->iprint(root, offset, __FILE__ " dump: %p\n", this);
 	root->iprint(root, offset, "\tbufr: %p\n", S->bf);
-	root->iprint(root, offset, "\tused: %u\n", S->used);
-	root->iprint(root, offset, "\tallocated: %u\n", S->seqn->get(S->seqn));
+	if ( S->parent != NULL ) {
+		root->iprint(root, offset, "\tview of: %p\n", S->parent);
+		root->iprint(root, offset, "\toffset: %zu\n", S->offset);
+	}
+	root->iprint(root, offset, "\trefs: %u\n", atomic_load(&S->refs));
+	if ( S->store != NULL )
+		root->iprint(root, offset, "\tshared: %u\n", \
+			     atomic_load(&S->store->refs));
+	root->iprint(root, offset, "\tused: %zu\n", S->used);
+	if ( S->head > 0 )
+		root->iprint(root, offset, "\tconsumed: %zu\n", S->head);
+	root->iprint(root, offset, "\tallocated: %zu\n", S->allocated);
 	root->iprint(root, offset, "\tstatus: %s\n", S->poisoned ? \
 		     "POISONED" : "OK");
 
 	root->iprint(root, offset, "\tContents: ");
 	if ( S->poisoned ) {
 		S->poisoned = false;
-		this->print(this);
+		print(this);
 	}
 	else	
-		this->print(this);
+		print(this);
 	root->iprint(root, offset, "\n");
   
 	offset += 1;
@@ -633,7 +4163,8 @@ static void dump(CO(Buffer, this), int offset)
 /**
  * External public method.
  *
- * This function returns the status of the object.
+ * This function returns the status of the object.  A view whose
+ * window is no longer covered by its parent is reported as poisoned.
  *
  * \param this	A point to the object whose status is being requested.
  */
@@ -642,14 +4173,16 @@ static _Bool poisoned(CO(Buffer, this))
 {
 	STATE(S);
 
-	return S->poisoned;
+	return !_valid(S);
 }
 
 
 /**
  * External public method.
  *
- * This function implements a destructor for a Buffer object.
+ * This function implements a destructor for a Buffer object.  If
+ * views of the object are outstanding the release of the object is
+ * deferred until the last of the views is destroyed.
  *
  * \param this	A pointer to the object which is to be destroyed.
  */
@@ -659,9 +4192,32 @@ static void whack(CO(Buffer, this))
 {
 	STATE(S);
 
-	if ( S->bf != NULL )
-		memset(S->bf, '\0', S->seqn->get(S->seqn));
-	free(S->bf);
+
+	/* The object is retained until the last view of it is released. */
+	if ( atomic_fetch_sub(&S->refs, 1) != 1 )
+		return;
+
+	_rewind(S);
+	if ( S->parent != NULL )
+		S->parent->whack(S->parent);
+	else if ( S->store != NULL )
+		_release(this, S->store);
+	else if ( S->mapped )
+		munmap(S->bf, S->allocated);
+	else if ( S->secure ) {
+		if ( S->bf != NULL )
+			_secure_free(S->bf, S->allocated);
+		S->root->account(S->root, this, -(long int) S->allocated);
+	}
+	else {
+		if ( S->bf != NULL )
+			explicit_bzero(S->bf, _extent(S));
+		if ( S->bf != S->small ) {
+			free(S->bf);
+			S->root->account(S->root, this, \
+					 -(long int) S->allocated);
+		}
+	}
 
 	S->seqn->whack(S->seqn);
 	S->root->whack(S->root, this, S);
@@ -671,20 +4227,77 @@ static void whack(CO(Buffer, this))
 
 	
 /**
- * External constructor call.
+ * The method table which is copied into each Buffer object by its
+ * constructor.
+ */
+static const struct HurdLib_Buffer Buffer_methods = {
+	.add		= add,
+	.add_Buffer	= add_Buffer,
+	.reserve	= reserve,
+	.set_growth	= set_growth,
+	.set_secure	= set_secure,
+	.set_checksum	= set_checksum,
+	.sum		= sum,
+	.map		= map,
+	.advise		= advise,
+	.stats		= stats,
+	.add_hexstring	= add_hexstring,
+	.encode_hex	= encode_hex,
+	.add_base64	= add_base64,
+	.encode_base64	= encode_base64,
+	.add_int	= add_int,
+	.add_ints	= add_ints,
+	.add_varint	= add_varint,
+	.add_varints	= add_varints,
+	.get_int	= get_int,
+	.get_ints	= get_ints,
+	.get_varint	= get_varint,
+	.get_varints	= get_varints,
+	.extend		= extend,
+	.view		= view,
+	.share		= share,
+	.equal		= equal,
+	.equal_ct	= equal_ct,
+	.compare	= compare,
+
+	.get		= get,
+	.shrink		= shrink,
+	.consume	= consume,
+	.peek		= peek,
+	.size		= size,
+	.reset		= reset,
+	.clear		= clear,
+	.print		= print,
+	.hprint		= hprint,
+	.dump		= dump,
+	.poisoned	= poisoned,
+	.whack		= whack,
+};
+
+
+/**
+ * Internal private function.
  *
- * This function implements a constructor call for a Buffer object.
+ * This function implements the construction of a Buffer object in either
+ * its full or its compact representation.
  *
- * \return	A pointer to the initialized Buffer.
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
  */
 
-extern Buffer HurdLib_Buffer_Init(void)
+static void *_create(_Bool const compact)
 
 {
 	Origin root;
 
 	Buffer this = NULL;
 
+	Buffer_State S;
+
 	struct HurdLib_Origin_Retn retn;
 
 
@@ -693,37 +4306,127 @@ extern Buffer HurdLib_Buffer_Init(void)
 
 	/* Allocate the object and internal state. */
 	retn.object_size  = sizeof(struct HurdLib_Buffer);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Buffer_Compact);
 	retn.state_size	  = sizeof(struct HurdLib_Buffer_State);
 	if ( !root->init(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, &retn) )
 		return NULL;
-	this	    	  = retn.object;
-	this->state 	  = retn.state;
-	this->state->root = root;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Buffer_Compact) this)->methods = &Buffer_methods;
+		((Buffer_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Buffer_methods;
+		this->state = S;
+	}
+	S->root = root;
 
 	/* Initialize aggregate objects. */
-	if ( (this->state->seqn = HurdLib_Fibsequence_Init()) == NULL ) {
-		root->whack(root, this, this->state);
+	if ( (S->seqn = HurdLib_Fibsequence_Init()) == NULL ) {
+		root->whack(root, this, S);
 		return NULL;
 	}
 
 	/* Initialize object state. */
-	_init_state(this->state);
-
-	/* Method initialization. */
-	this->add     	    = add;
-	this->add_Buffer    = add_Buffer;
-	this->add_hexstring = add_hexstring;
-	this->equal	    = equal;
-
-	this->get     	    = get;
-	this->shrink  	    = shrink;
-	this->size    	    = size;
-	this->reset	    = reset;
-	this->print   	    = print;
-	this->hprint	    = hprint;
-	this->dump    	    = dump;
-	this->poisoned	    = poisoned;
-	this->whack   	    = whack;
+	_init_state(S);
+
+	return this;
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Buffer object.
+ *
+ * \return	A pointer to the initialized Buffer.
+ */
+
+extern Buffer HurdLib_Buffer_Init(void)
+
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Buffer object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Buffer object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Buffer_Compact HurdLib_Buffer_Init_compact(void)
+
+{
+	return _create(true);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Buffer object
+ * which uses the specified growth policy.
+ *
+ * \param growth	The growth policy to be used by the buffer.
+ *
+ * \param chunk		The allocation increment used by the fixed chunk
+ *			policy.
+ *
+ * \return		A pointer to the initialized Buffer.  A NULL value
+ *			indicates an error was encountered in object
+ *			initialization.
+ */
+
+extern Buffer HurdLib_Buffer_Init_growth(enum Buffer_growth const growth, \
+					 size_t const chunk)
+
+{
+	Buffer this;
+
+
+	if ( (this = HurdLib_Buffer_Init()) == NULL )
+		return NULL;
+
+	if ( !this->set_growth(this, growth, chunk) ) {
+		this->whack(this);
+		return NULL;
+	}
+
+	return this;
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Buffer object
+ * which holds secret contents in locked memory.
+ *
+ * \return	A pointer to the initialized Buffer.  A NULL value
+ *		indicates an error was encountered in object
+ *		initialization.
+ */
+
+extern Buffer HurdLib_Buffer_Init_secure(void)
+
+{
+	Buffer this;
+
+
+	if ( (this = HurdLib_Buffer_Init()) == NULL )
+		return NULL;
+
+	if ( !this->set_secure(this) ) {
+		this->whack(this);
+		return NULL;
+	}
 
 	return this;
 }
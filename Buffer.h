@@ -11,12 +11,83 @@
 #ifndef HurdLib_Buffer_HEADER
 #define HurdLib_Buffer_HEADER
 
+#include <stdint.h>
+
 
 /* Object type definitions. */
 typedef struct HurdLib_Buffer * Buffer;
 
 typedef struct HurdLib_Buffer_State * Buffer_State;
 
+typedef struct HurdLib_Buffer_Compact * Buffer_Compact;
+
+/* The Checksum object which can be attached to a Buffer. */
+struct HurdLib_Checksum;
+
+/**
+ * The following enumeration defines the policies which can be used
+ * to size the memory allocation of a Buffer as it grows.
+ */
+enum Buffer_growth {
+	Buffer_growth_fibonacci=0,
+	Buffer_growth_geometric_15,
+	Buffer_growth_geometric_2,
+	Buffer_growth_page,
+	Buffer_growth_chunk
+};
+
+
+/**
+ * The following enumeration defines the access patterns which can be
+ * declared for a Buffer which maps a file.
+ */
+enum Buffer_access {
+	Buffer_access_normal=0,
+	Buffer_access_sequential,
+	Buffer_access_random,
+	Buffer_access_willneed
+};
+
+
+/**
+ * The following enumeration defines the options which select the
+ * alphabet and validation used by the base64 codec.  The options
+ * can be combined.
+ */
+enum Buffer_base64 {
+	Buffer_base64_standard=0,
+	Buffer_base64_url=1,
+	Buffer_base64_strict=2
+};
+
+
+/**
+ * The following enumeration defines the byte orders in which fixed
+ * width integers can be serialized.
+ */
+enum Buffer_endian {
+	Buffer_endian_big=0,
+	Buffer_endian_little
+};
+
+
+/**
+ * The following structure is used to return the allocation statistics
+ * of a Buffer.
+ */
+struct HurdLib_Buffer_Stats
+{
+	/* The allocated capacity of the buffer. */
+	size_t capacity;
+
+	/* The number of times the buffer has been re-allocated. */
+	unsigned long int reallocs;
+
+	/* The number of bytes of content moved by re-allocation. */
+	size_t copied;
+};
+
+
 /**
  * External Buffer object representation.
  */
@@ -25,13 +96,44 @@ struct HurdLib_Buffer
 	/* External methods. */
 	_Bool (*add)(const Buffer, unsigned char const *, size_t);
 	_Bool (*add_Buffer)(const Buffer, const Buffer);
+	_Bool (*reserve)(const Buffer, size_t);
+	_Bool (*set_growth)(const Buffer, enum Buffer_growth, size_t);
+	_Bool (*set_secure)(const Buffer);
+	_Bool (*set_checksum)(const Buffer, struct HurdLib_Checksum *);
+	void (*sum)(const Buffer);
+	_Bool (*map)(const Buffer, int, _Bool, enum Buffer_access);
+	_Bool (*advise)(const Buffer, enum Buffer_access);
+	void (*stats)(const Buffer, struct HurdLib_Buffer_Stats *);
 	_Bool (*add_hexstring)(const Buffer, char const *);
+	_Bool (*encode_hex)(const Buffer, char *, size_t);
+	_Bool (*add_base64)(const Buffer, char const *, enum Buffer_base64);
+	_Bool (*encode_base64)(const Buffer, char *, size_t,
+			       enum Buffer_base64);
+	_Bool (*add_int)(const Buffer, uint64_t, size_t, enum Buffer_endian);
+	_Bool (*add_ints)(const Buffer, void const *, size_t, size_t,
+			  enum Buffer_endian);
+	_Bool (*add_varint)(const Buffer, uint64_t);
+	_Bool (*add_varints)(const Buffer, uint64_t const *, size_t);
+	_Bool (*get_int)(const Buffer, size_t *, uint64_t *, size_t,
+			 enum Buffer_endian);
+	_Bool (*get_ints)(const Buffer, size_t *, void *, size_t, size_t,
+			  enum Buffer_endian);
+	_Bool (*get_varint)(const Buffer, size_t *, uint64_t *);
+	_Bool (*get_varints)(const Buffer, size_t *, uint64_t *, size_t);
+	unsigned char * (*extend)(const Buffer, size_t);
+	_Bool (*view)(const Buffer, const Buffer, size_t, size_t);
+	_Bool (*share)(const Buffer, const Buffer);
 	_Bool (*equal)(const Buffer, const Buffer);
+	_Bool (*equal_ct)(const Buffer, const Buffer);
+	_Bool (*compare)(const Buffer, const Buffer, size_t *);
 
 	unsigned char * (*get)(const Buffer);
 	void (*shrink)(const Buffer, size_t);
+	_Bool (*consume)(const Buffer, unsigned char *, size_t);
+	_Bool (*peek)(const Buffer, unsigned char *, size_t);
 	size_t (*size)(const Buffer);
 	void (*reset)(const Buffer);
+	void (*clear)(const Buffer);
 	void (*print)(const Buffer);
 	void (*hprint)(const Buffer);
 	void (*dump)(const Buffer, int);
@@ -43,7 +145,25 @@ struct HurdLib_Buffer
 };
 
 
+/**
+ * Compact Buffer object representation.  The object refers to the
+ * method table shared by all Buffer objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Buffer_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Buffer *methods;
+
+	/* Private state. */
+	Buffer_State state;
+};
+
+
 /* Buffer constructor call. */
 extern HCLINK Buffer HurdLib_Buffer_Init(void);
+extern HCLINK Buffer HurdLib_Buffer_Init_growth(enum Buffer_growth, size_t);
+extern HCLINK Buffer HurdLib_Buffer_Init_secure(void);
+extern HCLINK Buffer_Compact HurdLib_Buffer_Init_compact(void);
 
 #endif
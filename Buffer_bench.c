@@ -0,0 +1,1265 @@
+/** \file
+ * This file contains a benchmark which compares the growth policies
+ * supported by the Buffer object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "HurdLib.h"
+#include "Buffer.h"
+
+
+/* Default number of small payload buffers which are filled. */
+#define ITERATIONS 10000
+
+/* The size and append size of the small payload. */
+#define SMALL_PAYLOAD 4096
+#define SMALL_APPEND 16
+
+/* The size of the inline storage of a Buffer. */
+#define SMALL_INLINE 64
+
+/* The size and append size of the large payload. */
+#define LARGE_PAYLOAD (16 * 1024 * 1024)
+#define LARGE_APPEND 4096
+
+/* The number of binary bytes converted by each hexadecimal pass. */
+#define HEX_BYTES (64 * 1024 * 1024)
+
+/* The number of binary bytes converted by each base64 pass. */
+#define BASE64_BYTES (48 * 1024 * 1024)
+
+/* The number of bytes compared for each comparison size. */
+#define COMPARE_BYTES (256 * 1024 * 1024)
+
+/* The number of integers in each serialized record. */
+#define SERIAL_INTEGERS 4096
+
+/* The standard base64 alphabet used by the byte at a time baseline. */
+static char const Base64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ" \
+			     "abcdefghijklmnopqrstuvwxyz0123456789+/";
+
+
+/*
+ * The number of heap allocations made.  The benchmark is linked with
+ * malloc and realloc wrapped so the allocations made by the library
+ * can be counted.
+ */
+static unsigned long int Allocations = 0;
+
+extern void *__real_malloc(size_t);
+extern void *__real_realloc(void *, size_t);
+
+
+/**
+ * Private function.
+ *
+ * This function counts and forwards a call to malloc.
+ */
+
+extern void *__wrap_malloc(size_t size)
+
+{
+	++Allocations;
+	return __real_malloc(size);
+}
+
+
+/**
+ * Private function.
+ *
+ * This function counts and forwards a call to realloc.
+ */
+
+extern void *__wrap_realloc(void *ptr, size_t size)
+
+{
+	++Allocations;
+	return __real_realloc(ptr, size);
+}
+
+
+/**
+ * Private function.
+ *
+ * This function returns the current value of the monotonic clock in
+ * nanoseconds.
+ */
+
+static double now(void)
+
+{
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures filling a set of buffers with a payload
+ * using the specified growth policy.
+ *
+ * \param growth	The growth policy to be used.
+ *
+ * \param reserve	A flag used to indicate the payload size is to
+ *			be reserved before the buffer is filled.
+ *
+ * \param buffers	The number of buffers to be filled.
+ *
+ * \param payload	The number of bytes added to each buffer.
+ *
+ * \param append	The number of bytes added by each call.
+ *
+ * \param stats		A pointer to the structure which will be
+ *			populated with the statistics of the last
+ *			buffer.
+ *
+ * \return		The average number of nanoseconds per append.  A
+ *			negative value indicates an allocation failure.
+ */
+
+static double fill(enum Buffer_growth const growth, _Bool const reserve, \
+		   unsigned long int const buffers, size_t const payload, \
+		   size_t const append, \
+		   struct HurdLib_Buffer_Stats * const stats)
+
+{
+	unsigned long int lp;
+
+	size_t cnt;
+
+	double start;
+
+	Buffer bufr;
+
+	static unsigned char data[LARGE_APPEND];
+
+
+	start = now();
+	for (lp= 0; lp < buffers; ++lp) {
+		if ( (bufr = HurdLib_Buffer_Init_growth(growth, 0)) == NULL )
+			return -1;
+		if ( reserve && !bufr->reserve(bufr, payload) )
+			return -1;
+
+		for (cnt= 0; cnt < payload; cnt += append) {
+			if ( !bufr->add(bufr, data, append) )
+				return -1;
+		}
+
+		bufr->stats(bufr, stats);
+		WHACK(bufr);
+	}
+
+	return (now() - start) / (buffers * (payload / append));
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the creation, population and release of a
+ * small buffer.
+ *
+ * \param iterations	The number of buffers to create.
+ *
+ * \param payload	The number of bytes added to each buffer.
+ *
+ * \param heap		A flag used to indicate the buffer is to be
+ *			forced onto the heap by reserving more than
+ *			the inline storage.
+ *
+ * \param allocs	A pointer to the variable which will be set to
+ *			the average number of heap allocations made
+ *			for each buffer.
+ *
+ * \return		The average number of nanoseconds per buffer.  A
+ *			negative value indicates an allocation failure.
+ */
+
+static double small(unsigned long int const iterations, \
+		    size_t const payload, _Bool const heap, \
+		    double * const allocs)
+
+{
+	unsigned long int lp,
+			  start_allocs = Allocations;
+
+	double start;
+
+	Buffer bufr;
+
+	static unsigned char data[SMALL_INLINE];
+
+
+	start = now();
+	for (lp= 0; lp < iterations; ++lp) {
+		INIT(HurdLib, Buffer, bufr, return -1);
+		if ( heap && !bufr->reserve(bufr, SMALL_INLINE + 1) )
+			return -1;
+		if ( !bufr->add(bufr, data, payload) )
+			return -1;
+		WHACK(bufr);
+	}
+
+	*allocs = (double) (Allocations - start_allocs) / iterations;
+	return (now() - start) / iterations;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements the byte at a time hexadecimal decoding
+ * which the Buffer object used before the conversion was vectorized.
+ * It is retained as the baseline for the hexadecimal benchmark.
+ *
+ * \param bufr		The object which the decoded bytes are to be
+ *			added to.
+ *
+ * \param hex		A pointer to the null-terminated string which
+ *			is to be decoded.
+ *
+ * \return		A boolean value is used to indicate whether
+ *			or not the string was decoded.
+ */
+
+static _Bool legacy_decode(CO(Buffer, bufr), CO(char *, hex))
+
+{
+	_Bool first_nybble = true;
+
+	unsigned char nybble,
+		      byte = 0;
+
+	size_t lp;
+
+
+	for (lp= 0; hex[lp] != '\0'; ++lp) {
+		nybble = toupper(hex[lp]);
+		if ( (nybble >= '0') && (nybble <= '9') )
+			nybble -= '0';
+		else if ( (nybble >= 'A') && (nybble <= 'F') )
+			nybble -= 'A' - 10;
+		else
+			return false;
+
+		if ( first_nybble ) {
+			byte = nybble << 4;
+			first_nybble = false;
+		} else {
+			byte |= nybble;
+			if ( !bufr->add(bufr, &byte, sizeof(byte)) )
+				return false;
+			first_nybble = true;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements the formatted output hexadecimal encoding
+ * which the Buffer object used before the conversion was vectorized.
+ *
+ * \param bufr		The object whose contents are to be encoded.
+ *
+ * \param hex		A pointer to the character buffer which the
+ *			encoding is to be written to.
+ */
+
+static void legacy_encode(CO(Buffer, bufr), char *hex)
+
+{
+	unsigned char *bp = bufr->get(bufr);
+
+	size_t lp;
+
+
+	for (lp= 0; lp < bufr->size(bufr); ++lp)
+		hex += sprintf(hex, "%02x", bp[lp]);
+
+	return;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the hexadecimal decoding and encoding rates
+ * of the current and legacy implementations.
+ *
+ * \param bytes		The number of binary bytes in each pass.
+ *
+ * \return		A boolean value is used to indicate whether
+ *			or not the benchmark completed.
+ */
+
+static _Bool hex(size_t const bytes)
+
+{
+	_Bool retn = false;
+
+	char *text = NULL,
+	     *out  = NULL;
+
+	unsigned char *bp;
+
+	size_t lp;
+
+	double start,
+	       times[4];
+
+	Buffer bufr   = NULL,
+	       legacy = NULL;
+
+
+	if ( (text = malloc(2 * bytes + 1)) == NULL )
+		goto done;
+	if ( (out = malloc(2 * bytes + 1)) == NULL )
+		goto done;
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( (bp = bufr->extend(bufr, bytes)) == NULL )
+		goto done;
+	for (lp= 0; lp < bytes; ++lp)
+		bp[lp] = lp * 131 + (lp >> 8);
+	if ( !bufr->encode_hex(bufr, text, 2 * bytes + 1) )
+		goto done;
+
+	/* Decoding. */
+	start = now();
+	INIT(HurdLib, Buffer, legacy, goto done);
+	if ( !legacy_decode(legacy, text) )
+		goto done;
+	times[0] = now() - start;
+
+	bufr->reset(bufr);
+	start = now();
+	if ( !bufr->add_hexstring(bufr, text) )
+		goto done;
+	times[1] = now() - start;
+	if ( !bufr->equal(bufr, legacy) )
+		goto done;
+
+	/* Encoding. */
+	start = now();
+	legacy_encode(legacy, out);
+	times[2] = now() - start;
+
+	start = now();
+	if ( !bufr->encode_hex(bufr, out, 2 * bytes + 1) )
+		goto done;
+	times[3] = now() - start;
+	if ( strcmp(out, text) != 0 )
+		goto done;
+
+	fprintf(stdout, "%-16s %10s %10s %10s\n", "Direction", \
+		"legacy", "current", "speedup");
+	fprintf(stdout, "%-16s %10.3f %10.3f %9.1fx\n", "decode GB/s", \
+		bytes / times[0], bytes / times[1], \
+		times[0] / times[1]);
+	fprintf(stdout, "%-16s %10.3f %10.3f %9.1fx\n", "encode GB/s", \
+		bytes / times[2], bytes / times[3], \
+		times[2] / times[3]);
+	retn = true;
+
+
+ done:
+	free(text);
+	free(out);
+	WHACK(bufr);
+	WHACK(legacy);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements a base64 decoding which appends each
+ * decoded byte to the buffer as it is generated.  It is the baseline
+ * for the base64 benchmark.
+ *
+ * \param bufr		The object which the decoded bytes are to be
+ *			added to.
+ *
+ * \param text		A pointer to the null-terminated string which
+ *			is to be decoded.
+ *
+ * \return		A boolean value is used to indicate whether
+ *			or not the string was decoded.
+ */
+
+static _Bool bytewise_decode(CO(Buffer, bufr), CO(char *, text))
+
+{
+	unsigned char byte;
+
+	unsigned int bits  = 0,
+		     value,
+		     count = 0;
+
+	size_t lp;
+
+	char const *p;
+
+
+	for (lp= 0; (text[lp] != '\0') && (text[lp] != '='); ++lp) {
+		if ( (p = strchr(Base64, text[lp])) == NULL )
+			return false;
+		value = p - Base64;
+
+		bits = (bits << 6) | value;
+		count += 6;
+		if ( count >= 8 ) {
+			count -= 8;
+			byte = bits >> count;
+			if ( !bufr->add(bufr, &byte, sizeof(byte)) )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements a base64 encoding which appends each
+ * encoded character to a buffer as it is generated.  It is the
+ * baseline for the base64 benchmark.
+ *
+ * \param bufr		The object whose contents are to be encoded.
+ *
+ * \param out		The object which the encoding is to be added
+ *			to.
+ *
+ * \return		A boolean value is used to indicate whether
+ *			or not the contents were encoded.
+ */
+
+static _Bool bytewise_encode(CO(Buffer, bufr), CO(Buffer, out))
+
+{
+	unsigned char *bp = bufr->get(bufr),
+		      c;
+
+	unsigned int bits  = 0,
+		     count = 0;
+
+	size_t lp;
+
+
+	for (lp= 0; lp < bufr->size(bufr); ++lp) {
+		bits = (bits << 8) | bp[lp];
+		count += 8;
+		while ( count >= 6 ) {
+			count -= 6;
+			c = Base64[(bits >> count) & 0x3f];
+			if ( !out->add(out, &c, sizeof(c)) )
+				return false;
+		}
+	}
+
+	if ( count > 0 ) {
+		c = Base64[(bits << (6 - count)) & 0x3f];
+		if ( !out->add(out, &c, sizeof(c)) )
+			return false;
+	}
+	for (c= '='; (out->size(out) % 4) != 0;) {
+		if ( !out->add(out, &c, sizeof(c)) )
+			return false;
+	}
+
+	c = '\0';
+	return out->add(out, &c, sizeof(c));
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the base64 decoding and encoding rates of
+ * the Buffer object in both alphabets against the byte at a time
+ * baseline.
+ *
+ * \param bytes		The number of binary bytes in each pass.
+ *
+ * \return		A boolean value is used to indicate whether
+ *			or not the benchmark completed.
+ */
+
+static _Bool base64(size_t const bytes)
+
+{
+	_Bool retn = false;
+
+	char *text = NULL,
+	     *url  = NULL,
+	     *out  = NULL;
+
+	unsigned char *bp;
+
+	size_t lp,
+	       length = 4 * ((bytes + 2) / 3) + 1;
+
+	double start,
+	       times[6];
+
+	Buffer bufr	= NULL,
+	       bytewise = NULL,
+	       encoded  = NULL;
+
+
+	if ( (text = malloc(length)) == NULL )
+		goto done;
+	if ( (url = malloc(length)) == NULL )
+		goto done;
+	if ( (out = malloc(length)) == NULL )
+		goto done;
+	memset(out, '=', length);
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( (bp = bufr->extend(bufr, bytes)) == NULL )
+		goto done;
+	for (lp= 0; lp < bytes; ++lp)
+		bp[lp] = lp * 131 + (lp >> 8);
+	if ( !bufr->encode_base64(bufr, text, length, Buffer_base64_standard) )
+		goto done;
+	if ( !bufr->encode_base64(bufr, url, length, Buffer_base64_url) )
+		goto done;
+
+	/* Decoding. */
+	INIT(HurdLib, Buffer, bytewise, goto done);
+	start = now();
+	if ( !bytewise_decode(bytewise, text) )
+		goto done;
+	times[0] = now() - start;
+
+	bufr->reset(bufr);
+	start = now();
+	if ( !bufr->add_base64(bufr, text, Buffer_base64_strict) )
+		goto done;
+	times[1] = now() - start;
+	if ( !bufr->equal(bufr, bytewise) )
+		goto done;
+
+	bufr->reset(bufr);
+	start = now();
+	if ( !bufr->add_base64(bufr, url, Buffer_base64_url | \
+			       Buffer_base64_strict) )
+		goto done;
+	times[2] = now() - start;
+	if ( !bufr->equal(bufr, bytewise) )
+		goto done;
+
+	/* Encoding. */
+	INIT(HurdLib, Buffer, encoded, goto done);
+	start = now();
+	if ( !bytewise_encode(bufr, encoded) )
+		goto done;
+	times[3] = now() - start;
+
+	start = now();
+	if ( !bufr->encode_base64(bufr, out, length, Buffer_base64_standard) )
+		goto done;
+	times[4] = now() - start;
+	if ( strcmp(out, (char *) encoded->get(encoded)) != 0 )
+		goto done;
+
+	start = now();
+	if ( !bufr->encode_base64(bufr, out, length, Buffer_base64_url) )
+		goto done;
+	times[5] = now() - start;
+	if ( strcmp(out, url) != 0 )
+		goto done;
+
+	fprintf(stdout, "%-16s %10s %10s %10s %10s\n", "Direction", \
+		"bytewise", "standard", "url", "speedup");
+	fprintf(stdout, "%-16s %10.3f %10.3f %10.3f %9.1fx\n", \
+		"decode GB/s", bytes / times[0], bytes / times[1], \
+		bytes / times[2], times[0] / times[1]);
+	fprintf(stdout, "%-16s %10.3f %10.3f %10.3f %9.1fx\n", \
+		"encode GB/s", bytes / times[3], bytes / times[4], \
+		bytes / times[5], times[3] / times[4]);
+	retn = true;
+
+
+ done:
+	free(text);
+	free(url);
+	free(out);
+	WHACK(bufr);
+	WHACK(bytewise);
+	WHACK(encoded);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the cost of removing records from the front
+ * of a receive queue.  Each pass appends a block of received bytes
+ * and removes fixed size records until less than a record remains.
+ * The records are removed either with the consume method or by
+ * copying the remainder of the queue into a new buffer.
+ *
+ * \param block		The number of bytes received in each pass.
+ *
+ * \param record	The size of the records which are removed.
+ *
+ * \param iterations	The number of passes.
+ *
+ * \param cursor	A flag used to indicate the consume method is
+ *			to be used.
+ *
+ * \return		The average number of nanoseconds per record.
+ *			A negative value indicates a failure.
+ */
+
+static double drain(size_t const block, size_t const record, \
+		    unsigned long int const iterations, _Bool const cursor)
+
+{
+	unsigned long int lp,
+			  records = 0;
+
+	unsigned char *bp,
+		      out[record];
+
+	double start;
+
+	Buffer bufr,
+	       copy,
+	       swap;
+
+
+	INIT(HurdLib, Buffer, bufr, return -1);
+	INIT(HurdLib, Buffer, copy, return -1);
+
+	start = now();
+	for (lp= 0; lp < iterations; ++lp) {
+		if ( (bp = bufr->extend(bufr, block)) == NULL )
+			return -1;
+		memset(bp, lp, block);
+
+		while ( bufr->size(bufr) >= record ) {
+			if ( cursor ) {
+				if ( !bufr->consume(bufr, out, record) )
+					return -1;
+			} else {
+				memcpy(out, bufr->get(bufr), record);
+				copy->reset(copy);
+				if ( !copy->add(copy, bufr->get(bufr) + record, \
+						bufr->size(bufr) - record) )
+					return -1;
+				swap = bufr;
+				bufr = copy;
+				copy = swap;
+			}
+			++records;
+		}
+	}
+	start = (now() - start) / records;
+
+	WHACK(bufr);
+	WHACK(copy);
+	return start;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function serializes an integer as a big-endian field and adds
+ * it to a buffer, the way records were assembled before the integer
+ * methods of the Buffer object were available.
+ *
+ * \param bufr	The buffer the field is to be added to.
+ *
+ * \param value	The value of the field.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		field was added.
+ */
+
+static _Bool field_add(CO(Buffer, bufr), uint32_t const value)
+
+{
+	unsigned char bytes[4];
+
+
+	bytes[0] = value >> 24;
+	bytes[1] = value >> 16;
+	bytes[2] = value >> 8;
+	bytes[3] = value;
+
+	return bufr->add(bufr, bytes, sizeof(bytes));
+}
+
+
+/**
+ * Private function.
+ *
+ * This function LEB128 encodes an integer and adds it to a buffer as
+ * a separate field.
+ *
+ * \param bufr	The buffer the field is to be added to.
+ *
+ * \param value	The integer to be encoded.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		field was added.
+ */
+
+static _Bool field_add_varint(CO(Buffer, bufr), uint64_t value)
+
+{
+	unsigned char bytes[10],
+		      *bp = bytes;
+
+
+	while ( value >= 0x80 ) {
+		*bp++ = value | 0x80;
+		value >>= 7;
+	}
+	*bp++ = value;
+
+	return bufr->add(bufr, bytes, bp - bytes);
+}
+
+
+/**
+ * Private function.
+ *
+ * This function removes a LEB128 encoded integer from the front of a
+ * buffer a byte at a time.
+ *
+ * \param bufr	The buffer the integer is to be removed from.
+ *
+ * \param value	A pointer to the variable which will be set to the
+ *		integer.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		integer was removed.
+ */
+
+static _Bool field_get_varint(CO(Buffer, bufr), uint64_t * const value)
+
+{
+	unsigned char byte;
+
+	unsigned int shift = 0;
+
+	uint64_t v = 0;
+
+
+	do {
+		if ( (shift > 63) || !bufr->consume(bufr, &byte, 1) )
+			return false;
+		v |= (uint64_t) (byte & 0x7f) << shift;
+		shift += 7;
+	} while ( byte & 0x80 );
+
+	*value = v;
+	return true;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the serialization of records of integers,
+ * comparing fields added and removed one at a time with the methods
+ * which convert an array of integers in a single call.
+ *
+ * \param count		The number of integers in each record.
+ *
+ * \param records	The number of records which are serialized.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the benchmark completed.
+ */
+
+static _Bool serialize(size_t const count, unsigned long int const records)
+
+{
+	_Bool retn = false;
+
+	unsigned int mode;
+
+	unsigned long int lp;
+
+	size_t cnt,
+	       posn;
+
+	uint32_t *fixed	  = NULL,
+		 *fixed_out = NULL,
+		 bytes;
+
+	uint64_t *varint     = NULL,
+		 *varint_out = NULL;
+
+	double start,
+	       elapsed,
+	       times[8];
+
+	Buffer bufr = NULL,
+	       view = NULL;
+
+	static const char *names[] = {
+		"u32 encode", "u32 decode", "varint encode", "varint decode"
+	};
+
+
+	fixed	   = malloc(count * sizeof(uint32_t));
+	fixed_out  = malloc(count * sizeof(uint32_t));
+	varint	   = malloc(count * sizeof(uint64_t));
+	varint_out = malloc(count * sizeof(uint64_t));
+	if ( (fixed == NULL) || (fixed_out == NULL) || (varint == NULL) || \
+	     (varint_out == NULL) )
+		goto done;
+
+	/* Varints of one to five bytes, as in typical length fields. */
+	for (cnt= 0; cnt < count; ++cnt) {
+		fixed[cnt]  = cnt * 2654435761U;
+		varint[cnt] = fixed[cnt] >> (7 * (cnt % 5));
+	}
+
+	for (mode= 0; mode < 8; ++mode) {
+		elapsed = 0;
+		for (lp= 0; lp < records; ++lp) {
+			WHACK(bufr);
+			WHACK(view);
+			INIT(HurdLib, Buffer, bufr, goto done);
+			INIT(HurdLib, Buffer, view, goto done);
+
+			/* Records which are decoded are prepared untimed. */
+			if ( (mode == 1) || (mode == 5) ) {
+				if ( !bufr->add_ints(bufr, fixed, count, \
+						     sizeof(uint32_t), \
+						     Buffer_endian_big) )
+					goto done;
+			}
+			if ( (mode == 3) || (mode == 7) ) {
+				if ( !bufr->add_varints(bufr, varint, count) )
+					goto done;
+			}
+			if ( !view->view(view, bufr, 0, bufr->size(bufr)) )
+				goto done;
+
+			start = now();
+			switch ( mode ) {
+				case 0:
+					for (cnt= 0; cnt < count; ++cnt) {
+						if ( !field_add(bufr, \
+								fixed[cnt]) )
+							goto done;
+					}
+					break;
+				case 1:
+					for (cnt= 0; cnt < count; ++cnt) {
+						if ( !view->consume(view, \
+							(unsigned char *) &bytes, \
+							sizeof(bytes)) )
+							goto done;
+						fixed_out[cnt] = \
+							__builtin_bswap32(bytes);
+					}
+					break;
+				case 2:
+					for (cnt= 0; cnt < count; ++cnt) {
+						if ( !field_add_varint(bufr, \
+							varint[cnt]) )
+							goto done;
+					}
+					break;
+				case 3:
+					for (cnt= 0; cnt < count; ++cnt) {
+						if ( !field_get_varint(view, \
+							&varint_out[cnt]) )
+							goto done;
+					}
+					break;
+				case 4:
+					if ( !bufr->add_ints(bufr, fixed, count, \
+						sizeof(uint32_t), \
+						Buffer_endian_big) )
+						goto done;
+					break;
+				case 5:
+					posn = 0;
+					if ( !bufr->get_ints(bufr, &posn, \
+						fixed_out, count, \
+						sizeof(uint32_t), \
+						Buffer_endian_big) )
+						goto done;
+					break;
+				case 6:
+					if ( !bufr->add_varints(bufr, varint, \
+								count) )
+						goto done;
+					break;
+				case 7:
+					posn = 0;
+					if ( !bufr->get_varints(bufr, &posn, \
+						varint_out, count) )
+						goto done;
+					break;
+			}
+			elapsed += now() - start;
+		}
+		times[mode] = elapsed / ((double) records * count);
+
+		if ( (mode % 4 == 1) && \
+		     (memcmp(fixed, fixed_out, count * sizeof(uint32_t)) \
+		      != 0) )
+			goto done;
+		if ( (mode % 4 == 3) && \
+		     (memcmp(varint, varint_out, count * sizeof(uint64_t)) \
+		      != 0) )
+			goto done;
+		memset(fixed_out, '\0', count * sizeof(uint32_t));
+		memset(varint_out, '\0', count * sizeof(uint64_t));
+	}
+
+	fprintf(stdout, "%-16s %10s %10s %10s\n", "Operation", "field ns", \
+		"batch ns", "speedup");
+	for (mode= 0; mode < 4; ++mode) {
+		fprintf(stdout, "%-16s %10.2f %10.2f %9.1fx\n", names[mode], \
+			times[mode], times[mode + 4], \
+			times[mode] / times[mode + 4]);
+	}
+	retn = true;
+
+
+ done:
+	free(fixed);
+	free(fixed_out);
+	free(varint);
+	free(varint_out);
+	WHACK(bufr);
+	WHACK(view);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the rate at which two identical buffers of
+ * a given size are compared by memcmp and by each of the comparison
+ * methods of the Buffer object.
+ *
+ * \param size		The size of the buffers to be compared.
+ *
+ * \return		A boolean value is used to indicate whether
+ *			or not the benchmark completed.
+ */
+
+static _Bool compare(size_t const size)
+
+{
+	_Bool retn = false;
+
+	unsigned int mode;
+
+	unsigned long int lp,
+			  iterations = COMPARE_BYTES / size;
+
+	size_t offset;
+
+	volatile int result = 0;
+
+	double start,
+	       times[4];
+
+	Buffer bufr1 = NULL,
+	       bufr2 = NULL;
+
+
+	INIT(HurdLib, Buffer, bufr1, goto done);
+	INIT(HurdLib, Buffer, bufr2, goto done);
+	memset(bufr1->extend(bufr1, size), 'A', size);
+	memset(bufr2->extend(bufr2, size), 'A', size);
+	if ( bufr1->poisoned(bufr1) || bufr2->poisoned(bufr2) )
+		goto done;
+
+	for (mode= 0; mode < 4; ++mode) {
+		start = now();
+		for (lp= 0; lp < iterations; ++lp) {
+			switch ( mode ) {
+				case 0:
+					result += memcmp(bufr1->get(bufr1), \
+							 bufr2->get(bufr2), \
+							 size);
+					break;
+				case 1:
+					result += bufr1->equal(bufr1, bufr2);
+					break;
+				case 2:
+					result += bufr1->equal_ct(bufr1, \
+								  bufr2);
+					break;
+				case 3:
+					result += bufr1->compare(bufr1, \
+								 bufr2, \
+								 &offset);
+					break;
+			}
+		}
+		times[mode] = now() - start;
+	}
+
+	fprintf(stdout, "%-10zu", size);
+	for (mode= 0; mode < 4; ++mode)
+		fprintf(stdout, " %10.2f", (double) size * iterations / \
+			times[mode]);
+	fputc('\n', stdout);
+	retn = true;
+
+
+ done:
+	WHACK(bufr1);
+	WHACK(bufr2);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the re-use of a buffer as scratch space,
+ * with the buffer filled in each pass and emptied by either the reset
+ * or the clear method between passes.
+ *
+ * \param size		The number of bytes added in each pass.
+ *
+ * \param iterations	The number of passes.
+ *
+ * \param fast		A flag used to indicate the clear method is
+ *			to be used.
+ *
+ * \return		The average number of nanoseconds per pass.  A
+ *			negative value indicates an allocation failure.
+ */
+
+static double reuse(size_t const size, unsigned long int const iterations, \
+		    _Bool const fast)
+
+{
+	unsigned long int lp;
+
+	unsigned char *bp;
+
+	double start;
+
+	Buffer bufr;
+
+
+	INIT(HurdLib, Buffer, bufr, return -1);
+	if ( !bufr->reserve(bufr, size) )
+		return -1;
+
+	start = now();
+	for (lp= 0; lp < iterations; ++lp) {
+		if ( (bp = bufr->extend(bufr, size)) == NULL )
+			return -1;
+		memset(bp, lp, size);
+		if ( fast )
+			bufr->clear(bufr);
+		else
+			bufr->reset(bufr);
+	}
+	start = (now() - start) / iterations;
+
+	WHACK(bufr);
+	return start;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned int lp,
+		     size;
+
+	unsigned long int iterations = ITERATIONS,
+			  buffers,
+			  passes;
+
+	double time,
+	       heap_time,
+	       allocs,
+	       heap_allocs;
+
+	struct HurdLib_Buffer_Stats stats;
+
+	static const struct {
+		const char *name;
+		size_t payload;
+		size_t append;
+	} sizes[] = {
+		{"small", SMALL_PAYLOAD, SMALL_APPEND},
+		{"large", LARGE_PAYLOAD, LARGE_APPEND}
+	};
+
+	static const struct {
+		const char *name;
+		enum Buffer_growth growth;
+		_Bool reserve;
+	} modes[] = {
+		{"fibonacci",	Buffer_growth_fibonacci,    false},
+		{"geometric 1.5", Buffer_growth_geometric_15, false},
+		{"geometric 2",	Buffer_growth_geometric_2,  false},
+		{"page",	Buffer_growth_page,	    false},
+		{"chunk 4096",	Buffer_growth_chunk,	    false},
+		{"reserved",	Buffer_growth_fibonacci,    true}
+	};
+
+
+	if ( argc > 1 )
+		iterations = strtoul(argv[1], NULL, 0);
+	if ( iterations == 0 ) {
+		fputs("Invalid iteration count.\n", stderr);
+		goto done;
+	}
+
+	fprintf(stdout, "small buffers: create, add and whack, %lu " \
+		"buffers\n", iterations * 100);
+	fprintf(stdout, "%-16s %10s %10s %10s %10s\n", "Payload", \
+		"inline ns", "allocs", "heap ns", "allocs");
+	for (size= 16; size <= SMALL_INLINE; size *= 2) {
+		time = small(iterations * 100, size, false, &allocs);
+		heap_time = small(iterations * 100, size, true, &heap_allocs);
+		if ( (time < 0) || (heap_time < 0) )
+			goto done;
+
+		fprintf(stdout, "%-16u %10.1f %10.2f %10.1f %10.2f\n", size, \
+			time, allocs, heap_time, heap_allocs);
+	}
+	fputc('\n', stdout);
+
+	for (size= 0; size < sizeof(sizes) / sizeof(sizes[0]); ++size) {
+		buffers = iterations * sizes[size].append * SMALL_PAYLOAD / \
+			(SMALL_APPEND * sizes[size].payload);
+		if ( buffers == 0 )
+			buffers = 1;
+
+		fprintf(stdout, "%s payload: %zu bytes in %zu byte appends, " \
+			"%lu buffers\n", sizes[size].name, \
+			sizes[size].payload, sizes[size].append, buffers);
+		fprintf(stdout, "%-16s %10s %10s %14s %10s\n", "Policy", \
+			"append ns", "reallocs", "bytes copied", "slack %");
+
+		for (lp= 0; lp < sizeof(modes) / sizeof(modes[0]); ++lp) {
+			time = fill(modes[lp].growth, modes[lp].reserve, \
+				    buffers, sizes[size].payload, \
+				    sizes[size].append, &stats);
+			if ( time < 0 )
+				goto done;
+
+			fprintf(stdout, "%-16s %10.1f %10lu %14zu %10.1f\n", \
+				modes[lp].name, time, stats.reallocs, \
+				stats.copied, 100.0 * (stats.capacity - \
+				sizes[size].payload) / sizes[size].payload);
+		}
+		fputc('\n', stdout);
+	}
+
+	fprintf(stdout, "hexadecimal conversion: %u bytes\n", HEX_BYTES);
+	if ( !hex(HEX_BYTES) ) {
+		fputs("Hexadecimal benchmark failed.\n", stderr);
+		goto done;
+	}
+
+	fprintf(stdout, "\nbase64 conversion: %u bytes\n", BASE64_BYTES);
+	if ( !base64(BASE64_BYTES) ) {
+		fputs("Base64 benchmark failed.\n", stderr);
+		goto done;
+	}
+
+	fputs("\nscratch buffer re-use: ns per pass\n", stdout);
+	fprintf(stdout, "%-10s %10s %10s %10s\n", "Size", "reset", \
+		"clear", "speedup");
+	for (size= 4096; size <= 4 * 1024 * 1024; size *= 16) {
+		time	  = reuse(size, iterations, false);
+		heap_time = reuse(size, iterations, true);
+		if ( (time < 0) || (heap_time < 0) )
+			goto done;
+		fprintf(stdout, "%-10u %10.1f %10.1f %9.1fx\n", size, time, \
+			heap_time, time / heap_time);
+	}
+
+	fputs("\nreceive queue, 1500 byte records: ns per record\n", stdout);
+	fprintf(stdout, "%-10s %10s %10s %10s\n", "Block", "copy", \
+		"consume", "speedup");
+	for (size= 4096; size <= 1024 * 1024; size *= 16) {
+		passes	  = iterations / 10 * 4096 / size + 1;
+		time	  = drain(size, 1500, passes, false);
+		heap_time = drain(size, 1500, passes, true);
+		if ( (time < 0) || (heap_time < 0) )
+			goto done;
+		fprintf(stdout, "%-10u %10.1f %10.1f %9.1fx\n", size, time, \
+			heap_time, time / heap_time);
+	}
+
+	fprintf(stdout, "\nrecord serialization: %u integers per " \
+		"record, ns per integer\n", SERIAL_INTEGERS);
+	if ( !serialize(SERIAL_INTEGERS, iterations / 10 + 1) ) {
+		fputs("Serialization benchmark failed.\n", stderr);
+		goto done;
+	}
+
+	fputs("\ncomparison of identical buffers: GB/s\n", stdout);
+	fprintf(stdout, "%-10s %10s %10s %10s %10s\n", "Size", "memcmp", \
+		"equal", "equal_ct", "compare");
+	for (size= 16; size <= 1024 * 1024; size *= 16) {
+		if ( !compare(size) ) {
+			fputs("Comparison benchmark failed.\n", stderr);
+			goto done;
+		}
+	}
+
+	rc = 0;
+
+
+ done:
+	return rc;
+}
@@ -0,0 +1,1673 @@
+/** \file
+ * This file contains a unit test for the Buffer object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "HurdLib.h"
+#include "Origin.h"
+#include "Buffer.h"
+#include "String.h"
+#include "Chain.h"
+#include "File.h"
+
+
+/* The number of threads which modify a shared buffer. */
+#define THREADS 4
+
+
+/**
+ * Private function.
+ *
+ * This function fills a buffer using the specified growth policy and
+ * verifies its contents.
+ *
+ * \param growth	The growth policy to be tested.
+ *
+ * \param stats		A pointer to the structure which will be
+ *			populated with the buffer statistics.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the buffer was filled correctly.
+ */
+
+static _Bool fill(enum Buffer_growth const growth, \
+		  struct HurdLib_Buffer_Stats * const stats)
+
+{
+	_Bool retn = false;
+
+	unsigned int lp;
+
+	unsigned char *bp;
+
+	Buffer bufr;
+
+
+	if ( (bufr = HurdLib_Buffer_Init_growth(growth, 1000)) == NULL )
+		return false;
+
+	for (lp= 0; lp < 10000; ++lp) {
+		if ( !bufr->add(bufr, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+
+	bp = bufr->get(bufr);
+	for (lp= 0; lp < 100000; ++lp) {
+		if ( bp[lp] != '0' + (lp % 10) )
+			goto done;
+	}
+
+	bufr->stats(bufr, stats);
+	fprintf(stdout, "growth=%d, capacity=%zu, reallocs=%lu, " \
+		"copied=%zu\n", growth, stats->capacity, stats->reallocs, \
+		stats->copied);
+	retn = stats->capacity >= 100000;
+
+
+ done:
+	WHACK(bufr);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies hexadecimal decoding and encoding over a
+ * range of lengths so that each of the vector and scalar paths are
+ * exercised, including the detection of an invalid character in
+ * each position.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		hexadecimal tests succeeded.
+ */
+
+static _Bool hex(void)
+
+{
+	static char const digits[] = "0123456789abcdef",
+			  upper[]  = "0123456789ABCDEF";
+
+	_Bool retn = false;
+
+	char hexbufr[2 * 200 + 1],
+	     encoded[2 * 200 + 1];
+
+	unsigned char *bp;
+
+	size_t lp,
+	       len;
+
+	Buffer bufr = NULL;
+
+
+	for (len= 1; len <= 200; ++len) {
+		for (lp= 0; lp < len; ++lp) {
+			hexbufr[2 * lp]	    = upper[(lp * 7 + len) % 16];
+			hexbufr[2 * lp + 1] = digits[(lp * 3) % 16];
+		}
+		hexbufr[2 * len] = '\0';
+
+		INIT(HurdLib, Buffer, bufr, goto done);
+		if ( !bufr->add_hexstring(bufr, hexbufr) )
+			goto done;
+
+		bp = bufr->get(bufr);
+		for (lp= 0; lp < len; ++lp) {
+			if ( bp[lp] != (((lp * 7 + len) % 16) << 4 | \
+					((lp * 3) % 16)) )
+				goto done;
+		}
+
+		if ( !bufr->encode_hex(bufr, encoded, sizeof(encoded)) )
+			goto done;
+		if ( strcasecmp(encoded, hexbufr) != 0 )
+			goto done;
+		if ( bufr->encode_hex(bufr, encoded, 2 * len) )
+			goto done;
+		WHACK(bufr);
+
+		/* Verify an invalid character is detected. */
+		for (lp= 0; lp < 2 * len; lp += 13) {
+			hexbufr[lp] ^= 0x40;
+			INIT(HurdLib, Buffer, bufr, goto done);
+			if ( bufr->add_hexstring(bufr, hexbufr) || \
+			     !bufr->poisoned(bufr) ) {
+				fprintf(stderr, "Invalid character at %zu " \
+					"of %zu not detected.\n", lp, len);
+				goto done;
+			}
+			WHACK(bufr);
+			hexbufr[lp] ^= 0x40;
+		}
+	}
+	retn = true;
+
+
+ done:
+	if ( !retn )
+		fprintf(stderr, "Hexadecimal failure at length %zu.\n", len);
+	WHACK(bufr);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies base64 conversion in both alphabets against
+ * a byte at a time reference encoding and verifies the detection of
+ * invalid characters and padding.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		base64 tests succeeded.
+ */
+
+static _Bool base64(void)
+
+{
+	static char const set[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ" \
+				  "abcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	static char const *vectors[][2] = {
+		{"f",	   "Zg=="},
+		{"fo",	   "Zm8="},
+		{"foo",	   "Zm9v"},
+		{"foob",   "Zm9vYg=="},
+		{"fooba",  "Zm9vYmE="},
+		{"foobar", "Zm9vYmFy"}
+	};
+
+	_Bool retn = false;
+
+	char text[4 * 70 + 1],
+	     encoded[4 * 70 + 1];
+
+	unsigned char bytes[200];
+
+	unsigned int bits;
+
+	size_t lp,
+	       len,
+	       cnt;
+
+	Buffer bufr = NULL;
+
+
+	/* Verify the test vectors of RFC 4648. */
+	len = 0;
+	for (lp= 0; lp < sizeof(vectors) / sizeof(vectors[0]); ++lp) {
+		INIT(HurdLib, Buffer, bufr, goto done);
+		if ( !bufr->add_base64(bufr, vectors[lp][1], \
+				       Buffer_base64_strict) )
+			goto done;
+		if ( (bufr->size(bufr) != strlen(vectors[lp][0])) || \
+		     (memcmp(bufr->get(bufr), vectors[lp][0], \
+			     bufr->size(bufr)) != 0) )
+			goto done;
+		if ( !bufr->encode_base64(bufr, encoded, sizeof(encoded), \
+					  Buffer_base64_standard) )
+			goto done;
+		if ( strcmp(encoded, vectors[lp][1]) != 0 )
+			goto done;
+		WHACK(bufr);
+	}
+
+	for (len= 0; len <= 200; ++len) {
+		for (lp= 0; lp < len; ++lp)
+			bytes[lp] = (lp * 37 + len) & 0xff;
+
+		/* Generate the reference encoding. */
+		for (lp= 0, cnt= 0; lp < len; lp += 3) {
+			bits = bytes[lp] << 16;
+			if ( lp + 1 < len )
+				bits |= bytes[lp + 1] << 8;
+			if ( lp + 2 < len )
+				bits |= bytes[lp + 2];
+			text[cnt++] = set[bits >> 18];
+			text[cnt++] = set[(bits >> 12) & 0x3f];
+			text[cnt++] = (lp + 1 < len) ? \
+				set[(bits >> 6) & 0x3f] : '=';
+			text[cnt++] = (lp + 2 < len) ? set[bits & 0x3f] : '=';
+		}
+		text[cnt] = '\0';
+
+		INIT(HurdLib, Buffer, bufr, goto done);
+		if ( !bufr->add(bufr, bytes, len) )
+			goto done;
+		if ( !bufr->encode_base64(bufr, encoded, sizeof(encoded), \
+					  Buffer_base64_standard) )
+			goto done;
+		if ( strcmp(encoded, text) != 0 )
+			goto done;
+		if ( bufr->encode_base64(bufr, encoded, cnt, \
+					 Buffer_base64_standard) )
+			goto done;
+
+		bufr->reset(bufr);
+		if ( !bufr->add_base64(bufr, text, Buffer_base64_strict) )
+			goto done;
+		if ( (bufr->size(bufr) != len) || \
+		     (memcmp(bufr->get(bufr), bytes, len) != 0) )
+			goto done;
+
+		/* Verify the unpadded URL alphabet. */
+		if ( !bufr->encode_base64(bufr, encoded, sizeof(encoded), \
+					  Buffer_base64_url) )
+			goto done;
+		for (lp= 0; text[lp] != '\0'; ++lp) {
+			if ( text[lp] == '+' )
+				text[lp] = '-';
+			if ( text[lp] == '/' )
+				text[lp] = '_';
+		}
+		if ( (strncmp(encoded, text, strlen(encoded)) != 0) || \
+		     (strspn(text + strlen(encoded), "=") != \
+		      strlen(text + strlen(encoded))) )
+			goto done;
+
+		bufr->reset(bufr);
+		if ( !bufr->add_base64(bufr, encoded, Buffer_base64_url | \
+				       Buffer_base64_strict) )
+			goto done;
+		if ( (bufr->size(bufr) != len) || \
+		     (memcmp(bufr->get(bufr), bytes, len) != 0) )
+			goto done;
+
+		/* Padding is only accepted by the lenient URL decoder. */
+		bufr->reset(bufr);
+		if ( !bufr->add_base64(bufr, text, Buffer_base64_url) )
+			goto done;
+		if ( (bufr->size(bufr) != len) || \
+		     (memcmp(bufr->get(bufr), bytes, len) != 0) )
+			goto done;
+		WHACK(bufr);
+		if ( (len % 3) != 0 ) {
+			INIT(HurdLib, Buffer, bufr, goto done);
+			if ( bufr->add_base64(bufr, text, Buffer_base64_url | \
+					      Buffer_base64_strict) )
+				goto done;
+			WHACK(bufr);
+		}
+
+		/* Verify an invalid character is detected. */
+		for (lp= 0; lp < strlen(encoded); lp += 7) {
+			encoded[lp] ^= 0x80;
+			INIT(HurdLib, Buffer, bufr, goto done);
+			if ( bufr->add_base64(bufr, encoded, \
+					      Buffer_base64_url) || \
+			     !bufr->poisoned(bufr) ) {
+				fprintf(stderr, "Invalid character at %zu " \
+					"of %zu not detected.\n", lp, len);
+				goto done;
+			}
+			WHACK(bufr);
+			encoded[lp] ^= 0x80;
+		}
+
+		/* The alphabets are not interchangeable. */
+		if ( strpbrk(encoded, "-_") != NULL ) {
+			INIT(HurdLib, Buffer, bufr, goto done);
+			if ( bufr->add_base64(bufr, encoded, \
+					      Buffer_base64_standard) )
+				goto done;
+			WHACK(bufr);
+		}
+	}
+
+	/* Verify the validation of the length and trailing bits. */
+	len = 0;
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( !bufr->add_base64(bufr, "Zh==", Buffer_base64_standard) )
+		goto done;
+	if ( !bufr->add_base64(bufr, "Zm9vYg", Buffer_base64_standard) )
+		goto done;
+	if ( (bufr->size(bufr) != 5) || \
+	     (memcmp(bufr->get(bufr), "ffoob", 5) != 0) )
+		goto done;
+	WHACK(bufr);
+
+	for (lp= 0; lp < 6; ++lp) {
+		static char const *invalid[] = {
+			"Zh==", "Zm9vYg", "Zm9vY", "Zm9vY===", "Zg=", "Zg=A"
+		};
+
+		INIT(HurdLib, Buffer, bufr, goto done);
+		if ( bufr->add_base64(bufr, invalid[lp], \
+				      Buffer_base64_strict) ) {
+			fprintf(stderr, "Invalid encoding %s accepted.\n", \
+				invalid[lp]);
+			goto done;
+		}
+		WHACK(bufr);
+	}
+	retn = true;
+
+
+ done:
+	if ( !retn )
+		fprintf(stderr, "Base64 failure at length %zu.\n", len);
+	WHACK(bufr);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies the use of a buffer as a first-in first-out
+ * queue.  Bytes are streamed through the buffer in uneven pieces and
+ * the capacity of the buffer must remain bounded.  Consuming from
+ * views, shared buffers and secure buffers is also verified.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		queue tests succeeded.
+ */
+
+static _Bool queue(void)
+
+{
+	_Bool retn = false;
+
+	unsigned char *bp,
+		      piece[100],
+		      out[100];
+
+	unsigned int lp,
+		     cnt,
+		     posn;
+
+	size_t added    = 0,
+	       consumed = 0;
+
+	struct HurdLib_Buffer_Stats stats;
+
+	Buffer bufr   = NULL,
+	       shared = NULL,
+	       view   = NULL;
+
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	for (lp= 0; lp < 10000; ++lp) {
+		cnt = 1 + (lp * 7) % 100;
+		for (posn= 0; posn < cnt; ++posn)
+			piece[posn] = (added + posn) % 251;
+		if ( !bufr->add(bufr, piece, cnt) )
+			goto done;
+		added += cnt;
+
+		cnt = 1 + (lp * 11) % 100;
+		if ( cnt > bufr->size(bufr) )
+			cnt = bufr->size(bufr);
+		if ( !bufr->peek(bufr, piece, cnt) )
+			goto done;
+		if ( !bufr->consume(bufr, out, cnt) )
+			goto done;
+		if ( memcmp(piece, out, cnt) != 0 )
+			goto done;
+		for (posn= 0; posn < cnt; ++posn) {
+			if ( out[posn] != (consumed + posn) % 251 ) {
+				fprintf(stderr, "Queue out of order at %zu.\n", \
+					consumed + posn);
+				goto done;
+			}
+		}
+		consumed += cnt;
+	}
+
+	bufr->stats(bufr, &stats);
+	fprintf(stdout, "Queued: %zu, held: %zu, capacity: %zu, " \
+		"reallocs: %lu\n", added, bufr->size(bufr), stats.capacity, \
+		stats.reallocs);
+	if ( bufr->size(bufr) != added - consumed )
+		goto done;
+	if ( stats.capacity > 8192 ) {
+		fputs("Queue capacity is not bounded.\n", stderr);
+		goto done;
+	}
+
+	/* An over-sized request fails and draining empties the queue. */
+	if ( bufr->consume(bufr, NULL, bufr->size(bufr) + 1) || \
+	     bufr->peek(bufr, out, bufr->size(bufr) + 1) )
+		goto done;
+	if ( !bufr->consume(bufr, NULL, bufr->size(bufr)) )
+		goto done;
+	if ( (bufr->size(bufr) != 0) || bufr->poisoned(bufr) )
+		goto done;
+	if ( !bufr->add(bufr, (unsigned char *) "ABC", 3) )
+		goto done;
+	if ( memcmp(bufr->get(bufr), "ABC", 3) != 0 )
+		goto done;
+
+	/* A view narrows as it is consumed. */
+	INIT(HurdLib, Buffer, view, goto done);
+	if ( !view->view(view, bufr, 0, 3) )
+		goto done;
+	if ( !view->consume(view, out, 2) || (memcmp(out, "AB", 2) != 0) )
+		goto done;
+	if ( (view->size(view) != 1) || (*view->get(view) != 'C') || \
+	     (bufr->size(bufr) != 3) )
+		goto done;
+	WHACK(view);
+
+	/* Consuming a shared buffer leaves the other buffer intact. */
+	if ( !bufr->add(bufr, piece, sizeof(piece)) )
+		goto done;
+	INIT(HurdLib, Buffer, shared, goto done);
+	if ( !shared->share(shared, bufr) )
+		goto done;
+	if ( !shared->consume(shared, NULL, 3) )
+		goto done;
+	if ( !shared->add(shared, (unsigned char *) "D", 1) )
+		goto done;
+	if ( (shared->size(shared) != sizeof(piece) + 1) || \
+	     (memcmp(shared->get(shared), piece, sizeof(piece)) != 0) || \
+	     (shared->get(shared)[sizeof(piece)] != 'D') )
+		goto done;
+	if ( (bufr->size(bufr) != sizeof(piece) + 3) || \
+	     (memcmp(bufr->get(bufr), "ABC", 3) != 0) )
+		goto done;
+	WHACK(shared);
+	WHACK(bufr);
+
+	/* A secure buffer wipes the bytes which are consumed. */
+	if ( (bufr = HurdLib_Buffer_Init_secure()) == NULL )
+		goto done;
+	if ( !bufr->add(bufr, (unsigned char *) "secretvalue", 11) )
+		goto done;
+	bp = bufr->get(bufr);
+	if ( !bufr->consume(bufr, NULL, 6) )
+		goto done;
+	if ( (memcmp(bp, "\0\0\0\0\0\0", 6) != 0) || \
+	     (memcmp(bufr->get(bufr), "value", 5) != 0) ) {
+		fputs("Consumed secure bytes not wiped.\n", stderr);
+		goto done;
+	}
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(shared);
+	WHACK(view);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies the serialization of fixed width integers
+ * and LEB128 encoded integers.  The encodings are compared with known
+ * values and arrays of integers are converted in both byte orders and
+ * read back with a cursor.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		integer tests succeeded.
+ */
+
+static _Bool integers(void)
+
+{
+	_Bool retn = false;
+
+	unsigned int lp,
+		     width,
+		     order;
+
+	size_t posn,
+	       cnt;
+
+	uint64_t value,
+		 values[1000],
+		 decoded[1000];
+
+	uint8_t in8[1000],
+		out8[1000];
+
+	uint16_t in16[1000],
+		 out16[1000];
+
+	uint32_t in32[1000],
+		 out32[1000];
+
+	uint64_t in64[1000],
+		 out64[1000];
+
+	void *in[]  = {in8, in16, NULL, in32, NULL, NULL, NULL, in64},
+	     *out[] = {out8, out16, NULL, out32, NULL, NULL, NULL, out64};
+
+	Buffer bufr   = NULL,
+	       expect = NULL,
+	       view   = NULL;
+
+	static const unsigned char fixed[] = {
+		0x12, 0x12, 0x12, 0x34, 0x34, 0x12,
+		0x12, 0x34, 0x56, 0x78, 0x78, 0x56, 0x34, 0x12,
+		0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+		0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01
+	};
+
+	static const unsigned char varints[] = {
+		0x00, 0x7f, 0x80, 0x01, 0xac, 0x02,
+		0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01
+	};
+
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Buffer, expect, goto done);
+
+	/* Verify the encoding of single integers. */
+	if ( !bufr->add_int(bufr, 0x12, 1, Buffer_endian_big) || \
+	     !bufr->add_int(bufr, 0x12, 1, Buffer_endian_little) || \
+	     !bufr->add_int(bufr, 0x1234, 2, Buffer_endian_big) || \
+	     !bufr->add_int(bufr, 0x1234, 2, Buffer_endian_little) || \
+	     !bufr->add_int(bufr, 0x12345678, 4, Buffer_endian_big) || \
+	     !bufr->add_int(bufr, 0x12345678, 4, Buffer_endian_little) || \
+	     !bufr->add_int(bufr, 0x0123456789abcdefULL, 8, \
+			    Buffer_endian_big) || \
+	     !bufr->add_int(bufr, 0x0123456789abcdefULL, 8, \
+			    Buffer_endian_little) )
+		goto done;
+	if ( (bufr->size(bufr) != sizeof(fixed)) || \
+	     (memcmp(bufr->get(bufr), fixed, sizeof(fixed)) != 0) ) {
+		fputs("Incorrect fixed width encoding.\n", stderr);
+		goto done;
+	}
+	if ( bufr->add_int(bufr, 0x100, 1, Buffer_endian_big) || \
+	     bufr->add_int(bufr, 1, 3, Buffer_endian_big) || \
+	     bufr->add_int(bufr, 1, 4, Buffer_endian_little + 1) || \
+	     (bufr->size(bufr) != sizeof(fixed)) )
+		goto done;
+
+	posn = 0;
+	if ( !bufr->get_int(bufr, &posn, &value, 1, Buffer_endian_big) || \
+	     (value != 0x12) )
+		goto done;
+	posn = 2;
+	if ( !bufr->get_int(bufr, &posn, &value, 2, Buffer_endian_big) || \
+	     (value != 0x1234) )
+		goto done;
+	if ( !bufr->get_int(bufr, &posn, &value, 2, Buffer_endian_little) || \
+	     (value != 0x1234) )
+		goto done;
+	posn = 10;
+	if ( !bufr->get_int(bufr, &posn, &value, 4, Buffer_endian_little) || \
+	     (value != 0x12345678) )
+		goto done;
+	if ( !bufr->get_int(bufr, &posn, &value, 8, Buffer_endian_big) || \
+	     (value != 0x0123456789abcdefULL) )
+		goto done;
+	if ( !bufr->get_int(bufr, &posn, &value, 8, Buffer_endian_little) || \
+	     (value != 0x0123456789abcdefULL) || (posn != sizeof(fixed)) )
+		goto done;
+	posn = sizeof(fixed) - 3;
+	if ( bufr->get_int(bufr, &posn, &value, 4, Buffer_endian_big) || \
+	     (posn != sizeof(fixed) - 3) )
+		goto done;
+	posn = sizeof(fixed) + 1;
+	if ( bufr->get_int(bufr, &posn, &value, 1, Buffer_endian_big) )
+		goto done;
+
+	/* Verify arrays against the encoding of single integers. */
+	for (lp= 0; lp < 1000; ++lp) {
+		value	  = lp * 0x9e3779b97f4a7c15ULL;
+		in8[lp]	  = value >> 56;
+		in16[lp]  = value >> 48;
+		in32[lp]  = value >> 32;
+		in64[lp]  = value;
+	}
+
+	for (width= 1; width <= 8; width *= 2) {
+		for (order= Buffer_endian_big; order <= Buffer_endian_little; \
+			     ++order) {
+			bufr->reset(bufr);
+			expect->reset(expect);
+			cnt = (width * 37 + order * 11) % 1000 + 1;
+
+			if ( !bufr->add_int(bufr, 7, 1, order) )
+				goto done;
+			if ( !bufr->add_ints(bufr, in[width - 1], cnt, width, \
+					     order) )
+				goto done;
+			if ( !expect->add_int(expect, 7, 1, order) )
+				goto done;
+			for (lp= 0; lp < cnt; ++lp) {
+				if ( width == 1 )
+					value = in8[lp];
+				if ( width == 2 )
+					value = in16[lp];
+				if ( width == 4 )
+					value = in32[lp];
+				if ( width == 8 )
+					value = in64[lp];
+				if ( !expect->add_int(expect, value, width, \
+						      order) )
+					goto done;
+			}
+			if ( !bufr->equal(bufr, expect) ) {
+				fprintf(stderr, "Incorrect array encoding, " \
+					"width %u, order %u.\n", width, order);
+				goto done;
+			}
+
+			posn = 1;
+			memset(out[width - 1], '\0', cnt * width);
+			if ( bufr->get_ints(bufr, &posn, out[width - 1], \
+					    cnt + 1, width, order) || \
+			     (posn != 1) )
+				goto done;
+			if ( !bufr->get_ints(bufr, &posn, out[width - 1], cnt, \
+					     width, order) )
+				goto done;
+			if ( (posn != bufr->size(bufr)) || \
+			     (memcmp(in[width - 1], out[width - 1], \
+				     cnt * width) != 0) ) {
+				fprintf(stderr, "Incorrect array decoding, " \
+					"width %u, order %u.\n", width, order);
+				goto done;
+			}
+		}
+	}
+
+	/* Verify LEB128 encodings. */
+	bufr->reset(bufr);
+	values[0] = 0;
+	values[1] = 127;
+	values[2] = 128;
+	values[3] = 300;
+	values[4] = UINT64_MAX;
+	for (lp= 0; lp < 5; ++lp) {
+		if ( !bufr->add_varint(bufr, values[lp]) )
+			goto done;
+	}
+	if ( (bufr->size(bufr) != sizeof(varints)) || \
+	     (memcmp(bufr->get(bufr), varints, sizeof(varints)) != 0) ) {
+		fputs("Incorrect varint encoding.\n", stderr);
+		goto done;
+	}
+	for (posn= 0, lp= 0; lp < 5; ++lp) {
+		if ( !bufr->get_varint(bufr, &posn, &value) || \
+		     (value != values[lp]) )
+			goto done;
+	}
+	if ( bufr->get_varint(bufr, &posn, &value) )
+		goto done;
+
+	/* Encodings which overflow or are truncated are rejected. */
+	bufr->reset(bufr);
+	if ( !bufr->add(bufr, varints + 6, 9) || \
+	     !bufr->add_int(bufr, 2, 1, Buffer_endian_big) )
+		goto done;
+	posn = 0;
+	if ( bufr->get_varint(bufr, &posn, &value) || (posn != 0) )
+		goto done;
+	bufr->shrink(bufr, 1);
+	if ( bufr->get_varint(bufr, &posn, &value) || (posn != 0) )
+		goto done;
+
+	/* Verify arrays of encodings, ending near the buffer end. */
+	bufr->reset(bufr);
+	expect->reset(expect);
+	for (lp= 0; lp < 1000; ++lp) {
+		values[lp] = (lp * 0x9e3779b97f4a7c15ULL) >> (lp % 64);
+		if ( !expect->add_varint(expect, values[lp]) )
+			goto done;
+	}
+	if ( !bufr->add_varints(bufr, values, 1000) )
+		goto done;
+	if ( !bufr->equal(bufr, expect) ) {
+		fputs("Incorrect varint array encoding.\n", stderr);
+		goto done;
+	}
+
+	INIT(HurdLib, Buffer, view, goto done);
+	if ( !view->view(view, bufr, 0, bufr->size(bufr) - 1) )
+		goto done;
+	posn = 0;
+	if ( view->get_varints(view, &posn, decoded, 1000) || (posn != 0) )
+		goto done;
+	if ( !view->get_varints(view, &posn, decoded, 999) )
+		goto done;
+	if ( !bufr->get_varints(bufr, &posn, decoded + 999, 1) || \
+	     (posn != bufr->size(bufr)) )
+		goto done;
+	if ( memcmp(values, decoded, sizeof(values)) != 0 ) {
+		fputs("Incorrect varint array decoding.\n", stderr);
+		goto done;
+	}
+	fprintf(stdout, "Varint array: %zu bytes\n", bufr->size(bufr));
+
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(expect);
+	WHACK(view);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies secure buffers.  The memory released by the
+ * growth of a secure buffer must be wiped and large buffers must be
+ * page aligned.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		secure buffer tests succeeded.
+ */
+
+static _Bool secure(void)
+
+{
+	_Bool retn = false;
+
+	unsigned char *bp,
+		      *old;
+
+	size_t lp,
+	       size;
+
+	Buffer bufr  = NULL,
+	       bufr2 = NULL;
+
+	struct HurdLib_Buffer_Stats stats;
+
+
+	if ( (bufr = HurdLib_Buffer_Init_secure()) == NULL )
+		goto done;
+	if ( !bufr->add(bufr, (unsigned char *) "secret key", 10) )
+		goto done;
+	bufr->stats(bufr, &stats);
+	if ( stats.capacity != 64 )
+		goto done;
+
+	/* Grow through each of the size classes. */
+	old  = bufr->get(bufr);
+	size = stats.capacity;
+	while ( bufr->size(bufr) < 100000 ) {
+		if ( !bufr->add(bufr, (unsigned char *) "0123456789", 10) )
+			goto done;
+		if ( (bp = bufr->get(bufr)) == old )
+			continue;
+
+		/* The released block holds only the free list link. */
+		for (lp= sizeof(void *); (size <= 32768) && (lp < size); ++lp) {
+			if ( old[lp] != '\0' ) {
+				fputs("Released memory not wiped.\n", stderr);
+				goto done;
+			}
+		}
+		bufr->stats(bufr, &stats);
+		old  = bp;
+		size = stats.capacity;
+	}
+	if ( (uintptr_t) bufr->get(bufr) % sysconf(_SC_PAGESIZE) != 0 )
+		goto done;
+	if ( memcmp(bufr->get(bufr), "secret key0123456789", 20) != 0 )
+		goto done;
+
+	/* Secure buffers cannot be converted or shared. */
+	if ( bufr->set_secure(bufr) )
+		goto done;
+	INIT(HurdLib, Buffer, bufr2, goto done);
+	if ( !bufr2->share(bufr2, bufr) )
+		goto done;
+	if ( (bufr2->get(bufr2) == bufr->get(bufr)) || \
+	     !bufr2->equal(bufr2, bufr) )
+		goto done;
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(bufr2);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies the comparison methods over a range of sizes
+ * with a difference placed at each position, so that the vector and
+ * scalar paths are each exercised.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		comparison tests succeeded.
+ */
+
+static _Bool comparisons(void)
+
+{
+	_Bool retn = false;
+
+	unsigned char *a = NULL,
+		      *b = NULL;
+
+	size_t size,
+	       posn,
+	       offset;
+
+	Buffer bufr1 = NULL,
+	       bufr2 = NULL;
+
+
+	for (size= 0; size <= 150; ++size) {
+		INIT(HurdLib, Buffer, bufr1, goto done);
+		INIT(HurdLib, Buffer, bufr2, goto done);
+		if ( size > 0 ) {
+			a = bufr1->extend(bufr1, size);
+			b = bufr2->extend(bufr2, size);
+			for (posn= 0; posn < size; ++posn)
+				a[posn] = b[posn] = posn * 37;
+		}
+
+		if ( !bufr1->equal_ct(bufr1, bufr2) || \
+		     !bufr1->compare(bufr1, bufr2, &offset) || \
+		     (offset != size) )
+			goto done;
+
+		for (posn= 0; posn < size; ++posn) {
+			b[posn] ^= 0x80;
+			if ( bufr1->equal(bufr1, bufr2) || \
+			     bufr1->equal_ct(bufr1, bufr2) )
+				goto done;
+			if ( bufr1->compare(bufr1, bufr2, &offset) || \
+			     (offset != posn) ) {
+				fprintf(stderr, "Mismatch at %zu of %zu " \
+					"reported at %zu.\n", posn, size, \
+					offset);
+				goto done;
+			}
+			b[posn] ^= 0x80;
+		}
+
+		/* A prefix differs at the end of the shorter buffer. */
+		if ( !bufr2->add(bufr2, (unsigned char *) "X", 1) )
+			goto done;
+		if ( bufr1->equal_ct(bufr1, bufr2) || \
+		     bufr2->compare(bufr2, bufr1, &offset) || \
+		     (offset != size) )
+			goto done;
+
+		WHACK(bufr1);
+		WHACK(bufr2);
+	}
+	retn = true;
+
+
+ done:
+	if ( !retn )
+		fprintf(stderr, "Comparison failed at size %zu.\n", size);
+	WHACK(bufr1);
+	WHACK(bufr2);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function is run by a thread which modifies and releases its
+ * handle on a shared buffer.
+ *
+ * \param arg	A pointer to the Buffer object which the thread is to
+ *		modify.
+ *
+ * \return	A non-NULL value if the contents were incorrect.
+ */
+
+static void *modify(void *arg)
+
+{
+	Buffer bufr = arg;
+
+	unsigned char *bp;
+
+
+	if ( !bufr->add(bufr, (unsigned char *) "X", 1) )
+		return arg;
+	bp = bufr->get(bufr);
+	if ( (bp[0] != 0xaa) || (bp[bufr->size(bufr) - 1] != 'X') )
+		return arg;
+
+	WHACK(bufr);
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies copy-on-write sharing of a buffer between
+ * objects and threads.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		sharing tests succeeded.
+ */
+
+static _Bool sharing(void)
+
+{
+	_Bool retn = false;
+
+	unsigned int lp;
+
+	long int held;
+
+	void *result;
+
+	Origin root = HurdLib_Origin_Init();
+
+	Buffer bufr    = NULL,
+	       copy    = NULL,
+	       cleared = NULL,
+	       copies[THREADS];
+
+	pthread_t threads[THREADS];
+
+	struct HurdLib_Origin_Object_Stats stats;
+
+
+	memset(copies, '\0', sizeof(copies));
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( !bufr->reserve(bufr, 100000) )
+		goto done;
+	memset(bufr->extend(bufr, 100000), 0xaa, 100000);
+
+	/* An added buffer is a copy which may be written directly. */
+	INIT(HurdLib, Buffer, copy, goto done);
+	if ( !copy->add_Buffer(copy, bufr) )
+		goto done;
+	if ( copy->get(copy) == bufr->get(bufr) )
+		goto done;
+	copy->get(copy)[0] = 'X';
+	if ( (bufr->get(bufr)[0] != 0xaa) || (copy->get(copy)[0] != 'X') ) {
+		fputs("Added buffer modified its source.\n", stderr);
+		goto done;
+	}
+	WHACK(copy);
+
+	/* A cleared buffer which is shared and then copied is reset. */
+	INIT(HurdLib, Buffer, cleared, goto done);
+	INIT(HurdLib, Buffer, copy, goto done);
+	if ( !cleared->add(cleared, bufr->get(bufr), 1000) )
+		goto done;
+	cleared->clear(cleared);
+	if ( !cleared->add(cleared, bufr->get(bufr), 10) )
+		goto done;
+	if ( !copy->share(copy, cleared) )
+		goto done;
+	if ( !cleared->add(cleared, (unsigned char *) "Z", 1) )
+		goto done;
+	cleared->reset(cleared);
+	if ( (copy->size(copy) != 10) || (copy->get(copy)[9] != 0xaa) )
+		goto done;
+	WHACK(cleared);
+	WHACK(copy);
+
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &stats) )
+		goto done;
+	held = stats.bytes;
+
+	/* Shared buffers refer to the same memory. */
+	for (lp= 0; lp < THREADS; ++lp) {
+		INIT(HurdLib, Buffer, copies[lp], goto done);
+		if ( !copies[lp]->share(copies[lp], bufr) )
+			goto done;
+		if ( copies[lp]->get(copies[lp]) != bufr->get(bufr) )
+			goto done;
+	}
+	if ( !root->object_stats(root, HurdLib_LIBID, \
+				 HurdLib_Buffer_OBJID, &stats) )
+		goto done;
+	if ( stats.bytes != held ) {
+		fputs("Shared buffers were copied.\n", stderr);
+		goto done;
+	}
+
+	/* A modified buffer receives a copy. */
+	if ( !bufr->add(bufr, (unsigned char *) "Y", 1) )
+		goto done;
+	if ( (bufr->get(bufr) == copies[0]->get(copies[0])) || \
+	     (copies[0]->size(copies[0]) != 100000) )
+		goto done;
+
+	/* The remaining handles are modified concurrently. */
+	for (lp= 0; lp < THREADS; ++lp) {
+		if ( pthread_create(&threads[lp], NULL, modify, \
+				    copies[lp]) != 0 )
+			goto done;
+	}
+	for (lp= 0; lp < THREADS; ++lp) {
+		pthread_join(threads[lp], &result);
+		if ( result != NULL )
+			goto done;
+		copies[lp] = NULL;
+	}
+
+	WHACK(bufr);
+	if ( !root->object_stats(root, HurdLib_LIBID, \
+				 HurdLib_Buffer_OBJID, &stats) )
+		goto done;
+	if ( stats.bytes != held - (long int) 100000 ) {
+		fprintf(stderr, "Shared memory not released: %ld\n", \
+			stats.bytes);
+		goto done;
+	}
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(copy);
+	WHACK(cleared);
+	for (lp= 0; lp < THREADS; ++lp)
+		WHACK(copies[lp]);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies read-only views of a buffer.  The views
+ * must track re-allocation and consumption of their parent, keep the
+ * parent alive after it is destroyed and refuse modification.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		view tests succeeded.
+ */
+
+static _Bool views(void)
+
+{
+	_Bool retn = false;
+
+	Origin root = HurdLib_Origin_Init();
+
+	Buffer bufr   = NULL,
+	       field  = NULL,
+	       field2 = NULL,
+	       cmp    = NULL;
+
+	File file = NULL;
+
+	struct HurdLib_Origin_Object_Stats stats;
+
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Buffer, field, goto done);
+	INIT(HurdLib, Buffer, field2, goto done);
+	INIT(HurdLib, Buffer, cmp, goto done);
+
+	if ( !bufr->add(bufr, (unsigned char *) "key=value;", 10) )
+		goto done;
+	if ( !field->view(field, bufr, 4, 5) )
+		goto done;
+	if ( field->get(field) != bufr->get(bufr) + 4 )
+		goto done;
+	if ( !cmp->add(cmp, (unsigned char *) "value", 5) )
+		goto done;
+	if ( !field->equal(field, cmp) || !cmp->equal(cmp, field) )
+		goto done;
+
+	/* A view of a view refers to the original buffer. */
+	if ( !field2->view(field2, field, 1, 3) )
+		goto done;
+	if ( field2->get(field2) != bufr->get(bufr) + 5 )
+		goto done;
+
+	/* The views must follow re-allocation of the parent. */
+	while ( bufr->size(bufr) < 10000 ) {
+		if ( !bufr->add(bufr, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+	if ( !field->equal(field, cmp) )
+		goto done;
+
+	/* The parent is retained while views exist. */
+	WHACK(bufr);
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &stats) )
+		goto done;
+	if ( (stats.live < 4) || (stats.bytes < 10000) )
+		goto done;
+	if ( !field->equal(field, cmp) )
+		goto done;
+	WHACK(field);
+	if ( memcmp(field2->get(field2), "alu", 3) != 0 )
+		goto done;
+
+	/* A view cannot be added to or re-viewed. */
+	if ( field2->add(field2, (unsigned char *) "X", 1) || \
+	     !field2->poisoned(field2) )
+		goto done;
+	WHACK(field2);
+
+	cmp->reset(cmp);
+	INIT(HurdLib, Buffer, field, goto done);
+	if ( field->view(field, cmp, 0, 1) || !field->poisoned(field) )
+		goto done;
+	WHACK(field);
+	INIT(HurdLib, Buffer, field, goto done);
+	if ( !cmp->add(cmp, (unsigned char *) "abc", 3) )
+		goto done;
+	if ( !field->view(field, cmp, 1, 2) )
+		goto done;
+
+	/* A view whose parent no longer covers it is poisoned. */
+	cmp->shrink(cmp, 1);
+	if ( (field->size(field) != 0) || !field->poisoned(field) )
+		goto done;
+	WHACK(field);
+
+	/* A view follows its bytes when its parent is consumed from. */
+	cmp->reset(cmp);
+	INIT(HurdLib, Buffer, field, goto done);
+	INIT(HurdLib, Buffer, field2, goto done);
+	if ( !cmp->add(cmp, (unsigned char *) "abcdefgh", 8) )
+		goto done;
+	if ( !field->view(field, cmp, 2, 2) )
+		goto done;
+	if ( !cmp->consume(cmp, NULL, 2) )
+		goto done;
+	if ( (field->size(field) != 2) || \
+	     (memcmp(field->get(field), "cd", 2) != 0) )
+		goto done;
+	if ( !field2->view(field2, field, 1, 1) || \
+	     (field2->get(field2)[0] != 'd') )
+		goto done;
+
+	while ( cmp->size(cmp) < 10000 ) {
+		if ( !cmp->add(cmp, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+	if ( (memcmp(field->get(field), "cd", 2) != 0) || \
+	     (field2->get(field2)[0] != 'd') )
+		goto done;
+
+	/* Consuming the bytes of a view poisons it. */
+	if ( !cmp->consume(cmp, NULL, 1) )
+		goto done;
+	if ( (field->size(field) != 0) || !field->poisoned(field) )
+		goto done;
+	if ( (field2->get(field2)[0] != 'd') || field2->poisoned(field2) )
+		goto done;
+	WHACK(field);
+	WHACK(field2);
+
+	/* A view of discarded contents is not revived by new contents. */
+	INIT(HurdLib, Buffer, field, goto done);
+	if ( !field->view(field, cmp, 0, 2) )
+		goto done;
+	cmp->reset(cmp);
+	if ( !cmp->add(cmp, (unsigned char *) "xyz", 3) )
+		goto done;
+	if ( (field->size(field) != 0) || !field->poisoned(field) )
+		goto done;
+	WHACK(field);
+
+	/* A stale view is rejected by the objects it is given to. */
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Buffer, field, goto done);
+	INIT(HurdLib, Buffer, field2, goto done);
+	INIT(HurdLib, File, file, goto done);
+	if ( !field->view(field, cmp, 1, 2) || \
+	     !field2->view(field2, cmp, 0, 3) )
+		goto done;
+	cmp->reset(cmp);
+	if ( bufr->equal(bufr, field) || !bufr->poisoned(bufr) )
+		goto done;
+	if ( !file->open_wo(file, "/dev/null") )
+		goto done;
+	if ( file->write_Buffer(file, field2) || !file->poisoned(file) )
+		goto done;
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(field);
+	WHACK(field2);
+	WHACK(cmp);
+	WHACK(file);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies buffers in the compact representation, which
+ * refer to the shared method table rather than holding the methods.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		compact buffer tests succeeded.
+ */
+
+static _Bool compact(void)
+
+{
+	_Bool retn = false;
+
+	Origin root = HurdLib_Origin_Init();
+
+	Buffer bufr = NULL;
+
+	Buffer_Compact cbufr = NULL,
+		       cview = NULL;
+
+	struct HurdLib_Origin_Object_Stats stats;
+
+	long int live;
+
+
+	if ( sizeof(struct HurdLib_Buffer_Compact) != 2 * sizeof(void *) )
+		goto done;
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &stats) )
+		goto done;
+	live = stats.live;
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	CINIT(HurdLib, Buffer, cbufr, goto done);
+	while ( CALL(cbufr, size) < 1000 ) {
+		if ( !CALL(cbufr, add, (unsigned char *) "compact", 7) )
+			goto done;
+	}
+	if ( !CALL(cbufr, consume, NULL, 3) || (CALL(cbufr, size) != 998) || \
+	     (memcmp(CALL(cbufr, get), "pactcom", 7) != 0) )
+		goto done;
+	if ( !bufr->add(bufr, CALL(cbufr, get), CALL(cbufr, size)) )
+		goto done;
+
+	/* A compact view of a full buffer. */
+	CINIT(HurdLib, Buffer, cview, goto done);
+	if ( !CALL(cview, view, bufr, 4, 7) || \
+	     (memcmp(CALL(cview, get), "compact", 7) != 0) )
+		goto done;
+	if ( CALL(cview, add, (unsigned char *) "X", 1) || \
+	     !CALL(cview, poisoned) )
+		goto done;
+
+	CWHACK(cbufr);
+	CWHACK(cview);
+	WHACK(bufr);
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &stats) )
+		goto done;
+	if ( stats.live != live )
+		goto done;
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+	CWHACK(cbufr);
+	CWHACK(cview);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies a buffer whose capacity exceeds 32 bits.  By
+ * default the capacity is reserved but only touched at its start so
+ * the memory remains sparse.  If requested the buffer is filled
+ * beyond 4 GiB, which requires that amount of physical memory.
+ *
+ * \param fill	A flag used to indicate the buffer is to be filled.
+ *
+ * \return	A boolean value is used to indicate whether or not
+ *		the large buffer tests succeeded.
+ */
+
+static _Bool large(_Bool const fill)
+
+{
+	_Bool retn = false;
+
+	size_t lp,
+	       target = (size_t) UINT32_MAX + 1 + 16;
+
+	unsigned char *bp;
+
+	static unsigned char data[1024 * 1024];
+
+	Buffer bufr = NULL;
+
+	struct HurdLib_Buffer_Stats stats;
+
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+
+	if ( fill ) {
+		fputs("Filling buffer beyond 4 GiB.\n", stdout);
+		for (lp= 0; lp < target; lp += sizeof(data)) {
+			data[0] = lp / sizeof(data);
+			if ( !bufr->add(bufr, data, sizeof(data)) )
+				goto done;
+		}
+		bp = bufr->get(bufr);
+		if ( (bufr->size(bufr) != lp) || \
+		     (bp[lp - sizeof(data)] != (unsigned char) \
+		      (lp / sizeof(data) - 1)) ) {
+			fputs("Incorrect large buffer contents.\n", stderr);
+			goto done;
+		}
+	}
+	else {
+		fputs("Reserving buffer beyond 4 GiB.\n", stdout);
+		if ( !bufr->reserve(bufr, target) )
+			goto done;
+		if ( !bufr->add(bufr, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+
+	bufr->stats(bufr, &stats);
+	fprintf(stdout, "Capacity: %zu, size: %zu\n", stats.capacity, \
+		bufr->size(bufr));
+	if ( stats.capacity < target ) {
+		fputs("Large capacity not allocated.\n", stderr);
+		goto done;
+	}
+
+	/* Verify an addition which would overflow is refused. */
+	if ( bufr->add(bufr, data, SIZE_MAX) || bufr->poisoned(bufr) ) {
+		fputs("Overflowing addition not refused.\n", stderr);
+		goto done;
+	}
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+
+	return retn;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned int lp;
+
+	unsigned char *bp;
+
+	long int held;
+
+	Origin root = HurdLib_Origin_Init();
+
+	Buffer bufr  = NULL,
+	       bufr2 = NULL;
+
+	struct HurdLib_Origin_Object_Stats stats;
+
+	struct HurdLib_Buffer_Stats growth;
+
+
+	/* The -L argument fills a buffer beyond 4 GiB. */
+	if ( (argc > 1) && (strcmp(argv[1], "-L") == 0) ) {
+		if ( large(true) )
+			rc = 0;
+		goto done;
+	}
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Buffer, bufr2, goto done);
+
+	/* Verify incremental addition. */
+	fputs("Adding bytes incrementally.\n", stdout);
+	for (lp= 0; lp < 1000; ++lp) {
+		if ( !bufr->add(bufr, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+	if ( bufr->size(bufr) != 10000 ) {
+		fputs("Incorrect buffer size.\n", stderr);
+		goto done;
+	}
+	bp = bufr->get(bufr);
+	for (lp= 0; lp < 10000; ++lp) {
+		if ( bp[lp] != '0' + (lp % 10) ) {
+			fprintf(stderr, "Incorrect contents at %u.\n", lp);
+			goto done;
+		}
+	}
+
+	/* Verify a reserved buffer is not re-allocated. */
+	fputs("\nAdding bytes to a reserved buffer.\n", stdout);
+	if ( !bufr2->reserve(bufr2, 10000) )
+		goto done;
+	bp = bufr2->get(bufr2);
+	for (lp= 0; lp < 1000; ++lp) {
+		if ( !bufr2->add(bufr2, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+	if ( bufr2->get(bufr2) != bp ) {
+		fputs("Reserved buffer was re-allocated.\n", stderr);
+		goto done;
+	}
+	if ( !bufr->equal(bufr, bufr2) ) {
+		fputs("Reserved buffer contents differ.\n", stderr);
+		goto done;
+	}
+
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &stats) )
+		goto done;
+	fprintf(stdout, "Buffer bytes held: %ld\n", stats.bytes);
+	if ( stats.bytes < 20000 ) {
+		fputs("Buffer capacity not accounted.\n", stderr);
+		goto done;
+	}
+
+	/* Verify growth beyond the reserved capacity. */
+	fputs("\nGrowing beyond the reservation.\n", stdout);
+	if ( !bufr2->add(bufr2, (unsigned char *) "X", 1) )
+		goto done;
+	if ( (bufr2->size(bufr2) != 10001) || \
+	     (bufr2->get(bufr2)[10000] != 'X') ) {
+		fputs("Growth beyond reservation failed.\n", stderr);
+		goto done;
+	}
+
+	/* Verify a reset buffer retains its allocation. */
+	fputs("\nAdding hexadecimal string to reset buffer.\n", stdout);
+	bp = bufr2->get(bufr2);
+	bufr2->reset(bufr2);
+	if ( !bufr2->add_hexstring(bufr2, "000102feff") )
+		goto done;
+	if ( bufr2->get(bufr2) != bp ) {
+		fputs("Reset buffer was re-allocated.\n", stderr);
+		goto done;
+	}
+	bufr2->print(bufr2);
+	fputc('\n', stdout);
+	if ( (bufr2->size(bufr2) != 5) || (bp[3] != 0xfe) ) {
+		fputs("Incorrect hexadecimal decode.\n", stderr);
+		goto done;
+	}
+
+	/* Verify clearing empties the buffer without wiping it. */
+	fputs("\nClearing buffer.\n", stdout);
+	bufr2->clear(bufr2);
+	if ( (bufr2->size(bufr2) != 0) || (bp[3] != 0xfe) ) {
+		fputs("Incorrect buffer clear.\n", stderr);
+		goto done;
+	}
+	if ( !bufr2->add(bufr2, (unsigned char *) "AB", 2) )
+		goto done;
+	if ( (bufr2->get(bufr2) != bp) || (bp[3] != 0xfe) )
+		goto done;
+	bufr2->reset(bufr2);
+	if ( (bp[0] != '\0') || (bp[3] != '\0') ) {
+		fputs("Cleared contents not wiped by reset.\n", stderr);
+		goto done;
+	}
+
+	/* Verify hexadecimal conversion. */
+	fputs("\nVerifying hexadecimal conversion.\n", stdout);
+	if ( !hex() )
+		goto done;
+
+	/* Verify base64 conversion. */
+	fputs("\nVerifying base64 conversion.\n", stdout);
+	if ( !base64() )
+		goto done;
+
+	/* Verify small buffers use inline storage. */
+	fputs("\nAdding bytes to a small buffer.\n", stdout);
+	WHACK(bufr);
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &stats) )
+		goto done;
+	held = stats.bytes;
+
+	for (lp= 0; lp < 6; ++lp) {
+		if ( !bufr->add(bufr, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+	bufr->stats(bufr, &growth);
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &stats) )
+		goto done;
+	if ( (growth.capacity != 64) || (stats.bytes != held) ) {
+		fputs("Small buffer used heap storage.\n", stderr);
+		goto done;
+	}
+
+	if ( !bufr->add(bufr, (unsigned char *) "0123456789", 10) )
+		goto done;
+	bp = bufr->get(bufr);
+	for (lp= 0; lp < 70; ++lp) {
+		if ( bp[lp] != '0' + (lp % 10) ) {
+			fputs("Incorrect contents after spill.\n", stderr);
+			goto done;
+		}
+	}
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &stats) )
+		goto done;
+	fprintf(stdout, "Heap bytes after spill: %ld\n", stats.bytes - held);
+	if ( stats.bytes <= held ) {
+		fputs("Spilled buffer not accounted.\n", stderr);
+		goto done;
+	}
+
+	/* Verify read-only views. */
+	fputs("\nVerifying buffer views.\n", stdout);
+	if ( !views() ) {
+		fputs("Buffer view failure.\n", stderr);
+		goto done;
+	}
+
+	/* Verify the comparison methods. */
+	fputs("\nVerifying buffer comparisons.\n", stdout);
+	if ( !comparisons() )
+		goto done;
+
+	/* Verify the use of a buffer as a queue. */
+	fputs("\nVerifying buffer queue.\n", stdout);
+	if ( !queue() )
+		goto done;
+
+	/* Verify the serialization of integers. */
+	fputs("\nVerifying integer serialization.\n", stdout);
+	if ( !integers() )
+		goto done;
+
+	/* Verify secure buffers. */
+	fputs("\nVerifying secure buffers.\n", stdout);
+	if ( !secure() ) {
+		fputs("Secure buffer failure.\n", stderr);
+		goto done;
+	}
+
+	/* Verify copy-on-write sharing. */
+	fputs("\nVerifying shared buffers.\n", stdout);
+	if ( !sharing() ) {
+		fputs("Buffer sharing failure.\n", stderr);
+		goto done;
+	}
+
+	/* Verify the compact representation. */
+	fputs("\nVerifying compact buffers.\n", stdout);
+	if ( !compact() ) {
+		fputs("Compact buffer failure.\n", stderr);
+		goto done;
+	}
+
+	/* Verify the growth policies. */
+	fputs("\nFilling buffers with each growth policy.\n", stdout);
+	for (lp= Buffer_growth_fibonacci; lp <= Buffer_growth_chunk; ++lp) {
+		if ( !fill(lp, &growth) ) {
+			fprintf(stderr, "Growth policy %u failed.\n", lp);
+			goto done;
+		}
+	}
+	if ( (growth.capacity != 100000) || (growth.reallocs > 100) ) {
+		fputs("Incorrect fixed chunk growth.\n", stderr);
+		goto done;
+	}
+	if ( bufr->set_growth(bufr, Buffer_growth_chunk + 1, 0) ) {
+		fputs("Invalid growth policy accepted.\n", stderr);
+		goto done;
+	}
+
+	/* Verify capacity beyond 32 bits. */
+	fputc('\n', stdout);
+	if ( !large(false) )
+		goto done;
+
+	rc = 0;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(bufr2);
+
+	return rc;
+}
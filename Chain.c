@@ -0,0 +1,799 @@
+/** \file
+ * This file contains the implementation of a Chain object.  This
+ * object implements a buffer made up of a list of Buffer segments
+ * which can be added to at either end without copying the contents
+ * already held by the chain.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include "HurdLib.h"
+#include "Origin.h"
+#include "Buffer.h"
+#include "Chain.h"
+
+
+/* State initialization macro. */
+#define STATE(var) CO(Chain_State, var) = _state(this)
+
+
+/* Verify library/object header file inclusions. */
+#if !defined(HurdLib_LIBID)
+#error Library identifier not defined.
+#endif
+
+#if !defined(HurdLib_Chain_OBJID)
+#error Object identifier not defined.
+#endif
+
+
+/* The size of the segments which bytes are appended to. */
+#define CHAIN_SEGMENT 4096
+
+
+/** Chain private state information. */
+struct HurdLib_Chain_State
+{
+	/* The root object. */
+	Origin root;
+
+	/* Library identifier. */
+	uint32_t libid;
+
+	/* Object identifier. */
+	uint32_t objid;
+
+	/* Object status. */
+	_Bool poisoned;
+
+	/* The number of bytes held by the chain. */
+	size_t size;
+
+	/* The prepended segments, most recently prepended last. */
+	Buffer head;
+
+	/* The appended segments. */
+	Buffer tail;
+
+	/* The space remaining in the last appended segment. */
+	size_t room;
+};
+
+
+/**
+ * Internal private method.
+ *
+ * This method is responsible for initializing the HurdLib_Chain_State
+ * structure which holds state information for each instantiated object.
+ *
+ * \param S	A pointer to the object containing the state information
+ *		which is to be initialized.
+ */
+
+static void _init_state(CO(Chain_State, S)) {
+
+	S->libid = HurdLib_LIBID;
+	S->objid = HurdLib_Chain_OBJID;
+
+	S->poisoned = false;
+
+	S->size = 0;
+	S->head = NULL;
+	S->tail = NULL;
+	S->room = 0;
+
+	return;
+}
+
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Chain Chain_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Chain object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Chain_State _state(CO(Chain, this))
+
+{
+	const struct HurdLib_Chain *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Chain_methods )
+		return ((Chain_Compact) this)->state;
+	return this->state;
+}
+
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the number of segments held in a list of
+ * segments.
+ *
+ * \param list	The Buffer object holding the list.
+ *
+ * \return	The number of segments in the list.
+ */
+
+static inline size_t _count(CO(Buffer, list))
+
+{
+	return list->size(list) / sizeof(Buffer);
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method returns a segment of the chain by its position.  The
+ * prepended segments are held in the reverse of their order in the
+ * chain.
+ *
+ * \param S	A pointer to the state of the chain.
+ *
+ * \param idx	The position of the segment in the chain.
+ *
+ * \return	The Buffer object implementing the segment.
+ */
+
+static Buffer _segment(CO(Chain_State, S), size_t const idx)
+
+{
+	size_t heads = _count(S->head);
+
+	Buffer *list;
+
+
+	if ( idx < heads ) {
+		list = (Buffer *) S->head->get(S->head);
+		return list[heads - 1 - idx];
+	}
+
+	list = (Buffer *) S->tail->get(S->tail);
+	return list[idx - heads];
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method adds a segment to the end of a list of segments.
+ *
+ * \param list	The Buffer object holding the list.
+ *
+ * \param seg	The segment which is to be added.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		segment was added.
+ */
+
+static _Bool _push(CO(Buffer, list), Buffer seg)
+
+{
+	return list->add(list, (unsigned char *) &seg, sizeof(seg));
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method releases all of the segments held by the chain.
+ *
+ * \param S	A pointer to the state of the chain.
+ */
+
+static void _release(CO(Chain_State, S))
+
+{
+	size_t lp,
+	       cnt = _count(S->head) + _count(S->tail);
+
+	Buffer seg;
+
+
+	for (lp= 0; lp < cnt; ++lp) {
+		seg = _segment(S, lp);
+		seg->whack(seg);
+	}
+
+	S->head->reset(S->head);
+	S->tail->reset(S->tail);
+	S->size = 0;
+	S->room = 0;
+
+	return;
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method creates a segment holding either a copy of an area of
+ * memory or the contents of a Buffer object and adds it to a list of
+ * segments.
+ *
+ * \param S	A pointer to the state of the chain.
+ *
+ * \param list	The list the segment is to be added to.
+ *
+ * \param src	A pointer to the memory to be copied, if bufr is
+ *		NULL.
+ *
+ * \param cnt	The number of bytes to be copied.
+ *
+ * \param bufr	The object whose contents are to be held by the
+ *		segment.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		segment was added.
+ */
+
+static _Bool _add_segment(CO(Chain_State, S), CO(Buffer, list), \
+			  CO(unsigned char *, src), size_t cnt, \
+			  CO(Buffer, bufr))
+
+{
+	_Bool retn = false;
+
+	Buffer seg = NULL;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( bufr != NULL ) {
+		if ( bufr->poisoned(bufr) )
+			goto done;
+		cnt = bufr->size(bufr);
+	}
+	if ( cnt == 0 )
+		return true;
+	if ( cnt > SIZE_MAX - S->size )
+		goto done;
+
+	INIT(HurdLib, Buffer, seg, goto done);
+	if ( bufr != NULL ) {
+		if ( !seg->share(seg, bufr) )
+			goto done;
+	}
+	else if ( !seg->add(seg, src, cnt) )
+		goto done;
+
+	if ( !_push(list, seg) )
+		goto done;
+	S->size += cnt;
+	retn = true;
+
+
+ done:
+	if ( !retn ) {
+		WHACK(seg);
+		S->poisoned = true;
+	}
+
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements appending bytes to the chain.  The bytes are
+ * copied into segments of a fixed size, so bytes already held by the
+ * chain are never moved by an addition.
+ *
+ * \param this	A pointer to the chain which bytes are to be added to.
+ *
+ * \param src	A pointer to the area of memory from which the bytes
+ *		are to be copied.
+ *
+ * \param cnt	The number of bytes to be added.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition.  A true value indicates success.
+ */
+
+static _Bool add(CO(Chain, this), CO(unsigned char *, src), size_t const cnt)
+
+{
+	STATE(S);
+
+	_Bool retn = false;
+
+	size_t amt,
+	       left = cnt;
+
+	unsigned char const *p = src;
+
+	Buffer seg = NULL;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( cnt > SIZE_MAX - S->size )
+		goto done;
+
+	while ( left > 0 ) {
+		/* Start a new segment when the last one is full. */
+		if ( S->room == 0 ) {
+			amt = left > CHAIN_SEGMENT ? left : CHAIN_SEGMENT;
+			INIT(HurdLib, Buffer, seg, goto done);
+			if ( !seg->reserve(seg, amt) )
+				goto done;
+			if ( !_push(S->tail, seg) )
+				goto done;
+			seg	= NULL;
+			S->room = amt;
+		}
+
+		amt = left < S->room ? left : S->room;
+		seg = _segment(S, _count(S->head) + _count(S->tail) - 1);
+		if ( !seg->add(seg, p, amt) ) {
+			seg = NULL;
+			goto done;
+		}
+		seg = NULL;
+
+		p	+= amt;
+		left	-= amt;
+		S->room -= amt;
+		S->size += amt;
+	}
+	retn = true;
+
+
+ done:
+	if ( !retn ) {
+		WHACK(seg);
+		S->poisoned = true;
+	}
+
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements appending the contents of a Buffer object to
+ * the chain as a new segment.  The segment shares the memory of the
+ * Buffer rather than copying it where possible.
+ *
+ * \param this	A pointer to the chain which the contents are to be
+ *		added to.
+ *
+ * \param bufr	The object whose contents are to be added.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition.  A true value indicates success.
+ */
+
+static _Bool add_Buffer(CO(Chain, this), CO(Buffer, bufr))
+
+{
+	STATE(S);
+
+
+	if ( !_add_segment(S, S->tail, NULL, 0, bufr) )
+		return false;
+	if ( bufr->size(bufr) > 0 )
+		S->room = 0;
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements adding bytes to the start of the chain as a
+ * new segment.
+ *
+ * \param this	A pointer to the chain which bytes are to be added to.
+ *
+ * \param src	A pointer to the area of memory from which the bytes
+ *		are to be copied.
+ *
+ * \param cnt	The number of bytes to be added.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition.  A true value indicates success.
+ */
+
+static _Bool prepend(CO(Chain, this), CO(unsigned char *, src), \
+		     size_t const cnt)
+
+{
+	STATE(S);
+
+	return _add_segment(S, S->head, src, cnt, NULL);
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements adding the contents of a Buffer object to
+ * the start of the chain as a new segment.  The segment shares the
+ * memory of the Buffer rather than copying it where possible.
+ *
+ * \param this	A pointer to the chain which the contents are to be
+ *		added to.
+ *
+ * \param bufr	The object whose contents are to be added.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition.  A true value indicates success.
+ */
+
+static _Bool prepend_Buffer(CO(Chain, this), CO(Buffer, bufr))
+
+{
+	STATE(S);
+
+	return _add_segment(S, S->head, NULL, 0, bufr);
+}
+
+
+/**
+ * External public method.
+ *
+ * This method describes the segments of the chain in an array of
+ * iovec structures suitable for the writev system call.  Chains with
+ * more segments than the array holds are described by repeated calls
+ * which start at successive segments.
+ *
+ * \param this	A pointer to the chain which is to be described.
+ *
+ * \param first	The first segment to be described.
+ *
+ * \param iov	A pointer to the array which is to be populated.
+ *
+ * \param cnt	The number of elements in the array.
+ *
+ * \return	The number of elements populated.  A value of zero
+ *		indicates there are no further segments or the object
+ *		is poisoned.
+ */
+
+static size_t iovec(CO(Chain, this), size_t const first, \
+		    struct iovec * const iov, size_t const cnt)
+
+{
+	STATE(S);
+
+	size_t lp,
+	       segments = _count(S->head) + _count(S->tail);
+
+	Buffer seg;
+
+
+	if ( S->poisoned )
+		return 0;
+
+	for (lp= 0; (lp < cnt) && (first + lp < segments); ++lp) {
+		seg = _segment(S, first + lp);
+		iov[lp].iov_base = seg->get(seg);
+		iov[lp].iov_len	 = seg->size(seg);
+	}
+
+	return lp;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the address of the contents of the chain as a
+ * single contiguous area of memory.  A chain of more than one segment
+ * is flattened into a single segment the first time this is called
+ * after it has been added to.  The contents of a single segment which
+ * shares the memory of a Buffer are also the contents of that Buffer
+ * and are not to be modified through the returned pointer.
+ *
+ * \param this	A pointer to the chain whose contents are to be
+ *		returned.
+ *
+ * \return	A pointer to the contents of the chain.  A NULL value
+ *		indicates the chain is empty or could not be flattened.
+ */
+
+static unsigned char *get(CO(Chain, this))
+
+{
+	STATE(S);
+
+	size_t lp,
+	       size,
+	       segments;
+
+	Buffer seg,
+	       flat = NULL;
+
+
+	if ( S->poisoned )
+		return NULL;
+	if ( (segments = _count(S->head) + _count(S->tail)) == 0 )
+		return NULL;
+
+	if ( segments > 1 ) {
+		INIT(HurdLib, Buffer, flat, goto fail);
+		if ( !flat->reserve(flat, S->size) )
+			goto fail;
+		for (lp= 0; lp < segments; ++lp) {
+			seg = _segment(S, lp);
+			if ( !flat->add(flat, seg->get(seg), seg->size(seg)) )
+				goto fail;
+		}
+
+		size = S->size;
+		_release(S);
+		if ( !_push(S->tail, flat) )
+			goto fail;
+		S->size = size;
+	}
+
+	seg = _segment(S, 0);
+	return seg->get(seg);
+
+
+ fail:
+	WHACK(flat);
+	S->poisoned = true;
+	return NULL;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the number of bytes held by the chain.
+ *
+ * \param this	A pointer to the chain whose size is to be returned.
+ *
+ * \return	The number of bytes in the chain.
+ */
+
+static size_t size(CO(Chain, this))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return 0;
+	return S->size;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the number of segments making up the chain.
+ *
+ * \param this	A pointer to the chain whose segment count is to be
+ *		returned.
+ *
+ * \return	The number of segments in the chain.
+ */
+
+static size_t segments(CO(Chain, this))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return 0;
+	return _count(S->head) + _count(S->tail);
+}
+
+
+/**
+ * External public method.
+ *
+ * This method releases the contents of the chain so that it can be
+ * re-used.
+ *
+ * \param this	A pointer to the chain which is to be reset.
+ */
+
+static void reset(CO(Chain, this))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return;
+
+	_release(S);
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the status of the object.
+ *
+ * \param this	A pointer to the object whose status is being
+ *		requested.
+ */
+
+static _Bool poisoned(CO(Chain, this))
+
+{
+	STATE(S);
+
+	return S->poisoned;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements a destructor for a Chain object.
+ *
+ * \param this	A pointer to the object which is to be destroyed.
+ */
+
+static void whack(CO(Chain, this))
+
+{
+	STATE(S);
+
+
+	_release(S);
+	WHACK(S->head);
+	WHACK(S->tail);
+
+	S->root->whack(S->root, this, S);
+	return;
+}
+
+
+/**
+ * The method table which is copied into each Chain object by its
+ * constructor.
+ */
+static const struct HurdLib_Chain Chain_methods = {
+	.add		= add,
+	.add_Buffer	= add_Buffer,
+	.prepend	= prepend,
+	.prepend_Buffer	= prepend_Buffer,
+
+	.iovec		= iovec,
+	.get		= get,
+	.size		= size,
+	.segments	= segments,
+
+	.reset		= reset,
+	.poisoned	= poisoned,
+	.whack		= whack,
+};
+
+
+/**
+ * Internal private function.
+ *
+ * This function implements the construction of a Chain object in either
+ * its full or its compact representation.
+ *
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
+ */
+
+static void *_create(_Bool const compact)
+
+{
+	Origin root;
+
+	Chain this = NULL;
+
+	Chain_State S;
+
+	struct HurdLib_Origin_Retn retn;
+
+
+	/* Get the root object. */
+	root = HurdLib_Origin_Init();
+
+	/* Allocate the object and internal state. */
+	retn.object_size  = sizeof(struct HurdLib_Chain);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Chain_Compact);
+	retn.state_size   = sizeof(struct HurdLib_Chain_State);
+	if ( !root->init(root, HurdLib_LIBID, HurdLib_Chain_OBJID, &retn) )
+		return NULL;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Chain_Compact) this)->methods = &Chain_methods;
+		((Chain_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Chain_methods;
+		this->state = S;
+	}
+	S->root = root;
+
+	/* Initialize object state. */
+	_init_state(S);
+
+	/* Initialize aggregate objects. */
+	INIT(HurdLib, Buffer, S->head, goto fail);
+	INIT(HurdLib, Buffer, S->tail, goto fail);
+
+	return this;
+
+
+fail:
+	WHACK(S->head);
+	WHACK(S->tail);
+
+	root->whack(root, this, S);
+	return NULL;
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Chain object.
+ *
+ * \return	A pointer to the initialized Chain.  A null value
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Chain HurdLib_Chain_Init(void)
+
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Chain object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Chain object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Chain_Compact HurdLib_Chain_Init_compact(void)
+
+{
+	return _create(true);
+}
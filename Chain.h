@@ -0,0 +1,74 @@
+/** \file
+ * This file contains API definitions for the Chain object which
+ * implements a buffer made up of a list of segments.  It should be
+ * included by any applications which desire to create or use this
+ * object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+#ifndef HurdLib_Chain_HEADER
+#define HurdLib_Chain_HEADER
+
+
+/* Object type definitions. */
+typedef struct HurdLib_Chain * Chain;
+
+typedef struct HurdLib_Chain_State * Chain_State;
+
+typedef struct HurdLib_Chain_Compact * Chain_Compact;
+
+struct iovec;
+
+
+/**
+ * External Chain object representation.
+ */
+struct HurdLib_Chain
+{
+	/* External methods. */
+	_Bool (*add)(const Chain, unsigned char const *, size_t);
+	_Bool (*add_Buffer)(const Chain, const Buffer);
+	_Bool (*prepend)(const Chain, unsigned char const *, size_t);
+	_Bool (*prepend_Buffer)(const Chain, const Buffer);
+
+	size_t (*iovec)(const Chain, size_t, struct iovec *, size_t);
+	unsigned char * (*get)(const Chain);
+	size_t (*size)(const Chain);
+	size_t (*segments)(const Chain);
+
+	void (*reset)(const Chain);
+	_Bool (*poisoned)(const Chain);
+	void (*whack)(const Chain);
+
+	/* Private state. */
+	Chain_State state;
+};
+
+
+/**
+ * Compact Chain object representation.  The object refers to the
+ * method table shared by all Chain objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Chain_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Chain *methods;
+
+	/* Private state. */
+	Chain_State state;
+};
+
+
+/* Chain constructor call. */
+extern HCLINK Chain HurdLib_Chain_Init(void);
+extern HCLINK Chain_Compact HurdLib_Chain_Init_compact(void);
+
+#endif
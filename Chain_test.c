@@ -0,0 +1,177 @@
+/** \file
+ * This file contains a unit test for the Chain object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include "HurdLib.h"
+#include "Buffer.h"
+#include "String.h"
+#include "Chain.h"
+#include "File.h"
+
+
+/* The number of body fragments added to the chain. */
+#define FRAGMENTS 1000
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned int lp,
+		     seg;
+
+	unsigned char *bp;
+
+	size_t cnt,
+	       total;
+
+	struct iovec iov[4];
+
+	Buffer body   = NULL,
+	       expect = NULL,
+	       bufr   = NULL;
+
+	Chain chain = NULL;
+
+	File file = NULL;
+
+	static const char *filename = "Chain_test.txt";
+
+
+	INIT(HurdLib, Buffer, body, goto done);
+	INIT(HurdLib, Buffer, expect, goto done);
+	INIT(HurdLib, Chain, chain, goto done);
+
+	/* Assemble a message with the header added last. */
+	fputs("Assembling message.\n", stdout);
+	for (lp= 0; lp < FRAGMENTS; ++lp) {
+		if ( !chain->add(chain, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+	if ( !body->reserve(body, 10000) )
+		goto done;
+	memset(body->extend(body, 10000), 'B', 10000);
+	if ( !chain->add_Buffer(chain, body) )
+		goto done;
+	if ( !chain->add(chain, (unsigned char *) "trailer", 7) )
+		goto done;
+	if ( !chain->prepend(chain, (unsigned char *) "body\n", 5) )
+		goto done;
+	if ( !chain->prepend(chain, (unsigned char *) "header\n", 7) )
+		goto done;
+
+	if ( !expect->add(expect, (unsigned char *) "header\nbody\n", 12) )
+		goto done;
+	for (lp= 0; lp < FRAGMENTS; ++lp) {
+		if ( !expect->add(expect, (unsigned char *) "0123456789", 10) )
+			goto done;
+	}
+	if ( !expect->add_Buffer(expect, body) )
+		goto done;
+	if ( !expect->add(expect, (unsigned char *) "trailer", 7) )
+		goto done;
+
+	fprintf(stdout, "Size: %zu, segments: %zu\n", chain->size(chain), \
+		chain->segments(chain));
+	if ( chain->size(chain) != expect->size(expect) ) {
+		fputs("Incorrect chain size.\n", stderr);
+		goto done;
+	}
+	if ( chain->segments(chain) != 7 ) {
+		fputs("Incorrect number of segments.\n", stderr);
+		goto done;
+	}
+
+	/* Verify the segments are described in order. */
+	total = 0;
+	bp    = expect->get(expect);
+	for (cnt= 0; (lp= chain->iovec(chain, cnt, iov, 4)) > 0; cnt += lp) {
+		for (seg= 0; seg < lp; ++seg) {
+			if ( iov[seg].iov_len > expect->size(expect) - total )
+				goto done;
+			if ( memcmp(bp + total, iov[seg].iov_base, \
+				    iov[seg].iov_len) != 0 ) {
+				fputs("Incorrect segment contents.\n", stderr);
+				goto done;
+			}
+			total += iov[seg].iov_len;
+		}
+	}
+	if ( total != expect->size(expect) ) {
+		fputs("Incorrect segment description.\n", stderr);
+		goto done;
+	}
+
+	/* Write the segments and read them back. */
+	fputs("Writing chain.\n", stdout);
+	remove(filename);
+	INIT(HurdLib, File, file, goto done);
+	if ( !file->open_rw(file, filename) )
+		goto done;
+	if ( !file->write_Chain(file, chain) ) {
+		fputs("Unable to write chain.\n", stderr);
+		goto done;
+	}
+
+	file->reset(file);
+	if ( !file->open_ro(file, filename) )
+		goto done;
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( !file->slurp(file, bufr) )
+		goto done;
+	if ( !bufr->equal(bufr, expect) ) {
+		fputs("Written chain differs.\n", stderr);
+		goto done;
+	}
+
+	/* Verify the chain is flattened on access. */
+	fputs("Flattening chain.\n", stdout);
+	bp = chain->get(chain);
+	if ( (bp == NULL) || (chain->segments(chain) != 1) ) {
+		fputs("Chain not flattened.\n", stderr);
+		goto done;
+	}
+	if ( memcmp(bp, expect->get(expect), expect->size(expect)) != 0 ) {
+		fputs("Flattened chain differs.\n", stderr);
+		goto done;
+	}
+	if ( chain->size(chain) != expect->size(expect) )
+		goto done;
+
+	chain->reset(chain);
+	if ( (chain->size(chain) != 0) || (chain->get(chain) != NULL) )
+		goto done;
+
+	rc = 0;
+
+
+ done:
+	WHACK(body);
+	WHACK(expect);
+	WHACK(bufr);
+	WHACK(chain);
+	WHACK(file);
+
+	return rc;
+}
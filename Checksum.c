@@ -0,0 +1,1046 @@
+/** \file
+ * This file contains the implementation of a Checksum object.  This
+ * object computes a CRC32C checksum or an xxHash64 hash over data
+ * which is supplied incrementally, so a digest of data can be formed
+ * as it is produced rather than by a second pass over it.
+ *
+ * The CRC32C checksum uses the crc32 instruction of SSE4.2 if the
+ * processor supports it and a slice-by-8 table implementation
+ * otherwise.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+#include "HurdLib.h"
+#include "Origin.h"
+#include "Buffer.h"
+#include "Checksum.h"
+
+
+/* State initialization macro. */
+#define STATE(var) CO(Checksum_State, var) = _state(this)
+
+
+/* Verify library/object header file inclusions. */
+#if !defined(HurdLib_LIBID)
+#error Library identifier not defined.
+#endif
+
+#if !defined(HurdLib_Checksum_OBJID)
+#error Object identifier not defined.
+#endif
+
+
+/* Select SSE4.2 support, which is enabled at run time if available. */
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CHECKSUM_SSE42 1
+#endif
+
+/* The reflected CRC32C (Castagnoli) polynomial. */
+#define CHECKSUM_POLY 0x82f63b78
+
+/*
+ * The lengths of the blocks which are checksummed in parallel by the
+ * crc32 instruction, both must be powers of two.
+ */
+#define CHECKSUM_LONG 8192
+#define CHECKSUM_SHORT 256
+
+/* The number of bytes consumed by each round of xxHash64. */
+#define CHECKSUM_STRIPE 32
+
+/* The xxHash64 primes. */
+#define PRIME64_1 0x9e3779b185ebca87ULL
+#define PRIME64_2 0xc2b2ae3d27d4eb4fULL
+#define PRIME64_3 0x165667b19e3779f9ULL
+#define PRIME64_4 0x85ebca77c2b2ae63ULL
+#define PRIME64_5 0x27d4eb2f165667c5ULL
+
+
+/**
+ * The tables used to compute CRC32C checksums.  The slice tables
+ * implement the software checksum eight bytes at a time.  The shift
+ * tables advance a checksum over a block of zeros, which is used to
+ * combine the checksums of blocks computed in parallel.  The tables
+ * are generated the first time a CRC32C checksum is started.
+ */
+static struct {
+	pthread_once_t once;
+	uint32_t slice[8][256];
+	uint32_t long_shift[4][256];
+	uint32_t short_shift[4][256];
+} Crc32c = {
+	.once = PTHREAD_ONCE_INIT
+};
+
+
+/** Checksum private state information. */
+struct HurdLib_Checksum_State
+{
+	/* The root object. */
+	Origin root;
+
+	/* Library identifier. */
+	uint32_t libid;
+
+	/* Object identifier. */
+	uint32_t objid;
+
+	/* Object status. */
+	_Bool poisoned;
+
+	/* The algorithm being computed and its seed. */
+	enum Checksum_type type;
+	uint64_t seed;
+
+	/* The number of bytes which have been checksummed. */
+	uint64_t size;
+
+	/* The CRC32C register, held in its inverted form. */
+	uint32_t crc;
+
+	/* The xxHash64 accumulators. */
+	uint64_t acc[4];
+
+	/* The bytes of an incomplete xxHash64 stripe. */
+	unsigned char stripe[CHECKSUM_STRIPE];
+	size_t pending;
+};
+
+
+/**
+ * Internal private method.
+ *
+ * This method is responsible for initializing the HurdLib_Checksum_State
+ * structure which holds state information for each instantiated object.
+ *
+ * \param S	A pointer to the object containing the state information
+ *		which is to be initialized.
+ */
+
+static void _init_state(CO(Checksum_State, S)) {
+
+	S->libid = HurdLib_LIBID;
+	S->objid = HurdLib_Checksum_OBJID;
+
+	S->poisoned = false;
+
+	S->type = Checksum_crc32c;
+	S->seed = 0;
+	S->size = 0;
+	S->crc	= 0xffffffff;
+
+	memset(S->acc, '\0', sizeof(S->acc));
+	memset(S->stripe, '\0', sizeof(S->stripe));
+	S->pending = 0;
+
+	return;
+}
+
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Checksum Checksum_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Checksum object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Checksum_State _state(CO(Checksum, this))
+
+{
+	const struct HurdLib_Checksum *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Checksum_methods )
+		return ((Checksum_Compact) this)->state;
+	return this->state;
+}
+
+
+
+/**
+ * Internal private function.
+ *
+ * This function multiplies a 32x32 bit matrix by a vector over the
+ * Galois field of two elements.
+ *
+ * \param mat	The matrix, one row for each bit of the vector.
+ *
+ * \param vec	The vector.
+ *
+ * \return	The product.
+ */
+
+static uint32_t _gf2_times(uint32_t const *mat, uint32_t vec)
+
+{
+	uint32_t sum = 0;
+
+
+	while ( vec ) {
+		if ( vec & 1 )
+			sum ^= *mat;
+		vec >>= 1;
+		++mat;
+	}
+
+	return sum;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function squares a 32x32 bit matrix over the Galois field of
+ * two elements.
+ *
+ * \param square	The matrix which will be set to the square.
+ *
+ * \param mat		The matrix to be squared.
+ */
+
+static void _gf2_square(uint32_t * const square, uint32_t const *mat)
+
+{
+	unsigned int lp;
+
+
+	for (lp= 0; lp < 32; ++lp)
+		square[lp] = _gf2_times(mat, mat[lp]);
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function generates the tables which advance a CRC32C register
+ * over a block of zeros, a byte of the register at a time.
+ *
+ * \param table	The tables which are to be generated.
+ *
+ * \param cnt	The length of the block of zeros, which must be a
+ *		power of two.
+ */
+
+static void _crc32c_shift_table(uint32_t table[4][256], size_t cnt)
+
+{
+	unsigned int lp;
+
+	uint32_t row = 1,
+		 odd[32],
+		 even[32];
+
+
+	/* The operator for a single zero bit. */
+	odd[0] = CHECKSUM_POLY;
+	for (lp= 1; lp < 32; ++lp) {
+		odd[lp] = row;
+		row <<= 1;
+	}
+
+	/* Square up to the operator for a single zero byte. */
+	_gf2_square(even, odd);
+	_gf2_square(odd, even);
+	_gf2_square(even, odd);
+
+	/* Each further squaring doubles the length of the block. */
+	while ( (cnt >>= 1) > 0 ) {
+		_gf2_square(odd, even);
+		memcpy(even, odd, sizeof(even));
+	}
+
+	for (lp= 0; lp < 256; ++lp) {
+		table[0][lp] = _gf2_times(even, lp);
+		table[1][lp] = _gf2_times(even, lp << 8);
+		table[2][lp] = _gf2_times(even, lp << 16);
+		table[3][lp] = _gf2_times(even, lp << 24);
+	}
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function generates the CRC32C tables.  It is called once for
+ * the process.
+ */
+
+static void _crc32c_tables(void)
+
+{
+	unsigned int lp,
+		     bit,
+		     slice;
+
+	uint32_t crc;
+
+
+	for (lp= 0; lp < 256; ++lp) {
+		crc = lp;
+		for (bit= 0; bit < 8; ++bit)
+			crc = (crc >> 1) ^ (CHECKSUM_POLY & -(crc & 1));
+		Crc32c.slice[0][lp] = crc;
+	}
+	for (lp= 0; lp < 256; ++lp) {
+		crc = Crc32c.slice[0][lp];
+		for (slice= 1; slice < 8; ++slice) {
+			crc = (crc >> 8) ^ Crc32c.slice[0][crc & 0xff];
+			Crc32c.slice[slice][lp] = crc;
+		}
+	}
+
+	_crc32c_shift_table(Crc32c.long_shift, CHECKSUM_LONG);
+	_crc32c_shift_table(Crc32c.short_shift, CHECKSUM_SHORT);
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function advances a CRC32C register over a block of zeros.
+ *
+ * \param table	The tables for the length of the block.
+ *
+ * \param crc	The register to be advanced.
+ *
+ * \return	The advanced register.
+ */
+
+static inline uint32_t _crc32c_shift(uint32_t table[4][256], \
+				     uint32_t const crc)
+
+{
+	return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff] ^ \
+		table[2][(crc >> 16) & 0xff] ^ table[3][crc >> 24];
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function loads eight bytes in little-endian order.
+ *
+ * \param bp	A pointer to the bytes to be loaded.
+ *
+ * \return	The value of the bytes.
+ */
+
+static inline uint64_t _load64(unsigned char const *bp)
+
+{
+	return (uint64_t) bp[0] | (uint64_t) bp[1] << 8 | \
+		(uint64_t) bp[2] << 16 | (uint64_t) bp[3] << 24 | \
+		(uint64_t) bp[4] << 32 | (uint64_t) bp[5] << 40 | \
+		(uint64_t) bp[6] << 48 | (uint64_t) bp[7] << 56;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function loads four bytes in little-endian order.
+ *
+ * \param bp	A pointer to the bytes to be loaded.
+ *
+ * \return	The value of the bytes.
+ */
+
+static inline uint32_t _load32(unsigned char const *bp)
+
+{
+	return (uint32_t) bp[0] | (uint32_t) bp[1] << 8 | \
+		(uint32_t) bp[2] << 16 | (uint32_t) bp[3] << 24;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function updates a CRC32C register using the slice-by-8
+ * tables.
+ *
+ * \param crc	The register to be updated.
+ *
+ * \param bp	A pointer to the bytes to be checksummed.
+ *
+ * \param cnt	The number of bytes to be checksummed.
+ *
+ * \return	The updated register.
+ */
+
+static uint32_t _crc32c_sw(uint32_t crc, unsigned char const *bp, \
+			   size_t cnt)
+
+{
+	uint64_t v;
+
+
+	for (; cnt >= 8; cnt -= 8, bp += 8) {
+		v   = _load64(bp) ^ crc;
+		crc = Crc32c.slice[7][v & 0xff] ^ \
+			Crc32c.slice[6][(v >> 8) & 0xff] ^ \
+			Crc32c.slice[5][(v >> 16) & 0xff] ^ \
+			Crc32c.slice[4][(v >> 24) & 0xff] ^ \
+			Crc32c.slice[3][(v >> 32) & 0xff] ^ \
+			Crc32c.slice[2][(v >> 40) & 0xff] ^ \
+			Crc32c.slice[1][(v >> 48) & 0xff] ^ \
+			Crc32c.slice[0][v >> 56];
+	}
+
+	while ( cnt-- )
+		crc = (crc >> 8) ^ Crc32c.slice[0][(crc ^ *bp++) & 0xff];
+
+	return crc;
+}
+
+
+#if defined(CHECKSUM_SSE42)
+/**
+ * Internal private function.
+ *
+ * This function updates a CRC32C register using the crc32
+ * instruction of SSE4.2.  The instruction has a latency of several
+ * cycles but can be issued every cycle, so large inputs are split
+ * into three blocks which are checksummed in parallel and then
+ * combined by shifting the checksums of the earlier blocks over the
+ * length of the blocks which follow them.
+ *
+ * \param crc	The register to be updated.
+ *
+ * \param bp	A pointer to the bytes to be checksummed.
+ *
+ * \param cnt	The number of bytes to be checksummed.
+ *
+ * \return	The updated register.
+ */
+
+static __attribute__((target("sse4.2"))) uint32_t \
+_crc32c_sse42(uint32_t crc, unsigned char const *bp, size_t cnt)
+
+{
+	unsigned char const *end;
+
+	uint64_t crc0 = crc,
+		 crc1,
+		 crc2,
+		 v0,
+		 v1,
+		 v2;
+
+
+	/* Align the input to the size of the operand. */
+	while ( (cnt > 0) && (((uintptr_t) bp & 7) != 0) ) {
+		crc0 = _mm_crc32_u8(crc0, *bp++);
+		--cnt;
+	}
+
+	while ( cnt >= 3 * CHECKSUM_LONG ) {
+		crc1 = 0;
+		crc2 = 0;
+		for (end= bp + CHECKSUM_LONG; bp < end; bp += 8) {
+			memcpy(&v0, bp, sizeof(v0));
+			memcpy(&v1, bp + CHECKSUM_LONG, sizeof(v1));
+			memcpy(&v2, bp + 2 * CHECKSUM_LONG, sizeof(v2));
+			crc0 = _mm_crc32_u64(crc0, v0);
+			crc1 = _mm_crc32_u64(crc1, v1);
+			crc2 = _mm_crc32_u64(crc2, v2);
+		}
+		crc0 = _crc32c_shift(Crc32c.long_shift, crc0) ^ crc1;
+		crc0 = _crc32c_shift(Crc32c.long_shift, crc0) ^ crc2;
+		bp  += 2 * CHECKSUM_LONG;
+		cnt -= 3 * CHECKSUM_LONG;
+	}
+
+	while ( cnt >= 3 * CHECKSUM_SHORT ) {
+		crc1 = 0;
+		crc2 = 0;
+		for (end= bp + CHECKSUM_SHORT; bp < end; bp += 8) {
+			memcpy(&v0, bp, sizeof(v0));
+			memcpy(&v1, bp + CHECKSUM_SHORT, sizeof(v1));
+			memcpy(&v2, bp + 2 * CHECKSUM_SHORT, sizeof(v2));
+			crc0 = _mm_crc32_u64(crc0, v0);
+			crc1 = _mm_crc32_u64(crc1, v1);
+			crc2 = _mm_crc32_u64(crc2, v2);
+		}
+		crc0 = _crc32c_shift(Crc32c.short_shift, crc0) ^ crc1;
+		crc0 = _crc32c_shift(Crc32c.short_shift, crc0) ^ crc2;
+		bp  += 2 * CHECKSUM_SHORT;
+		cnt -= 3 * CHECKSUM_SHORT;
+	}
+
+	for (; cnt >= 8; cnt -= 8, bp += 8) {
+		memcpy(&v0, bp, sizeof(v0));
+		crc0 = _mm_crc32_u64(crc0, v0);
+	}
+	while ( cnt-- )
+		crc0 = _mm_crc32_u8(crc0, *bp++);
+
+	return crc0;
+}
+#endif
+
+
+/**
+ * Internal private function.
+ *
+ * This function implements a round of xxHash64, which folds eight
+ * bytes of input into an accumulator.
+ *
+ * \param acc	The accumulator.
+ *
+ * \param input	The input to be folded.
+ *
+ * \return	The updated accumulator.
+ */
+
+static inline uint64_t _xxh64_round(uint64_t acc, uint64_t const input)
+
+{
+	acc += input * PRIME64_2;
+	acc  = (acc << 31) | (acc >> 33);
+	return acc * PRIME64_1;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function merges an accumulator into the xxHash64 hash.
+ *
+ * \param hash	The hash.
+ *
+ * \param acc	The accumulator to be merged.
+ *
+ * \return	The updated hash.
+ */
+
+static inline uint64_t _xxh64_merge(uint64_t hash, uint64_t const acc)
+
+{
+	hash ^= _xxh64_round(0, acc);
+	return hash * PRIME64_1 + PRIME64_4;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function folds complete 32 byte stripes into the xxHash64
+ * accumulators.
+ *
+ * \param acc	The accumulators.
+ *
+ * \param bp	A pointer to the stripes.
+ *
+ * \param cnt	The number of bytes available, only the complete
+ *		stripes are folded.
+ *
+ * \return	The number of bytes which were folded.
+ */
+
+static size_t _xxh64_stripes(uint64_t * const acc, unsigned char const *bp, \
+			     size_t const cnt)
+
+{
+	size_t lp;
+
+	uint64_t a0 = acc[0],
+		 a1 = acc[1],
+		 a2 = acc[2],
+		 a3 = acc[3];
+
+
+	for (lp= 0; lp + CHECKSUM_STRIPE <= cnt; lp += CHECKSUM_STRIPE) {
+		a0 = _xxh64_round(a0, _load64(bp + lp));
+		a1 = _xxh64_round(a1, _load64(bp + lp + 8));
+		a2 = _xxh64_round(a2, _load64(bp + lp + 16));
+		a3 = _xxh64_round(a3, _load64(bp + lp + 24));
+	}
+
+	acc[0] = a0;
+	acc[1] = a1;
+	acc[2] = a2;
+	acc[3] = a3;
+
+	return lp;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method starts the computation of a checksum, discarding any
+ * computation in progress.
+ *
+ * \param this	A pointer to the object which is to compute the
+ *		checksum.
+ *
+ * \param type	The algorithm which is to be computed.
+ *
+ * \param seed	The seed of the computation.  For CRC32C this is a
+ *		checksum which is to be continued, which allows a
+ *		checksum to be extended with additional data, and
+ *		must fit in 32 bits.  For xxHash64 it selects one of
+ *		the family of hash functions.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		checksum was started.  A false value indicates the
+ *		object is poisoned or the type or seed is not valid.
+ */
+
+static _Bool start(CO(Checksum, this), enum Checksum_type const type, \
+		   uint64_t const seed)
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return false;
+
+	switch ( type ) {
+		case Checksum_crc32c:
+			if ( seed > UINT32_MAX )
+				return false;
+			pthread_once(&Crc32c.once, _crc32c_tables);
+			S->crc = ~(uint32_t) seed;
+			break;
+		case Checksum_xxhash64:
+			S->acc[0] = seed + PRIME64_1 + PRIME64_2;
+			S->acc[1] = seed + PRIME64_2;
+			S->acc[2] = seed;
+			S->acc[3] = seed - PRIME64_1;
+			break;
+		default:
+			return false;
+	}
+
+	S->type	   = type;
+	S->seed	   = seed;
+	S->size	   = 0;
+	S->pending = 0;
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method adds bytes to the checksum.
+ *
+ * \param this	A pointer to the object computing the checksum.
+ *
+ * \param bp	A pointer to the bytes to be added.
+ *
+ * \param cnt	The number of bytes to be added.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		bytes were added.  A false value indicates the object
+ *		is poisoned.
+ */
+
+static _Bool update(CO(Checksum, this), unsigned char const *bp, size_t cnt)
+
+{
+	STATE(S);
+
+	size_t amt;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( cnt == 0 )
+		return true;
+	if ( bp == NULL ) {
+		S->poisoned = true;
+		return false;
+	}
+
+	S->size += cnt;
+
+	if ( S->type == Checksum_crc32c ) {
+#if defined(CHECKSUM_SSE42)
+		if ( __builtin_cpu_supports("sse4.2") ) {
+			S->crc = _crc32c_sse42(S->crc, bp, cnt);
+			return true;
+		}
+#endif
+		S->crc = _crc32c_sw(S->crc, bp, cnt);
+		return true;
+	}
+
+	/* Complete a stripe left by an earlier update. */
+	if ( S->pending > 0 ) {
+		amt = CHECKSUM_STRIPE - S->pending;
+		if ( amt > cnt )
+			amt = cnt;
+		memcpy(S->stripe + S->pending, bp, amt);
+		S->pending += amt;
+		bp	   += amt;
+		cnt	   -= amt;
+		if ( S->pending < CHECKSUM_STRIPE )
+			return true;
+		_xxh64_stripes(S->acc, S->stripe, CHECKSUM_STRIPE);
+		S->pending = 0;
+	}
+
+	amt = _xxh64_stripes(S->acc, bp, cnt);
+	memcpy(S->stripe, bp + amt, cnt - amt);
+	S->pending = cnt - amt;
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method adds the contents of a Buffer object to the checksum.
+ *
+ * \param this	A pointer to the object computing the checksum.
+ *
+ * \param bufr	The object whose contents are to be added.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		contents were added.  A false value indicates either
+ *		object is poisoned.
+ */
+
+static _Bool update_Buffer(CO(Checksum, this), CO(Buffer, bufr))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return false;
+	if ( bufr->poisoned(bufr) ) {
+		S->poisoned = true;
+		return false;
+	}
+
+	return update(this, bufr->get(bufr), bufr->size(bufr));
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the checksum of the bytes which have been
+ * added.  The computation is not disturbed so further bytes can be
+ * added after the value is read.
+ *
+ * \param this	A pointer to the object whose checksum is to be
+ *		returned.
+ *
+ * \return	The value of the checksum.  A CRC32C checksum occupies
+ *		the low 32 bits of the value.
+ */
+
+static uint64_t value(CO(Checksum, this))
+
+{
+	STATE(S);
+
+	unsigned char const *bp = S->stripe;
+
+	size_t cnt = S->pending;
+
+	uint64_t hash;
+
+
+	if ( S->type == Checksum_crc32c )
+		return ~S->crc;
+
+	if ( S->size >= CHECKSUM_STRIPE ) {
+		hash = ((S->acc[0] << 1) | (S->acc[0] >> 63)) + \
+			((S->acc[1] << 7) | (S->acc[1] >> 57)) + \
+			((S->acc[2] << 12) | (S->acc[2] >> 52)) + \
+			((S->acc[3] << 18) | (S->acc[3] >> 46));
+		hash = _xxh64_merge(hash, S->acc[0]);
+		hash = _xxh64_merge(hash, S->acc[1]);
+		hash = _xxh64_merge(hash, S->acc[2]);
+		hash = _xxh64_merge(hash, S->acc[3]);
+	}
+	else
+		hash = S->seed + PRIME64_5;
+	hash += S->size;
+
+	for (; cnt >= 8; cnt -= 8, bp += 8) {
+		hash ^= _xxh64_round(0, _load64(bp));
+		hash  = ((hash << 27) | (hash >> 37)) * PRIME64_1 + PRIME64_4;
+	}
+	if ( cnt >= 4 ) {
+		hash ^= (uint64_t) _load32(bp) * PRIME64_1;
+		hash  = ((hash << 23) | (hash >> 41)) * PRIME64_2 + PRIME64_3;
+		bp   += 4;
+		cnt  -= 4;
+	}
+	while ( cnt-- ) {
+		hash ^= *bp++ * PRIME64_5;
+		hash  = ((hash << 11) | (hash >> 53)) * PRIME64_1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= PRIME64_3;
+	hash ^= hash >> 32;
+
+	return hash;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method adds the checksum to a Buffer object in big-endian
+ * order, four bytes for CRC32C and eight bytes for xxHash64.
+ *
+ * \param this	A pointer to the object whose checksum is to be
+ *		added.
+ *
+ * \param bufr	The object which the checksum is to be added to.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		checksum was added.
+ */
+
+static _Bool digest(CO(Checksum, this), CO(Buffer, bufr))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return false;
+
+	return bufr->add_int(bufr, value(this), \
+			     S->type == Checksum_crc32c ? 4 : 8, \
+			     Buffer_endian_big);
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the number of bytes which have been added to
+ * the checksum.
+ *
+ * \param this	A pointer to the object whose size is to be returned.
+ *
+ * \return	The number of bytes checksummed.
+ */
+
+static uint64_t size(CO(Checksum, this))
+
+{
+	return _state(this)->size;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method restarts the checksum with the algorithm and seed it
+ * was last started with.
+ *
+ * \param this	A pointer to the object which is to be reset.
+ */
+
+static void reset(CO(Checksum, this))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return;
+
+	start(this, S->type, S->seed);
+	explicit_bzero(S->stripe, sizeof(S->stripe));
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the status of the object.
+ *
+ * \param this	A pointer to the object whose status is being
+ *		requested.
+ */
+
+static _Bool poisoned(CO(Checksum, this))
+
+{
+	return _state(this)->poisoned;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements a destructor for a Checksum object.
+ *
+ * \param this	A pointer to the object which is to be destroyed.
+ */
+
+static void whack(CO(Checksum, this))
+
+{
+	STATE(S);
+
+
+	explicit_bzero(S->stripe, sizeof(S->stripe));
+
+	S->root->whack(S->root, this, S);
+	return;
+}
+
+
+/**
+ * The method table which is copied into each Checksum object by its
+ * constructor.
+ */
+static const struct HurdLib_Checksum Checksum_methods = {
+	.start		= start,
+	.update		= update,
+	.update_Buffer	= update_Buffer,
+
+	.value		= value,
+	.digest		= digest,
+	.size		= size,
+
+	.reset		= reset,
+	.poisoned	= poisoned,
+	.whack		= whack,
+};
+
+
+/**
+ * Internal private function.
+ *
+ * This function implements the construction of a Checksum object in either
+ * its full or its compact representation.
+ *
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
+ */
+
+static void *_create(_Bool const compact)
+
+{
+	Origin root;
+
+	Checksum this = NULL;
+
+	Checksum_State S;
+
+	struct HurdLib_Origin_Retn retn;
+
+
+	/* Get the root object. */
+	root = HurdLib_Origin_Init();
+
+	/* Allocate the object and internal state. */
+	retn.object_size  = sizeof(struct HurdLib_Checksum);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Checksum_Compact);
+	retn.state_size   = sizeof(struct HurdLib_Checksum_State);
+	if ( !root->init(root, HurdLib_LIBID, HurdLib_Checksum_OBJID, &retn) )
+		return NULL;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Checksum_Compact) this)->methods = &Checksum_methods;
+		((Checksum_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Checksum_methods;
+		this->state = S;
+	}
+	S->root = root;
+
+	/* Initialize object state. */
+	_init_state(S);
+	start(this, Checksum_crc32c, 0);
+
+	return this;
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Checksum object.
+ * The object computes a CRC32C checksum until another algorithm is
+ * started.
+ *
+ * \return	A pointer to the initialized Checksum.  A null value
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Checksum HurdLib_Checksum_Init(void)
+
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Checksum object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Checksum object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Checksum_Compact HurdLib_Checksum_Init_compact(void)
+
+{
+	return _create(true);
+}
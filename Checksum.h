@@ -0,0 +1,79 @@
+/** \file
+ * This file contains API definitions for the Checksum object which
+ * implements the incremental computation of a CRC32C checksum or an
+ * xxHash64 hash over data as it is produced.  It should be included
+ * by any applications which desire to create or use this object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+#ifndef HurdLib_Checksum_HEADER
+#define HurdLib_Checksum_HEADER
+
+
+/* Object type definitions. */
+typedef struct HurdLib_Checksum * Checksum;
+
+typedef struct HurdLib_Checksum_State * Checksum_State;
+
+typedef struct HurdLib_Checksum_Compact * Checksum_Compact;
+
+/**
+ * The following enumeration defines the algorithms which can be
+ * computed.
+ */
+enum Checksum_type {
+	Checksum_crc32c=0,
+	Checksum_xxhash64
+};
+
+
+/**
+ * External Checksum object representation.
+ */
+struct HurdLib_Checksum
+{
+	/* External methods. */
+	_Bool (*start)(const Checksum, enum Checksum_type, uint64_t);
+	_Bool (*update)(const Checksum, unsigned char const *, size_t);
+	_Bool (*update_Buffer)(const Checksum, const Buffer);
+
+	uint64_t (*value)(const Checksum);
+	_Bool (*digest)(const Checksum, const Buffer);
+	uint64_t (*size)(const Checksum);
+
+	void (*reset)(const Checksum);
+	_Bool (*poisoned)(const Checksum);
+	void (*whack)(const Checksum);
+
+	/* Private state. */
+	Checksum_State state;
+};
+
+
+/**
+ * Compact Checksum object representation.  The object refers to the
+ * method table shared by all Checksum objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Checksum_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Checksum *methods;
+
+	/* Private state. */
+	Checksum_State state;
+};
+
+
+/* Checksum constructor call. */
+extern HCLINK Checksum HurdLib_Checksum_Init(void);
+extern HCLINK Checksum_Compact HurdLib_Checksum_Init_compact(void);
+
+#endif
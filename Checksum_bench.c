@@ -0,0 +1,294 @@
+/** \file
+ * This file contains a benchmark which measures the rate at which the
+ * Checksum object computes checksums, and the cost of checksumming
+ * data as it is added to a Buffer rather than in a second pass.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "HurdLib.h"
+#include "Buffer.h"
+#include "Checksum.h"
+
+
+/* The number of bytes checksummed by each rate measurement. */
+#define RATE_BYTES (1024 * 1024 * 1024)
+
+/* The size of the block checksummed by the rate measurements. */
+#define RATE_BLOCK (64 * 1024)
+
+/* The size of the buffers assembled by the second pass measurement. */
+#define ASSEMBLE_BYTES (64 * 1024 * 1024)
+
+/* The size of the pieces the buffers are assembled from. */
+#define ASSEMBLE_PIECE (16 * 1024)
+
+
+/**
+ * Private function.
+ *
+ * This function returns the current value of the monotonic clock in
+ * nanoseconds.
+ *
+ * \return	The current time in nanoseconds.
+ */
+
+static double now(void)
+
+{
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements a CRC32C checksum computed a byte at a
+ * time from a single table, the common implementation which the
+ * Checksum object is compared with.
+ *
+ * \param bp	A pointer to the bytes to be checksummed.
+ *
+ * \param cnt	The number of bytes to be checksummed.
+ *
+ * \return	The checksum of the bytes.
+ */
+
+static uint32_t bytewise_crc32c(unsigned char const *bp, size_t cnt)
+
+{
+	static _Bool initialized = false;
+
+	static uint32_t table[256];
+
+	unsigned int lp,
+		     bit;
+
+	uint32_t crc = 0xffffffff;
+
+
+	if ( !initialized ) {
+		for (lp= 0; lp < 256; ++lp) {
+			crc = lp;
+			for (bit= 0; bit < 8; ++bit)
+				crc = (crc >> 1) ^ (0x82f63b78 & -(crc & 1));
+			table[lp] = crc;
+		}
+		crc	    = 0xffffffff;
+		initialized = true;
+	}
+
+	while ( cnt-- )
+		crc = (crc >> 8) ^ table[(crc ^ *bp++) & 0xff];
+
+	return ~crc;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the rate at which a block of memory which
+ * is held in cache is checksummed.
+ *
+ * \param type		The algorithm to be measured.
+ *
+ * \param bytewise	A flag used to indicate the bytewise CRC32C
+ *			implementation is to be measured.
+ *
+ * \return		The rate in GB/s.  A negative value indicates
+ *			the benchmark failed.
+ */
+
+static double rate(enum Checksum_type const type, _Bool const bytewise)
+
+{
+	unsigned char *bp;
+
+	unsigned long int lp,
+			  passes = RATE_BYTES / RATE_BLOCK;
+
+	volatile uint64_t result = 0;
+
+	double start,
+	       retn = -1;
+
+	Buffer bufr = NULL;
+
+	Checksum checksum = NULL;
+
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Checksum, checksum, goto done);
+	if ( (bp = bufr->extend(bufr, RATE_BLOCK)) == NULL )
+		goto done;
+	for (lp= 0; lp < RATE_BLOCK; ++lp)
+		bp[lp] = lp * 31;
+	if ( !checksum->start(checksum, type, 0) )
+		goto done;
+
+	if ( bytewise )
+		passes /= 8;
+
+	start = now();
+	for (lp= 0; lp < passes; ++lp) {
+		if ( bytewise )
+			result += bytewise_crc32c(bp, RATE_BLOCK);
+		else {
+			checksum->update(checksum, bp, RATE_BLOCK);
+			result += checksum->value(checksum);
+		}
+	}
+	retn = (double) passes * RATE_BLOCK / (now() - start);
+
+
+ done:
+	WHACK(bufr);
+	WHACK(checksum);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures assembling a large buffer from pieces and
+ * computing its checksum, either by attaching the checksum to the
+ * buffer so that each piece is checksummed as it is added or by
+ * checksumming the assembled buffer.
+ *
+ * \param type		The algorithm to be used.
+ *
+ * \param attach	A flag used to indicate the checksum is to be
+ *			attached to the buffer.
+ *
+ * \return		The time taken in milliseconds.  A negative
+ *			value indicates the benchmark failed.
+ */
+
+static double assemble(enum Checksum_type const type, _Bool const attach)
+
+{
+	unsigned char piece[ASSEMBLE_PIECE];
+
+	size_t lp;
+
+	double start,
+	       retn = -1;
+
+	Buffer bufr = NULL;
+
+	Checksum checksum = NULL;
+
+
+	for (lp= 0; lp < sizeof(piece); ++lp)
+		piece[lp] = lp * 13;
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Checksum, checksum, goto done);
+	if ( !bufr->reserve(bufr, ASSEMBLE_BYTES) )
+		goto done;
+	memset(bufr->get(bufr), '\0', ASSEMBLE_BYTES);
+	if ( !checksum->start(checksum, type, 0) )
+		goto done;
+
+	start = now();
+	if ( attach && !bufr->set_checksum(bufr, checksum) )
+		goto done;
+	for (lp= 0; lp < ASSEMBLE_BYTES; lp += sizeof(piece)) {
+		piece[0] = lp;
+		if ( !bufr->add(bufr, piece, sizeof(piece)) )
+			goto done;
+	}
+	if ( !attach && !checksum->update_Buffer(checksum, bufr) )
+		goto done;
+	retn = (now() - start) / 1e6;
+
+	if ( checksum->size(checksum) != ASSEMBLE_BYTES )
+		retn = -1;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(checksum);
+
+	return retn;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned int lp;
+
+	double bytewise,
+	       rates[2],
+	       times[2];
+
+	static const struct {
+		const char *name;
+		enum Checksum_type type;
+	} types[] = {
+		{"crc32c",	Checksum_crc32c},
+		{"xxhash64",	Checksum_xxhash64}
+	};
+
+
+	fprintf(stdout, "checksum rate: %u byte blocks in cache, GB/s\n", \
+		RATE_BLOCK);
+	if ( (bytewise = rate(Checksum_crc32c, true)) < 0 )
+		goto done;
+	fprintf(stdout, "%-16s %10.3f\n", "bytewise crc32c", bytewise);
+	for (lp= 0; lp < sizeof(types) / sizeof(types[0]); ++lp) {
+		if ( (rates[lp] = rate(types[lp].type, false)) < 0 )
+			goto done;
+		fprintf(stdout, "%-16s %10.3f %9.1fx\n", types[lp].name, \
+			rates[lp], rates[lp] / bytewise);
+	}
+
+	fprintf(stdout, "\nassemble and checksum: %u bytes in %u byte " \
+		"pieces, ms\n", ASSEMBLE_BYTES, ASSEMBLE_PIECE);
+	fprintf(stdout, "%-16s %10s %10s %10s\n", "Algorithm", "2nd pass", \
+		"attached", "speedup");
+	for (lp= 0; lp < sizeof(types) / sizeof(types[0]); ++lp) {
+		times[0] = assemble(types[lp].type, false);
+		times[1] = assemble(types[lp].type, true);
+		if ( (times[0] < 0) || (times[1] < 0) )
+			goto done;
+		fprintf(stdout, "%-16s %10.1f %10.1f %9.1fx\n", \
+			types[lp].name, times[0], times[1], \
+			times[0] / times[1]);
+	}
+
+	rc = 0;
+
+
+ done:
+	return rc;
+}
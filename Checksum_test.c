@@ -0,0 +1,351 @@
+/** \file
+ * This file contains a unit test for the Checksum object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "HurdLib.h"
+#include "Buffer.h"
+#include "String.h"
+#include "Chain.h"
+#include "Checksum.h"
+#include "File.h"
+#include "Ring.h"
+
+
+/* The number of bytes in the large input. */
+#define LARGE 100000
+
+/* The checksums of the large input. */
+#define LARGE_CRC32C 0x60f0c5bdULL
+#define LARGE_XXHASH64 0xd88605c21700af94ULL
+#define LARGE_XXHASH64_SEEDED 0x0500625b9b1638e8ULL
+
+
+/**
+ * Private function.
+ *
+ * This function verifies the checksum of a string.
+ *
+ * \param checksum	The object used to compute the checksum.
+ *
+ * \param type		The algorithm to be used.
+ *
+ * \param str		The string to be checksummed.
+ *
+ * \param expect	The expected checksum.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the checksum was correct.
+ */
+
+static _Bool vector(CO(Checksum, checksum), enum Checksum_type const type, \
+		    CO(char *, str), uint64_t const expect)
+
+{
+	if ( !checksum->start(checksum, type, 0) )
+		return false;
+	if ( !checksum->update(checksum, (unsigned char *) str, strlen(str)) )
+		return false;
+
+	if ( checksum->value(checksum) != expect ) {
+		fprintf(stderr, "Incorrect checksum of '%s': %016llx\n", str, \
+			(unsigned long long) checksum->value(checksum));
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies a checksum computed over a buffer in uneven
+ * pieces against a checksum computed in a single update.
+ *
+ * \param checksum	The object used to compute the checksum.
+ *
+ * \param type		The algorithm to be used.
+ *
+ * \param seed		The seed of the checksum.
+ *
+ * \param bufr		The buffer to be checksummed.
+ *
+ * \param expect	The expected checksum.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the checksums were correct.
+ */
+
+static _Bool pieces(CO(Checksum, checksum), enum Checksum_type const type, \
+		    uint64_t const seed, CO(Buffer, bufr), uint64_t const expect)
+
+{
+	unsigned char *bp = bufr->get(bufr);
+
+	size_t posn,
+	       cnt;
+
+
+	if ( !checksum->start(checksum, type, seed) || \
+	     !checksum->update_Buffer(checksum, bufr) )
+		return false;
+	if ( checksum->value(checksum) != expect )
+		return false;
+
+	if ( !checksum->start(checksum, type, seed) )
+		return false;
+	for (posn= 0; posn < bufr->size(bufr); posn += cnt) {
+		cnt = 1 + (posn * 13) % 977;
+		if ( cnt > bufr->size(bufr) - posn )
+			cnt = bufr->size(bufr) - posn;
+		if ( !checksum->update(checksum, bp + posn, cnt) )
+			return false;
+		checksum->value(checksum);
+	}
+
+	return (checksum->value(checksum) == expect) && \
+		(checksum->size(checksum) == bufr->size(bufr));
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned char *bp;
+
+	size_t lp;
+
+	uint64_t crc;
+
+	Buffer bufr   = NULL,
+	       large  = NULL,
+	       stream = NULL;
+
+	Checksum checksum = NULL,
+		 sum	  = NULL;
+
+	File file = NULL;
+
+	Ring ring = NULL;
+
+	static const char *filename = "Checksum_test.txt";
+
+
+	INIT(HurdLib, Checksum, checksum, goto done);
+	INIT(HurdLib, Checksum, sum, goto done);
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Buffer, large, goto done);
+
+	if ( (bp = large->extend(large, LARGE)) == NULL )
+		goto done;
+	for (lp= 0; lp < LARGE; ++lp)
+		bp[lp] = lp * 7 + (lp >> 8);
+
+	/* Verify known values. */
+	fputs("Verifying checksum values.\n", stdout);
+	if ( !vector(checksum, Checksum_crc32c, "123456789", 0xe3069283) )
+		goto done;
+	if ( !vector(checksum, Checksum_crc32c, "", 0) )
+		goto done;
+	if ( !vector(checksum, Checksum_xxhash64, "", 0xef46db3751d8e999ULL) )
+		goto done;
+	if ( !vector(checksum, Checksum_xxhash64, "abc", \
+		     0x44bc2cf5ad770999ULL) )
+		goto done;
+	if ( !vector(checksum, Checksum_xxhash64, "Nobody inspects the " \
+		     "spammish repetition", 0xfbcea83c8a378bf1ULL) )
+		goto done;
+
+	if ( checksum->start(checksum, Checksum_crc32c, 1ULL << 32) || \
+	     checksum->start(checksum, Checksum_xxhash64 + 1, 0) )
+		goto done;
+
+	/* Verify incremental computation. */
+	fputs("\nVerifying incremental checksums.\n", stdout);
+	if ( !pieces(checksum, Checksum_crc32c, 0, large, LARGE_CRC32C) ) {
+		fputs("Incorrect CRC32C checksum.\n", stderr);
+		goto done;
+	}
+	if ( !pieces(checksum, Checksum_xxhash64, 0, large, \
+		     LARGE_XXHASH64) ) {
+		fputs("Incorrect xxHash64 hash.\n", stderr);
+		goto done;
+	}
+	if ( !pieces(checksum, Checksum_xxhash64, 12345, large, \
+		     LARGE_XXHASH64_SEEDED) ) {
+		fputs("Incorrect seeded xxHash64 hash.\n", stderr);
+		goto done;
+	}
+
+	/* A CRC32C checksum can be continued from its value. */
+	if ( !checksum->start(checksum, Checksum_crc32c, 0) || \
+	     !checksum->update(checksum, bp, 12345) )
+		goto done;
+	crc = checksum->value(checksum);
+	if ( !checksum->start(checksum, Checksum_crc32c, crc) || \
+	     !checksum->update(checksum, bp + 12345, LARGE - 12345) )
+		goto done;
+	if ( checksum->value(checksum) != LARGE_CRC32C )
+		goto done;
+
+	checksum->reset(checksum);
+	if ( (checksum->size(checksum) != 0) || \
+	     (checksum->value(checksum) != crc) )
+		goto done;
+
+	if ( !vector(checksum, Checksum_crc32c, "123456789", 0xe3069283) )
+		goto done;
+	if ( !checksum->digest(checksum, bufr) || (bufr->size(bufr) != 4) || \
+	     (memcmp(bufr->get(bufr), "\xe3\x06\x92\x83", 4) != 0) )
+		goto done;
+
+	/* Verify the checksum of bytes as they are added to a buffer. */
+	fputs("\nVerifying buffer checksums.\n", stdout);
+	INIT(HurdLib, Buffer, stream, goto done);
+	if ( !checksum->start(checksum, Checksum_xxhash64, 0) || \
+	     !sum->start(sum, Checksum_xxhash64, 0) )
+		goto done;
+	if ( !stream->set_checksum(stream, checksum) )
+		goto done;
+
+	/* Bytes which are consumed remain in the checksum. */
+	for (lp= 0; lp < LARGE / 2; lp += 1000) {
+		if ( !stream->add(stream, bp + lp, 1000) )
+			goto done;
+		if ( !stream->consume(stream, NULL, 600) )
+			goto done;
+	}
+	if ( !stream->add_ints(stream, bp + lp, 10000, 1, \
+			       Buffer_endian_big) )
+		goto done;
+	lp += 10000;
+	if ( !sum->update(sum, bp, lp) )
+		goto done;
+
+	if ( !stream->add_hexstring(stream, "0102") || \
+	     !sum->update(sum, (unsigned char *) "\x01\x02", 2) )
+		goto done;
+
+	/* Bytes generated with extend are summed on the next addition. */
+	memcpy(stream->extend(stream, 5000), bp + lp, 5000);
+	memcpy(stream->extend(stream, 100), bp + lp + 5000, 50);
+	stream->shrink(stream, 50);
+	if ( !stream->add(stream, bp + lp + 5050, LARGE - lp - 5050) )
+		goto done;
+	if ( !sum->update(sum, bp + lp, LARGE - lp) )
+		goto done;
+
+	/* Detaching the checksum sums the bytes which remain. */
+	memcpy(stream->extend(stream, 10), "0123456789", 10);
+	if ( !stream->set_checksum(stream, NULL) )
+		goto done;
+	if ( !stream->add(stream, (unsigned char *) "ignored", 7) )
+		goto done;
+	if ( !sum->update(sum, (unsigned char *) "0123456789", 10) )
+		goto done;
+
+	if ( (checksum->value(checksum) != sum->value(sum)) || \
+	     (checksum->size(checksum) != LARGE + 12) ) {
+		fputs("Incorrect buffer checksum.\n", stderr);
+		goto done;
+	}
+
+	/* Records taken from a ring are summed when they are taken. */
+	WHACK(stream);
+	INIT(HurdLib, Ring, ring, goto done);
+	INIT(HurdLib, Buffer, stream, goto done);
+	if ( !ring->set_capacity(ring, 4096) || !ring->put(ring, bp, 1000) )
+		goto done;
+	if ( !checksum->start(checksum, Checksum_crc32c, 0) || \
+	     !sum->start(sum, Checksum_crc32c, 0) )
+		goto done;
+	if ( !stream->set_checksum(stream, checksum) )
+		goto done;
+	if ( !ring->take(ring, stream) || !sum->update(sum, bp, 1000) )
+		goto done;
+	if ( checksum->value(checksum) != sum->value(sum) ) {
+		fputs("Ring record not summed.\n", stderr);
+		goto done;
+	}
+
+	/* The sum method adds bytes generated with extend. */
+	memcpy(stream->extend(stream, 10), "0123456789", 10);
+	stream->sum(stream);
+	if ( !sum->update(sum, (unsigned char *) "0123456789", 10) )
+		goto done;
+	if ( checksum->value(checksum) != sum->value(sum) ) {
+		fputs("Extended region not summed.\n", stderr);
+		goto done;
+	}
+	WHACK(stream);
+
+	/* Verify the checksum of a file as it is written and read. */
+	fputs("\nVerifying file checksums.\n", stdout);
+	remove(filename);
+	INIT(HurdLib, File, file, goto done);
+	if ( !file->open_rw(file, filename) )
+		goto done;
+	if ( !checksum->start(checksum, Checksum_crc32c, 0) || \
+	     !file->set_checksum(file, checksum) )
+		goto done;
+	if ( !file->write_Buffer(file, large) )
+		goto done;
+	if ( checksum->value(checksum) != LARGE_CRC32C ) {
+		fputs("Incorrect checksum of written file.\n", stderr);
+		goto done;
+	}
+
+	checksum->reset(checksum);
+	if ( !sum->start(sum, Checksum_xxhash64, 0) )
+		goto done;
+	bufr->reset(bufr);
+	if ( !bufr->set_checksum(bufr, sum) )
+		goto done;
+	if ( !file->slurp(file, bufr) )
+		goto done;
+	if ( !bufr->equal(bufr, large) )
+		goto done;
+	if ( (checksum->value(checksum) != LARGE_CRC32C) || \
+	     (sum->value(sum) != LARGE_XXHASH64) ) {
+		fputs("Incorrect checksum of read file.\n", stderr);
+		goto done;
+	}
+	fprintf(stdout, "CRC32C: %08llx, xxHash64: %016llx\n", \
+		(unsigned long long) checksum->value(checksum), \
+		(unsigned long long) sum->value(sum));
+
+	rc = 0;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(large);
+	WHACK(stream);
+	WHACK(checksum);
+	WHACK(sum);
+	WHACK(file);
+	WHACK(ring);
+
+	return rc;
+}
@@ -0,0 +1,1128 @@
+/** \file
+ * This file contains the implementation of a Compressor object.  This
+ * object implements a fast LZ77 compressor which trades compression
+ * ratio for speed.  Matches are located through a single hash table
+ * of four byte sequences and the search skips ahead progressively
+ * faster through data which does not compress, so the compressor
+ * runs at hundreds of megabytes per second and decompression is
+ * little more than a sequence of memory copies.
+ *
+ * Compressed data uses the LZ4 block format.  A compressed Buffer
+ * holds the length of the original data as an unsigned LEB128
+ * integer followed by a single block.  Data streamed to a File is
+ * divided into blocks of at most COMPRESSOR_BLOCK bytes, each
+ * preceded by a header of two 32 bit big-endian integers holding the
+ * original and compressed lengths of the block.  A block which would
+ * not be reduced in size is stored as is, which is indicated by the
+ * COMPRESSOR_STORED bit of the compressed length.  The stream ends
+ * with a header whose lengths are zero.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "HurdLib.h"
+#include "Origin.h"
+#include "Buffer.h"
+#include "String.h"
+#include "Chain.h"
+#include "File.h"
+#include "Compressor.h"
+
+
+/* State initialization macro. */
+#define STATE(var) CO(Compressor_State, var) = _state(this)
+
+
+/* Verify library/object header file inclusions. */
+#if !defined(HurdLib_LIBID)
+#error Library identifier not defined.
+#endif
+
+#if !defined(HurdLib_Compressor_OBJID)
+#error Object identifier not defined.
+#endif
+
+
+/* The number of bits in the index of the match table. */
+#define COMPRESSOR_HASH_LOG 12
+
+/* The length of the shortest match. */
+#define COMPRESSOR_MINMATCH 4
+
+/*
+ * The format requires a block to end with at least five literals and
+ * the last match to start at least twelve bytes before the end.
+ */
+#define COMPRESSOR_LASTLITERALS 5
+#define COMPRESSOR_MFLIMIT 12
+
+/* The largest distance to a match. */
+#define COMPRESSOR_DISTANCE 65535
+
+/*
+ * The number of unsuccessful searches after which the distance
+ * between searches is increased, as a power of two.
+ */
+#define COMPRESSOR_SKIP 6
+
+/* The largest input which can be compressed into a single block. */
+#define COMPRESSOR_MAXIMUM 0x7e000000
+
+/* The size of the blocks a stream is divided into. */
+#define COMPRESSOR_BLOCK (1024 * 1024)
+
+/* The size of the header of a block of a stream. */
+#define COMPRESSOR_HEADER 8
+
+/* The flag indicating a block of a stream is not compressed. */
+#define COMPRESSOR_STORED 0x80000000UL
+
+
+/** Compressor private state information. */
+struct HurdLib_Compressor_State
+{
+	/* The root object. */
+	Origin root;
+
+	/* Library identifier. */
+	uint32_t libid;
+
+	/* Object identifier. */
+	uint32_t objid;
+
+	/* Object status. */
+	_Bool poisoned;
+
+	/*
+	 * The match table, holding the position in the input of the
+	 * last sequence with each hash.
+	 */
+	uint32_t table[1 << COMPRESSOR_HASH_LOG];
+
+	/* The block of a stream being written or read. */
+	Buffer block;
+};
+
+
+/**
+ * Internal private method.
+ *
+ * This method is responsible for initializing the
+ * HurdLib_Compressor_State structure which holds state information
+ * for each instantiated object.
+ *
+ * \param S	A pointer to the object containing the state information
+ *		which is to be initialized.
+ */
+
+static void _init_state(CO(Compressor_State, S)) {
+
+	S->libid = HurdLib_LIBID;
+	S->objid = HurdLib_Compressor_OBJID;
+
+	S->poisoned = false;
+
+	memset(S->table, '\0', sizeof(S->table));
+	S->block = NULL;
+
+	return;
+}
+
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Compressor Compressor_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Compressor object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Compressor_State _state(CO(Compressor, this))
+
+{
+	const struct HurdLib_Compressor *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Compressor_methods )
+		return ((Compressor_Compact) this)->state;
+	return this->state;
+}
+
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the largest size of a compressed block.  The
+ * largest block is produced by input without any matches, which is
+ * encoded as literals whose length needs an additional byte for each
+ * 255 bytes of input.
+ *
+ * \param cnt	The length of the input.
+ *
+ * \return	The largest size of the block.
+ */
+
+static inline size_t _bound(size_t const cnt)
+
+{
+	return cnt + cnt / 255 + 16;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function loads four bytes in little-endian order.
+ *
+ * \param bp	A pointer to the bytes to be loaded.
+ *
+ * \return	The value of the bytes.
+ */
+
+static inline uint32_t _load32(unsigned char const *bp)
+
+{
+	return (uint32_t) bp[0] | (uint32_t) bp[1] << 8 | \
+		(uint32_t) bp[2] << 16 | (uint32_t) bp[3] << 24;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function loads eight bytes in little-endian order.
+ *
+ * \param bp	A pointer to the bytes to be loaded.
+ *
+ * \return	The value of the bytes.
+ */
+
+static inline uint64_t _load64(unsigned char const *bp)
+
+{
+	return (uint64_t) bp[0] | (uint64_t) bp[1] << 8 | \
+		(uint64_t) bp[2] << 16 | (uint64_t) bp[3] << 24 | \
+		(uint64_t) bp[4] << 32 | (uint64_t) bp[5] << 40 | \
+		(uint64_t) bp[6] << 48 | (uint64_t) bp[7] << 56;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function stores a 32 bit integer in big-endian order.
+ *
+ * \param bp	A pointer to the location the integer is to be stored
+ *		at.
+ *
+ * \param value	The integer to be stored.
+ */
+
+static inline void _store32(unsigned char * const bp, uint32_t const value)
+
+{
+	bp[0] = value >> 24;
+	bp[1] = value >> 16;
+	bp[2] = value >> 8;
+	bp[3] = value;
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the index of the match table for a sequence
+ * of four bytes.
+ *
+ * \param sequence	The sequence to be indexed.
+ *
+ * \return		The index of the sequence.
+ */
+
+static inline uint32_t _hash(uint32_t const sequence)
+
+{
+	return (sequence * 2654435761U) >> (32 - COMPRESSOR_HASH_LOG);
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the number of bytes two sequences have in
+ * common, comparing eight bytes at a time.
+ *
+ * \param ip	A pointer to the first sequence.
+ *
+ * \param ref	A pointer to the second sequence, which precedes the
+ *		first.
+ *
+ * \param limit	A pointer to the end of the first sequence.
+ *
+ * \return	The number of bytes in common.
+ */
+
+static inline size_t _count(unsigned char const *ip, \
+			    unsigned char const *ref, \
+			    unsigned char const * const limit)
+
+{
+	unsigned char const * const start = ip;
+
+	uint64_t diff;
+
+
+	while ( limit - ip >= 8 ) {
+		if ( (diff = _load64(ip) ^ _load64(ref)) != 0 ) {
+#if defined(__GNUC__)
+			return ip - start + (__builtin_ctzll(diff) >> 3);
+#else
+			while ( (diff & 0xff) == 0 ) {
+				diff >>= 8;
+				++ip;
+			}
+			return ip - start;
+#endif
+		}
+		ip  += 8;
+		ref += 8;
+	}
+
+	while ( (ip < limit) && (*ip == *ref) ) {
+		++ip;
+		++ref;
+	}
+
+	return ip - start;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function encodes the part of a literal or match length which
+ * does not fit in the token of a sequence.
+ *
+ * \param op	A pointer to the location the length is to be encoded
+ *		at.
+ *
+ * \param len	The length which remains to be encoded.
+ *
+ * \return	A pointer to the location following the encoding.
+ */
+
+static inline unsigned char *_put_length(unsigned char *op, size_t len)
+
+{
+	if ( len >= 255 ) {
+		memset(op, 255, len / 255);
+		op  += len / 255;
+		len %= 255;
+	}
+	*op++ = len;
+
+	return op;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function decodes the part of a literal or match length which
+ * does not fit in the token of a sequence.
+ *
+ * \param ipp	A pointer to the location of the encoding, which is
+ *		advanced past it.
+ *
+ * \param iend	A pointer to the end of the input.
+ *
+ * \param len	A pointer to the length, which the encoding is added
+ *		to.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		length was complete.
+ */
+
+static inline _Bool _get_length(unsigned char const **ipp, \
+				unsigned char const * const iend, \
+				size_t * const len)
+
+{
+	unsigned char const *ip = *ipp;
+
+	unsigned int byte;
+
+
+	do {
+		if ( ip == iend )
+			return false;
+		byte  = *ip++;
+		*len += byte;
+	} while ( byte == 255 );
+
+	*ipp = ip;
+	return true;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function encodes a run of literals.
+ *
+ * \param op	A pointer to the location the literals are to be
+ *		encoded at.
+ *
+ * \param bp	A pointer to the literals.
+ *
+ * \param len	The number of literals.
+ *
+ * \return	A pointer to the location following the literals.  The
+ *		token of the sequence is the byte at the location the
+ *		literals were encoded at.
+ */
+
+static inline unsigned char *_put_literals(unsigned char *op, \
+					   unsigned char const *bp, \
+					   size_t const len)
+
+{
+	if ( len >= 15 ) {
+		*op = 15 << 4;
+		op  = _put_length(op + 1, len - 15);
+	}
+	else
+		*op++ = len << 4;
+
+	memcpy(op, bp, len);
+	return op + len;
+}
+
+
+/**
+ * Internal private method.
+ *
+ * This method compresses a block of data.
+ *
+ * \param S	A pointer to the state of the object compressing the
+ *		data.
+ *
+ * \param src	A pointer to the data to be compressed.
+ *
+ * \param cnt	The length of the data.
+ *
+ * \param dst	A pointer to the memory the block is to be placed in,
+ *		which must hold the number of bytes returned by the
+ *		_bound function for the length of the data.
+ *
+ * \return	The size of the compressed block.
+ */
+
+static size_t _compress(CO(Compressor_State, S), \
+			unsigned char const * const src, size_t const cnt, \
+			unsigned char * const dst)
+
+{
+	unsigned char *op = dst,
+		      *token;
+
+	unsigned char const *ip	    = src,
+			    *anchor = src,
+			    *ref,
+			    *mflimit,
+			    *matchlimit;
+
+	uint32_t hash;
+
+	size_t len,
+	       step,
+	       searches;
+
+
+	if ( cnt == 0 ) {
+		*op = 0;
+		return 1;
+	}
+	if ( cnt <= COMPRESSOR_MFLIMIT )
+		goto done;
+
+	/*
+	 * Every entry of a cleared table refers to the start of the
+	 * input, which is a valid, if unlikely, candidate.
+	 */
+	memset(S->table, '\0', sizeof(S->table));
+	mflimit	   = src + cnt - COMPRESSOR_MFLIMIT;
+	matchlimit = src + cnt - COMPRESSOR_LASTLITERALS;
+
+	++ip;
+	while ( ip <= mflimit ) {
+		/* Search for a match, moving faster the longer it takes. */
+		searches = 1 << COMPRESSOR_SKIP;
+		step	 = 1;
+		while ( true ) {
+			hash	       = _hash(_load32(ip));
+			ref	       = src + S->table[hash];
+			S->table[hash] = ip - src;
+			if ( (ip - ref <= COMPRESSOR_DISTANCE) && \
+			     (_load32(ref) == _load32(ip)) )
+				break;
+
+			ip   += step;
+			step  = searches++ >> COMPRESSOR_SKIP;
+			if ( ip > mflimit )
+				goto done;
+		}
+
+		/* Extend the match backwards over the pending literals. */
+		while ( (ip > anchor) && (ref > src) && (ip[-1] == ref[-1]) ) {
+			--ip;
+			--ref;
+		}
+
+		token = op;
+		op    = _put_literals(op, anchor, ip - anchor);
+
+		*op++ = (ip - ref) & 0xff;
+		*op++ = (ip - ref) >> 8;
+
+		len = _count(ip + COMPRESSOR_MINMATCH, \
+			     ref + COMPRESSOR_MINMATCH, matchlimit);
+		ip += len + COMPRESSOR_MINMATCH;
+		if ( len >= 15 ) {
+			*token |= 15;
+			op	= _put_length(op, len - 15);
+		}
+		else
+			*token |= len;
+		anchor = ip;
+
+		/* Index a sequence from the end of the match. */
+		if ( ip <= mflimit ) {
+			hash		= _hash(_load32(ip - 2));
+			S->table[hash]	= ip - 2 - src;
+		}
+	}
+
+
+ done:
+	op = _put_literals(op, anchor, src + cnt - anchor);
+	return op - dst;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function decompresses a block of data.  The block is checked
+ * as it is decoded so data which is not a valid block is rejected
+ * rather than reading or writing outside of the memory provided.
+ *
+ * Where there is room in the output, short literal runs and matches
+ * at a distance of at least sixteen bytes are copied sixteen bytes at
+ * a time, which may write beyond the end of the run.  The bytes which
+ * are written beyond the run are overwritten by the sequences which
+ * follow.
+ *
+ * \param ip	A pointer to the block.
+ *
+ * \param cnt	The size of the block.
+ *
+ * \param op	A pointer to the memory the data is to be placed in.
+ *
+ * \param size	The length of the data.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		block was valid and decompressed to the given length.
+ */
+
+static _Bool _decompress(unsigned char const *ip, size_t const cnt, \
+			 unsigned char *op, size_t const size)
+
+{
+	unsigned char * const ostart = op,
+		      *oend;
+
+	unsigned char const * const iend = ip + cnt,
+			    *ref;
+
+	unsigned int token;
+
+	size_t len,
+	       amt,
+	       offset;
+
+
+	if ( size == 0 )
+		return (cnt == 1) && (*ip == 0);
+	oend = op + size;
+
+	while ( ip < iend ) {
+		token = *ip++;
+
+		/* Copy the literals. */
+		len = token >> 4;
+		if ( (len == 15) && !_get_length(&ip, iend, &len) )
+			return false;
+		if ( (len > (size_t) (iend - ip)) || \
+		     (len > (size_t) (oend - op)) )
+			return false;
+		if ( (len <= 16) && (iend - ip >= 16) && (oend - op >= 16) )
+			memcpy(op, ip, 16);
+		else
+			memcpy(op, ip, len);
+		ip += len;
+		op += len;
+		if ( ip == iend )
+			break;
+
+		/* Copy the match. */
+		if ( iend - ip < 2 )
+			return false;
+		offset = ip[0] | ip[1] << 8;
+		ip    += 2;
+		if ( (offset == 0) || (offset > (size_t) (op - ostart)) )
+			return false;
+		ref = op - offset;
+
+		len = token & 15;
+		if ( (len == 15) && !_get_length(&ip, iend, &len) )
+			return false;
+		len += COMPRESSOR_MINMATCH;
+		if ( len > (size_t) (oend - op) )
+			return false;
+
+		if ( (offset >= 16) && ((size_t) (oend - op) - len >= 16) ) {
+			for (amt= 0; amt < len; amt += 16)
+				memcpy(op + amt, ref + amt, 16);
+			op += len;
+			continue;
+		}
+
+		/*
+		 * The match overlaps its copy, each copy of what has been
+		 * written doubles the length which can be copied next.
+		 */
+		while ( len > 0 ) {
+			amt = op - ref;
+			if ( amt > len )
+				amt = len;
+			memcpy(op, ref, amt);
+			op  += amt;
+			len -= amt;
+		}
+	}
+
+	return op == oend;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the largest number of bytes the compress method
+ * adds to a Buffer for data of a given length, which allows callers
+ * to allocate the output before compressing.
+ *
+ * \param this	A pointer to the object which is to compress the data.
+ *
+ * \param cnt	The length of the data.
+ *
+ * \return	The largest size of the compressed data.
+ */
+
+static size_t bound(CO(Compressor, this), size_t const cnt)
+
+{
+	return _bound(cnt) + 10;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method compresses the contents of a Buffer object and adds
+ * the compressed data to another Buffer object.  The output is
+ * extended once by the largest size of the compressed data and then
+ * reduced to its actual size.
+ *
+ * \param this	A pointer to the object compressing the data.
+ *
+ * \param src	The object whose contents are to be compressed.
+ *
+ * \param dst	The object which the compressed data is to be added
+ *		to.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		data was compressed.  A false value indicates the
+ *		object is poisoned, the input is too large or the
+ *		output could not be extended.  Unless the output is
+ *		poisoned it is left unchanged.
+ */
+
+static _Bool compress(CO(Compressor, this), CO(Buffer, src), CO(Buffer, dst))
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+	size_t cnt,
+	       len,
+	       start;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( src->poisoned(src) || dst->poisoned(dst) ) {
+		S->poisoned = true;
+		return false;
+	}
+	if ( (src == dst) || ((cnt = src->size(src)) > COMPRESSOR_MAXIMUM) )
+		return false;
+
+	start = dst->size(dst);
+	if ( !dst->add_varint(dst, cnt) )
+		return false;
+	if ( (bp = dst->extend(dst, _bound(cnt))) == NULL ) {
+		if ( !dst->poisoned(dst) )
+			dst->shrink(dst, dst->size(dst) - start);
+		return false;
+	}
+
+	len = _compress(S, src->get(src), cnt, bp);
+	dst->shrink(dst, _bound(cnt) - len);
+	dst->sum(dst);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method decompresses the contents of a Buffer object produced
+ * by the compress method and adds the data to another Buffer object.
+ * The output is extended once by the length of the data recorded in
+ * the compressed data.
+ *
+ * \param this	A pointer to the object decompressing the data.
+ *
+ * \param src	The object holding the compressed data.
+ *
+ * \param dst	The object which the data is to be added to.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		data was decompressed.  A false value with neither
+ *		Buffer poisoned indicates the input was not valid
+ *		compressed data, in which case the output is left
+ *		unchanged.
+ */
+
+static _Bool decompress(CO(Compressor, this), CO(Buffer, src), \
+			CO(Buffer, dst))
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+	size_t cnt,
+	       posn = 0;
+
+	uint64_t size;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( src->poisoned(src) || dst->poisoned(dst) ) {
+		S->poisoned = true;
+		return false;
+	}
+	if ( src == dst )
+		return false;
+
+	/*
+	 * Each byte of a block decodes to at most 255 bytes, which
+	 * limits the memory a corrupted length can allocate.
+	 */
+	if ( !src->get_varint(src, &posn, &size) )
+		return false;
+	cnt = src->size(src) - posn;
+	if ( (size > COMPRESSOR_MAXIMUM) || (size / 255 > cnt) )
+		return false;
+
+	if ( size == 0 )
+		return _decompress(src->get(src) + posn, cnt, NULL, 0);
+	if ( (bp = dst->extend(dst, size)) == NULL )
+		return false;
+	if ( !_decompress(src->get(src) + posn, cnt, bp, size) ) {
+		dst->shrink(dst, size);
+		return false;
+	}
+	dst->sum(dst);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method compresses the contents of a Buffer object into a
+ * stream of blocks which are written to a file.  Each block is
+ * written as it is compressed so only a single block needs to be
+ * held in memory.
+ *
+ * \param this	A pointer to the object compressing the data.
+ *
+ * \param file	The object the stream is to be written to.
+ *
+ * \param bufr	The object whose contents are to be compressed.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		stream was written.
+ */
+
+static _Bool write_File(CO(Compressor, this), CO(File, file), \
+			CO(Buffer, bufr))
+
+{
+	STATE(S);
+
+	_Bool retn = false;
+
+	unsigned char *bp,
+		      *src;
+
+	size_t posn,
+	       cnt,
+	       len,
+	       size;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( bufr->poisoned(bufr) || file->poisoned(file) )
+		goto done;
+
+	src  = bufr->get(bufr);
+	size = bufr->size(bufr);
+
+	for (posn= 0; posn < size; posn += cnt) {
+		cnt = size - posn;
+		if ( cnt > COMPRESSOR_BLOCK )
+			cnt = COMPRESSOR_BLOCK;
+
+		S->block->clear(S->block);
+		bp = S->block->extend(S->block, \
+				      COMPRESSOR_HEADER + _bound(cnt));
+		if ( bp == NULL )
+			goto done;
+
+		len = _compress(S, src + posn, cnt, bp + COMPRESSOR_HEADER);
+		_store32(bp, cnt);
+		if ( len < cnt )
+			_store32(bp + 4, len);
+		else {
+			memcpy(bp + COMPRESSOR_HEADER, src + posn, cnt);
+			_store32(bp + 4, cnt | COMPRESSOR_STORED);
+			len = cnt;
+		}
+		S->block->shrink(S->block, _bound(cnt) - len);
+
+		if ( !file->write_Buffer(file, S->block) )
+			goto done;
+	}
+
+	S->block->clear(S->block);
+	if ( !S->block->add_int(S->block, 0, COMPRESSOR_HEADER, \
+				Buffer_endian_big) )
+		goto done;
+	if ( !file->write_Buffer(file, S->block) )
+		goto done;
+
+	retn = true;
+
+
+ done:
+	if ( !retn )
+		S->poisoned = true;
+
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method reads a stream of blocks written by the write_File
+ * method from a file and adds the decompressed data to a Buffer
+ * object.  The file is read up to and including the end of the
+ * stream.
+ *
+ * \param this	A pointer to the object decompressing the data.
+ *
+ * \param file	The object the stream is to be read from.
+ *
+ * \param bufr	The object which the data is to be added to.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		stream was read.  A false value with neither object
+ *		poisoned indicates the stream was truncated or not
+ *		valid, in which case the Buffer is returned to its
+ *		original contents.
+ */
+
+static _Bool read_File(CO(Compressor, this), CO(File, file), CO(Buffer, bufr))
+
+{
+	STATE(S);
+
+	_Bool retn = false,
+	      stored;
+
+	unsigned char *bp;
+
+	size_t posn,
+	       start;
+
+	uint64_t size,
+		 len;
+
+
+	if ( S->poisoned )
+		return false;
+	if ( bufr->poisoned(bufr) || file->poisoned(file) ) {
+		S->poisoned = true;
+		return false;
+	}
+	start = bufr->size(bufr);
+
+	while ( true ) {
+		S->block->clear(S->block);
+		if ( !file->read_Buffer(file, S->block, COMPRESSOR_HEADER) )
+			goto done;
+
+		posn = 0;
+		if ( !S->block->get_int(S->block, &posn, &size, 4, \
+					Buffer_endian_big) || \
+		     !S->block->get_int(S->block, &posn, &len, 4, \
+					Buffer_endian_big) )
+			goto done;
+		if ( size == 0 ) {
+			retn = (len == 0);
+			goto done;
+		}
+
+		stored = (len & COMPRESSOR_STORED) != 0;
+		len   &= ~COMPRESSOR_STORED;
+		if ( (size > COMPRESSOR_BLOCK) || (len == 0) )
+			goto done;
+		if ( stored ? (len != size) : (len > _bound(size)) )
+			goto done;
+
+		S->block->clear(S->block);
+		if ( !file->read_Buffer(file, S->block, len) || \
+		     (S->block->size(S->block) != len) )
+			goto done;
+
+		if ( stored ) {
+			if ( !bufr->add_Buffer(bufr, S->block) )
+				goto done;
+			continue;
+		}
+
+		if ( (bp = bufr->extend(bufr, size)) == NULL )
+			goto done;
+		if ( !_decompress(S->block->get(S->block), len, bp, size) )
+			goto done;
+		bufr->sum(bufr);
+	}
+
+
+ done:
+	if ( !retn && !bufr->poisoned(bufr) )
+		bufr->shrink(bufr, bufr->size(bufr) - start);
+
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the status of the object.
+ *
+ * \param this	A pointer to the object whose status is being
+ *		requested.
+ */
+
+static _Bool poisoned(CO(Compressor, this))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return true;
+
+	return S->block->poisoned(S->block);
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements a destructor for a Compressor object.
+ *
+ * \param this	A pointer to the object which is to be destroyed.
+ */
+
+static void whack(CO(Compressor, this))
+
+{
+	STATE(S);
+
+
+	WHACK(S->block);
+
+	S->root->whack(S->root, this, S);
+	return;
+}
+
+
+/**
+ * The method table which is copied into each Compressor object by its
+ * constructor.
+ */
+static const struct HurdLib_Compressor Compressor_methods = {
+	.bound		= bound,
+	.compress	= compress,
+	.decompress	= decompress,
+
+	.write_File	= write_File,
+	.read_File	= read_File,
+
+	.poisoned	= poisoned,
+	.whack		= whack,
+};
+
+
+/**
+ * Internal private function.
+ *
+ * This function implements the construction of a Compressor object in either
+ * its full or its compact representation.
+ *
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
+ */
+
+static void *_create(_Bool const compact)
+
+{
+	Origin root;
+
+	Compressor this = NULL;
+
+	Compressor_State S;
+
+	struct HurdLib_Origin_Retn retn;
+
+
+	/* Get the root object. */
+	root = HurdLib_Origin_Init();
+
+	/* Allocate the object and internal state. */
+	retn.object_size  = sizeof(struct HurdLib_Compressor);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Compressor_Compact);
+	retn.state_size   = sizeof(struct HurdLib_Compressor_State);
+	if ( !root->init(root, HurdLib_LIBID, HurdLib_Compressor_OBJID, \
+			 &retn) )
+		return NULL;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Compressor_Compact) this)->methods = &Compressor_methods;
+		((Compressor_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Compressor_methods;
+		this->state = S;
+	}
+	S->root = root;
+
+	/* Initialize object state. */
+	_init_state(S);
+
+	/* Initialize aggregate objects. */
+	if ( (S->block = HurdLib_Buffer_Init()) == NULL ) {
+		root->whack(root, this, S);
+		return NULL;
+	}
+
+	return this;
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Compressor
+ * object.
+ *
+ * \return	A pointer to the initialized Compressor.  A null value
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Compressor HurdLib_Compressor_Init(void)
+
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Compressor object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Compressor object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Compressor_Compact HurdLib_Compressor_Init_compact(void)
+
+{
+	return _create(true);
+}
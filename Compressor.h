@@ -0,0 +1,68 @@
+/** \file
+ * This file contains API definitions for the Compressor object which
+ * implements a fast LZ77 block compressor and decompressor producing
+ * the LZ4 block format.  It should be included by any applications
+ * which desire to create or use this object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+#ifndef HurdLib_Compressor_HEADER
+#define HurdLib_Compressor_HEADER
+
+
+/* Object type definitions. */
+typedef struct HurdLib_Compressor * Compressor;
+
+typedef struct HurdLib_Compressor_State * Compressor_State;
+
+typedef struct HurdLib_Compressor_Compact * Compressor_Compact;
+
+
+/**
+ * External Compressor object representation.
+ */
+struct HurdLib_Compressor
+{
+	/* External methods. */
+	size_t (*bound)(const Compressor, size_t);
+	_Bool (*compress)(const Compressor, const Buffer, const Buffer);
+	_Bool (*decompress)(const Compressor, const Buffer, const Buffer);
+
+	_Bool (*write_File)(const Compressor, const File, const Buffer);
+	_Bool (*read_File)(const Compressor, const File, const Buffer);
+
+	_Bool (*poisoned)(const Compressor);
+	void (*whack)(const Compressor);
+
+	/* Private state. */
+	Compressor_State state;
+};
+
+
+/**
+ * Compact Compressor object representation.  The object refers to the
+ * method table shared by all Compressor objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Compressor_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Compressor *methods;
+
+	/* Private state. */
+	Compressor_State state;
+};
+
+
+/* Compressor constructor call. */
+extern HCLINK Compressor HurdLib_Compressor_Init(void);
+extern HCLINK Compressor_Compact HurdLib_Compressor_Init_compact(void);
+
+#endif
@@ -0,0 +1,421 @@
+/** \file
+ * This file contains a benchmark which measures the compression ratio
+ * and the rate of compression and decompression of the Compressor
+ * object on several kinds of data, and the cost of streaming data
+ * through a file compressed rather than as is.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "HurdLib.h"
+#include "Buffer.h"
+#include "String.h"
+#include "Chain.h"
+#include "File.h"
+#include "Compressor.h"
+
+
+/* The size of each kind of data. */
+#define DATA_BYTES (16 * 1024 * 1024)
+
+/* The number of times each kind of data is compressed. */
+#define PASSES 4
+
+/* The file the stream measurements are made with. */
+#define STREAM_FILE "Compressor_bench.txt"
+
+
+/**
+ * The kinds of data which are measured.
+ */
+enum kind {
+	kind_log=0,
+	kind_records,
+	kind_text,
+	kind_random,
+	kind_count
+};
+
+static const char * const kind_names[] = {
+	[kind_log]     = "log lines",
+	[kind_records] = "records",
+	[kind_text]    = "text",
+	[kind_random]  = "random"
+};
+
+
+/**
+ * Private function.
+ *
+ * This function returns the current value of the monotonic clock in
+ * nanoseconds.
+ *
+ * \return	The current time in nanoseconds.
+ */
+
+static double now(void)
+
+{
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function returns the next value of a pseudo-random sequence.
+ *
+ * \param state	A pointer to the state of the sequence.
+ *
+ * \return	The next value, fifteen bits in length.
+ */
+
+static unsigned int next(uint32_t * const state)
+
+{
+	*state = *state * 1103515245 + 12345;
+	return (*state >> 16) & 0x7fff;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function generates a kind of data.
+ *
+ *  log lines:	Log messages with timestamps, process identifiers
+ *		and addresses which vary from line to line.
+ *
+ *  records:	Fixed size binary records of counters, timestamps and
+ *		small measurements in big-endian order.
+ *
+ *  text:	Words drawn with a skewed distribution from a small
+ *		vocabulary.
+ *
+ *  random:	Bytes which do not compress.
+ *
+ * \param bufr	The object which the data is to be added to.
+ *
+ * \param kind	The kind of data to be generated.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		data was generated.
+ */
+
+static _Bool generate(CO(Buffer, bufr), enum kind const kind)
+
+{
+	char line[160];
+
+	static const char * const words[] = {
+		"the", "of", "and", "a", "to", "in", "is", "buffer", "that",
+		"for", "file", "object", "data", "with", "as", "memory",
+		"which", "be", "this", "by", "are", "compression", "on",
+		"from", "block", "each", "not", "stream", "or", "it", "an",
+		"method"
+	};
+
+	unsigned char *bp;
+
+	const char *separator;
+
+	uint32_t state = 1;
+
+	size_t lp;
+
+	uint64_t record = 0;
+
+
+	while ( bufr->size(bufr) < DATA_BYTES ) {
+		switch ( kind ) {
+			case kind_log:
+				lp = next(&state);
+				snprintf(line, sizeof(line), "Oct 16 %02u:%02u:%02u " \
+					 "host%u sshd[%u]: Accepted publickey " \
+					 "for user%u from 10.0.%u.%u port %u\n", \
+					 (unsigned int) (record / 3600) % 24, \
+					 (unsigned int) (record / 60) % 60, \
+					 (unsigned int) record % 60, \
+					 (unsigned int) lp % 4, \
+					 1000 + (unsigned int) lp % 5000, \
+					 (unsigned int) lp % 50, \
+					 (unsigned int) lp % 8, \
+					 next(&state) % 256, \
+					 1024 + next(&state));
+				++record;
+				if ( !bufr->add(bufr, (unsigned char *) line, \
+						strlen(line)) )
+					return false;
+				break;
+
+			case kind_records:
+				if ( !bufr->add_int(bufr, record++, 8, \
+						    Buffer_endian_big) || \
+				     !bufr->add_int(bufr, 1792000000000ULL + \
+						    record * 1000 + \
+						    next(&state) % 100, 8, \
+						    Buffer_endian_big) || \
+				     !bufr->add_int(bufr, next(&state) % 16, 4, \
+						    Buffer_endian_big) || \
+				     !bufr->add_int(bufr, 2000 + \
+						    next(&state) % 64, 4, \
+						    Buffer_endian_big) )
+					return false;
+				break;
+
+			case kind_text:
+				lp	  = next(&state);
+				lp	  = (lp * lp) >> 25;
+				separator = next(&state) % 12 ? " " : ".\n";
+				if ( !bufr->add(bufr, (unsigned char *) words[lp], \
+						strlen(words[lp])) || \
+				     !bufr->add(bufr, (unsigned char *) separator, \
+						strlen(separator)) )
+					return false;
+				break;
+
+			case kind_random:
+				if ( (bp = bufr->extend(bufr, DATA_BYTES)) == NULL )
+					return false;
+				for (lp= 0; lp < DATA_BYTES; ++lp)
+					bp[lp] = next(&state) >> 3;
+				break;
+
+			default:
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the compression of a kind of data.
+ *
+ * \param compressor	The object used to compress the data.
+ *
+ * \param kind		The kind of data to be measured.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the measurement succeeded.
+ */
+
+static _Bool measure(CO(Compressor, compressor), enum kind const kind)
+
+{
+	_Bool retn = false;
+
+	unsigned int lp;
+
+	double start,
+	       compress,
+	       decompress;
+
+	Buffer bufr   = NULL,
+	       packed = NULL,
+	       output = NULL;
+
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Buffer, packed, goto done);
+	INIT(HurdLib, Buffer, output, goto done);
+	if ( !generate(bufr, kind) )
+		goto done;
+
+	start = now();
+	for (lp= 0; lp < PASSES; ++lp) {
+		packed->clear(packed);
+		if ( !compressor->compress(compressor, bufr, packed) )
+			goto done;
+	}
+	compress = (now() - start) / PASSES;
+
+	start = now();
+	for (lp= 0; lp < PASSES; ++lp) {
+		output->clear(output);
+		if ( !compressor->decompress(compressor, packed, output) )
+			goto done;
+	}
+	decompress = (now() - start) / PASSES;
+
+	if ( !output->equal(output, bufr) )
+		goto done;
+
+	fprintf(stdout, "%-16s %10zu %10zu %10.2f %10.0f %10.0f\n", \
+		kind_names[kind], bufr->size(bufr), packed->size(packed), \
+		(double) bufr->size(bufr) / packed->size(packed), \
+		bufr->size(bufr) / compress * 1e3, \
+		bufr->size(bufr) / decompress * 1e3);
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(packed);
+	WHACK(output);
+
+	return retn;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures writing a kind of data to a file and reading
+ * it back, either as is or streamed through the compressor.
+ *
+ * \param compressor	The object used to compress the data, or a
+ *			null value if the data is to be written as is.
+ *
+ * \param kind		The kind of data to be measured.
+ *
+ * \param size		A pointer to the location the size of the
+ *			file is to be placed in.
+ *
+ * \param times		The array the write and read times in
+ *			milliseconds are to be placed in.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the measurement succeeded.
+ */
+
+static _Bool stream(CO(Compressor, compressor), enum kind const kind, \
+		    size_t * const size, double times[2])
+
+{
+	_Bool retn = false;
+
+	double start;
+
+	struct stat statbuf;
+
+	Buffer bufr   = NULL,
+	       output = NULL;
+
+	File file = NULL;
+
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Buffer, output, goto done);
+	if ( !generate(bufr, kind) )
+		goto done;
+
+	remove(STREAM_FILE);
+	INIT(HurdLib, File, file, goto done);
+	if ( !file->open_rw(file, STREAM_FILE) )
+		goto done;
+
+	start = now();
+	if ( compressor == NULL ) {
+		if ( !file->write_Buffer(file, bufr) )
+			goto done;
+	}
+	else if ( !compressor->write_File(compressor, file, bufr) )
+		goto done;
+	times[0] = (now() - start) / 1e6;
+	WHACK(file);
+
+	if ( stat(STREAM_FILE, &statbuf) != 0 )
+		goto done;
+	*size = statbuf.st_size;
+
+	INIT(HurdLib, File, file, goto done);
+	if ( !file->open_ro(file, STREAM_FILE) )
+		goto done;
+
+	start = now();
+	if ( compressor == NULL ) {
+		if ( !file->slurp(file, output) )
+			goto done;
+	}
+	else if ( !compressor->read_File(compressor, file, output) )
+		goto done;
+	times[1] = (now() - start) / 1e6;
+
+	retn = output->equal(output, bufr);
+
+
+ done:
+	WHACK(bufr);
+	WHACK(output);
+	WHACK(file);
+	remove(STREAM_FILE);
+
+	return retn;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	enum kind kind;
+
+	size_t sizes[2];
+
+	double raw[2],
+	       packed[2];
+
+	Compressor compressor = NULL;
+
+
+	INIT(HurdLib, Compressor, compressor, goto done);
+
+	fprintf(stdout, "compression: %u bytes of each kind, MB/s\n", \
+		DATA_BYTES);
+	fprintf(stdout, "%-16s %10s %10s %10s %10s %10s\n", "Data", "Size", \
+		"Compressed", "Ratio", "Compress", "Decompress");
+	for (kind= 0; kind < kind_count; ++kind) {
+		if ( !measure(compressor, kind) )
+			goto done;
+	}
+
+	fprintf(stdout, "\nfile stream: %u bytes of each kind, bytes and " \
+		"ms\n", DATA_BYTES);
+	fprintf(stdout, "%-16s %10s %10s %10s %10s %10s %10s\n", "Data", \
+		"Raw size", "Raw write", "Raw read", "Size", "Write", "Read");
+	for (kind= 0; kind < kind_count; ++kind) {
+		if ( !stream(NULL, kind, &sizes[0], raw) || \
+		     !stream(compressor, kind, &sizes[1], packed) )
+			goto done;
+		fprintf(stdout, "%-16s %10zu %10.1f %10.1f %10zu %10.1f " \
+			"%10.1f\n", kind_names[kind], sizes[0], raw[0], raw[1], \
+			sizes[1], packed[0], packed[1]);
+	}
+
+	rc = 0;
+
+
+ done:
+	WHACK(compressor);
+
+	return rc;
+}
@@ -0,0 +1,270 @@
+/** \file
+ * This file contains a unit test for the Compressor object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "HurdLib.h"
+#include "Buffer.h"
+#include "String.h"
+#include "Chain.h"
+#include "File.h"
+#include "Compressor.h"
+
+
+/* The number of bytes in the large input. */
+#define LARGE (3 * 1024 * 1024 + 12345)
+
+
+/**
+ * Private function.
+ *
+ * This function compresses a buffer, verifies the compressed data is
+ * within the bound and decompresses it again.
+ *
+ * \param compressor	The object used to compress the data.
+ *
+ * \param bufr		The buffer to be compressed.
+ *
+ * \param size		A pointer to the location the size of the
+ *			compressed data is to be placed in.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the data was restored.
+ */
+
+static _Bool round_trip(CO(Compressor, compressor), CO(Buffer, bufr), \
+			size_t * const size)
+
+{
+	_Bool retn = false;
+
+	Buffer packed = NULL,
+	       output = NULL;
+
+
+	INIT(HurdLib, Buffer, packed, goto done);
+	INIT(HurdLib, Buffer, output, goto done);
+
+	if ( !compressor->compress(compressor, bufr, packed) )
+		goto done;
+	if ( packed->size(packed) > \
+	     compressor->bound(compressor, bufr->size(bufr)) )
+		goto done;
+	if ( !compressor->decompress(compressor, packed, output) )
+		goto done;
+	if ( output->size(output) != bufr->size(bufr) )
+		goto done;
+	if ( (bufr->size(bufr) > 0) && !output->equal(output, bufr) )
+		goto done;
+
+	*size = packed->size(packed);
+	retn  = true;
+
+
+ done:
+	WHACK(packed);
+	WHACK(output);
+
+	return retn;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned char *bp;
+
+	uint32_t random = 1;
+
+	size_t lp,
+	       size;
+
+	Buffer bufr   = NULL,
+	       large  = NULL,
+	       packed = NULL,
+	       output = NULL;
+
+	Compressor compressor = NULL;
+
+	File file = NULL;
+
+	static const char *filename = "Compressor_test.txt";
+
+	static const char *line = "Oct 16 12:00:00 host sshd[1234]: " \
+		"Accepted publickey for user from 10.0.0.1 port 22\n";
+
+
+	INIT(HurdLib, Compressor, compressor, goto done);
+	INIT(HurdLib, Buffer, bufr, goto done);
+	INIT(HurdLib, Buffer, packed, goto done);
+	INIT(HurdLib, Buffer, output, goto done);
+
+	/*
+	 * The large input holds a run of text, a run of random bytes
+	 * and a run of zeros.
+	 */
+	INIT(HurdLib, Buffer, large, goto done);
+	for (lp= 0; lp < LARGE / 3; lp += strlen(line)) {
+		if ( !large->add(large, (unsigned char *) line, strlen(line)) )
+			goto done;
+		if ( !large->add_int(large, lp, 4, Buffer_endian_big) )
+			goto done;
+	}
+	if ( (bp = large->extend(large, LARGE / 3)) == NULL )
+		goto done;
+	for (lp= 0; lp < LARGE / 3; ++lp) {
+		random = random * 1103515245 + 12345;
+		bp[lp] = random >> 16;
+	}
+	if ( large->extend(large, LARGE - large->size(large)) == NULL )
+		goto done;
+
+	/* Decode a block of the LZ4 format. */
+	fputs("Verifying block format.\n", stdout);
+	if ( !packed->add_hexstring(packed, "1034616263030050636162" \
+				    "6361") )
+		goto done;
+	if ( !compressor->decompress(compressor, packed, output) )
+		goto done;
+	if ( (output->size(output) != 16) || \
+	     (memcmp(output->get(output), "abcabcabcabcabca", 16) != 0) ) {
+		fputs("Incorrect decompression.\n", stderr);
+		goto done;
+	}
+
+	/* Verify inputs of the lengths at the limits of the format. */
+	fputs("\nVerifying small inputs.\n", stdout);
+	for (lp= 0; lp < 300; ++lp) {
+		bufr->reset(bufr);
+		if ( (lp > 0) && !bufr->add(bufr, large->get(large), lp) )
+			goto done;
+		if ( !round_trip(compressor, bufr, &size) ) {
+			fprintf(stderr, "Failed round trip of %zu bytes.\n", lp);
+			goto done;
+		}
+	}
+
+	bufr->reset(bufr);
+	if ( !bufr->add(bufr, large->get(large) + LARGE - 300, 300) )
+		goto done;
+	if ( !round_trip(compressor, bufr, &size) || (size > 20) ) {
+		fputs("Failed round trip of zeros.\n", stderr);
+		goto done;
+	}
+
+	/* Verify the compression of the large input. */
+	fputs("\nVerifying large input.\n", stdout);
+	if ( !round_trip(compressor, large, &size) ) {
+		fputs("Failed round trip of large input.\n", stderr);
+		goto done;
+	}
+	fprintf(stdout, "%u bytes compressed to %zu bytes.\n", LARGE, size);
+	if ( size > LARGE / 2 ) {
+		fputs("Insufficient compression.\n", stderr);
+		goto done;
+	}
+
+	/* Decompressed data is added to the contents of a buffer. */
+	packed->reset(packed);
+	output->reset(output);
+	if ( !compressor->compress(compressor, large, packed) )
+		goto done;
+	if ( !output->add(output, (unsigned char *) "prefix", 6) )
+		goto done;
+	if ( !compressor->decompress(compressor, packed, output) )
+		goto done;
+	if ( (output->size(output) != LARGE + 6) || \
+	     (memcmp(output->get(output) + 6, large->get(large), LARGE) != 0) )
+		goto done;
+
+	/* Invalid data is rejected and leaves the output unchanged. */
+	fputs("\nVerifying invalid data.\n", stdout);
+	packed->shrink(packed, 10);
+	if ( compressor->decompress(compressor, packed, output) || \
+	     (output->size(output) != LARGE + 6) )
+		goto done;
+
+	packed->reset(packed);
+	if ( !packed->add_hexstring(packed, "10346162630400506361626361") )
+		goto done;
+	if ( compressor->decompress(compressor, packed, output) || \
+	     (output->size(output) != LARGE + 6) )
+		goto done;
+
+	packed->reset(packed);
+	if ( !packed->add_hexstring(packed, "ffffffff0f00") )
+		goto done;
+	if ( compressor->decompress(compressor, packed, output) || \
+	     compressor->poisoned(compressor) )
+		goto done;
+
+	/* Verify streaming through a file. */
+	fputs("\nVerifying file streams.\n", stdout);
+	remove(filename);
+	INIT(HurdLib, File, file, goto done);
+	if ( !file->open_rw(file, filename) )
+		goto done;
+	bufr->reset(bufr);
+	if ( !bufr->add(bufr, (unsigned char *) "small", 5) )
+		goto done;
+	if ( !compressor->write_File(compressor, file, large) || \
+	     !compressor->write_File(compressor, file, bufr) )
+		goto done;
+	WHACK(file);
+
+	INIT(HurdLib, File, file, goto done);
+	if ( !file->open_ro(file, filename) )
+		goto done;
+	output->reset(output);
+	if ( !compressor->read_File(compressor, file, output) )
+		goto done;
+	if ( !output->equal(output, large) ) {
+		fputs("Incorrect file stream.\n", stderr);
+		goto done;
+	}
+	output->reset(output);
+	if ( !compressor->read_File(compressor, file, output) )
+		goto done;
+	if ( !output->equal(output, bufr) )
+		goto done;
+
+	/* A truncated stream is rejected. */
+	if ( compressor->read_File(compressor, file, output) || \
+	     !output->equal(output, bufr) )
+		goto done;
+	WHACK(file);
+
+	rc = 0;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(large);
+	WHACK(packed);
+	WHACK(output);
+	WHACK(compressor);
+	WHACK(file);
+
+	return rc;
+}
@@ -101,6 +101,36 @@ static void _init_state(Config_State const S) {
 	return;
 }
 
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Config Config_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Config object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Config_State _state(CO(Config, this))
+
+{
+	const struct HurdLib_Config *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Config_methods )
+		return ((Config_Compact) this)->state;
+	return this->state;
+}
+
+
 
 /**
  * Private function
@@ -222,6 +252,8 @@ static _Bool parse(CO(Config, config), CO(char *, cfgfile))
 {
 	_Bool retn;
 
+	struct HurdLib_Config object = Config_methods;
+
 
 	/* Open configuration file. */
 	if ( (yyin = fopen(cfgfile, "r")) == NULL )
@@ -230,8 +262,11 @@ static _Bool parse(CO(Config, config), CO(char *, cfgfile))
 	/*
 	 * Parse the file into the defined configuration. Then close
 	 * the configuration file and return the results of the parse.
+	 * The parser calls the methods of the object it is given, so
+	 * it is given the object in its full representation.
 	 */
-	retn = yylex_basic(config);
+	object.state = _state(config);
+	retn = yylex_basic(&object);
 	fclose(yyin);
 
 	return retn;
@@ -259,7 +294,7 @@ static _Bool parse(CO(Config, config), CO(char *, cfgfile))
 static _Bool add_variable(CO(Config, this), char *variable)
 
 {
-	Config_State S = this->state;
+	Config_State S = _state(this);
 
 	struct cfg_value *cfp;
 
@@ -311,7 +346,7 @@ static _Bool add_variable(CO(Config, this), char *variable)
 static _Bool add_value(CO(Config, this), char * const value)
 
 {
-	Config_State S = this->state;
+	Config_State S = _state(this);
 
 	struct section *section = S->sections[S->current];
 
@@ -347,7 +382,7 @@ v */
 static _Bool add_section(CO(Config, this), char *name)
 
 {
-	Config_State S = this->state;
+	Config_State S = _state(this);
 
 
 	++S->current;
@@ -381,7 +416,7 @@ static _Bool add_section(CO(Config, this), char *name)
 extern _Bool set_section(CO(Config, this), const char *name)
 
 {
-	Config_State S = this->state;
+	Config_State S = _state(this);
 
 	unsigned int secnumber;
 
@@ -434,7 +469,7 @@ extern _Bool set_section(CO(Config, this), const char *name)
 static char * get(CO(Config, this), const char *varname)
 
 {
-	Config_State S = this->state;
+	Config_State S = _state(this);
 
 	int lp;
 
@@ -484,7 +519,7 @@ static char * get(CO(Config, this), const char *varname)
 static char * get_ignore(CO(Config, this), const char *varname)
 
 {
-	Config_State S = this->state;
+	Config_State S = _state(this);
 
 	int lp;
 
@@ -523,7 +558,7 @@ static char * get_ignore(CO(Config, this), const char *varname)
 static void dump(CO(Config, this))
 
 {
-	Config_State S = this->state;
+	Config_State S = _state(this);
 
 	int lp,
 	    lp1;
@@ -571,7 +606,7 @@ static void whack(CO(Config, this))
 
 {
 
-	const Config_State S = this->state;
+	const Config_State S = _state(this);
 
 	int lp,
 	    lp1;
@@ -605,21 +640,45 @@ static void whack(CO(Config, this))
 
 	
 /**
- * External constructor call.
+ * The method table which is copied into each Config object by its
+ * constructor.
+ */
+static const struct HurdLib_Config Config_methods = {
+	.parse		= parse,
+	.add_variable	= add_variable,
+	.add_value	= add_value,
+	.add_section	= add_section,
+	.set_section	= set_section,
+	.get		= get,
+	.get_ignore	= get_ignore,
+	.dump		= dump,
+	.whack		= whack,
+};
+
+
+/**
+ * Internal private function.
  *
- * This function implements a constructor call for a Config object.
+ * This function implements the construction of a Config object in either
+ * its full or its compact representation.
  *
- * \return	A pointer to the initialized Config.  A null value
- *		indicates an error was encountered in object generation.
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
  */
 
-extern Config HurdLib_Config_Init(void)
+static void *_create(_Bool const compact)
 
 {
 	Origin root;
 
 	Config this = NULL;
 
+	Config_State S;
+
 	struct HurdLib_Origin_Retn retn;
 
 
@@ -628,32 +687,64 @@ extern Config HurdLib_Config_Init(void)
 
 	/* Allocate the object and internal state. */
 	retn.object_size  = sizeof(struct HurdLib_Config);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Config_Compact);
 	retn.state_size   = sizeof(struct HurdLib_Config_State);
 	if ( !root->init(root, HurdLib_LIBID, HurdLib_Config_OBJID, &retn) )
 		return NULL;
-	this	    	  = retn.object;
-	this->state 	  = retn.state;
-	this->state->root = root;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Config_Compact) this)->methods = &Config_methods;
+		((Config_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Config_methods;
+		this->state = S;
+	}
+	S->root = root;
 
 	/* Initialize object state. */
-	_init_state(this->state);
+	_init_state(S);
 
 	/* Initialize aggregate objects. */
-	if ( !_allocate_section(this->state, NULL) ) {
-		root->whack(root, this, this->state);
+	if ( !_allocate_section(S, NULL) ) {
+		root->whack(root, this, S);
 		return NULL;
 	}
 
-	/* Method initialization. */
-	this->parse		= parse;
-	this->add_variable	= add_variable;
-	this->add_value		= add_value;
-	this->add_section	= add_section;
-	this->set_section	= set_section;
-	this->get		= get;
-	this->get_ignore	= get_ignore;
-	this->dump		= dump;
-	this->whack		= whack;
-
 	return this;
 }
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Config object.
+ *
+ * \return	A pointer to the initialized Config.  A null value
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Config HurdLib_Config_Init(void)
+
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Config object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Config object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Config_Compact HurdLib_Config_Init_compact(void)
+
+{
+	return _create(true);
+}
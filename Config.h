@@ -17,6 +17,8 @@ typedef struct HurdLib_Config * Config;
 
 typedef struct HurdLib_Config_State * Config_State;
 
+typedef struct HurdLib_Config_Compact * Config_Compact;
+
 /**
  * External Config object representation.
  */
@@ -38,7 +40,23 @@ struct HurdLib_Config
 };
 
 
+/**
+ * Compact Config object representation.  The object refers to the
+ * method table shared by all Config objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Config_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Config *methods;
+
+	/* Private state. */
+	Config_State state;
+};
+
+
 /* Config constructor call. */
 extern HCLINK Config HurdLib_Config_Init(void);
+extern HCLINK Config_Compact HurdLib_Config_Init_compact(void);
 
 #endif
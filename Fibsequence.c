@@ -13,8 +13,10 @@
 /* Include files. */
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
 #include <stdlib.h>
-#include <limits.h>
+#include <stddef.h>
 
 #include "HurdLib.h"
 #include "Origin.h"
@@ -44,10 +46,10 @@ struct HurdLib_Fibsequence_State
 	uint32_t objid;
 
 	/* The previous number in the sequence. */
-	unsigned int previous;
+	size_t previous;
 
 	/* The current number in the sequence. */
-	unsigned int current;
+	size_t current;
 };
 
 
@@ -72,6 +74,36 @@ static void _init_state(CO(Fibsequence_State, S)) {
 	return;
 }
 
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Fibsequence Fibsequence_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Fibsequence object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Fibsequence_State _state(CO(Fibsequence, this))
+
+{
+	const struct HurdLib_Fibsequence *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Fibsequence_methods )
+		return ((Fibsequence_Compact) this)->state;
+	return this->state;
+}
+
+
 
 
 
@@ -86,14 +118,17 @@ static void _init_state(CO(Fibsequence_State, S)) {
  * \param this	A pointer to the Fibonacci sequence whose current value
  *		is to be returned.
  *
- * \return	An unsigned integer containing the current value of
- *		the Fibonacci sequence.
+ * \return	A size value containing the current value of the
+ *		Fibonacci sequence.
  */
 
-static unsigned int get(CO(Fibsequence, this))
+static size_t get(CO(Fibsequence, this))
 
 {
-	return this->state->previous + this->state->current;
+	Fibsequence_State const S = _state(this);
+
+
+	return S->previous + S->current;
 }
 
 
@@ -101,24 +136,35 @@ static unsigned int get(CO(Fibsequence, this))
  * External public method.
  *
  * This method implements incrementing the Fibonacci sequence to its
- * next state.
+ * next state.  The sequence saturates at SIZE_MAX, the largest value
+ * of the sequence which can be represented is returned and the
+ * sequence is then held at SIZE_MAX.
  *
  * \param this	A pointer to the Fibonacci sequence whose current value is
  *  to be returned.
  *
- * \return	An unsigned integer containing the next number in the
+ * \return	A size value containing the next number in the
  *		sequence.
  */
 
-static unsigned int next(CO(Fibsequence, this))
+static size_t next(CO(Fibsequence, this))
 
 {
-	unsigned int retn;
+	size_t retn;
 
-	Fibsequence_State const S = this->state;
+	Fibsequence_State const S = _state(this);
 
 
+	/*
+	 * The sum of the two elements never overflows, saturate once
+	 * this value is returned if the sum following this step would.
+	 */
 	retn = S->previous + S->current;
+	if ( retn > SIZE_MAX - S->current ) {
+		S->previous = 0;
+		S->current  = SIZE_MAX;
+		return retn;
+	}
 
 	S->previous = S->current;
 	S->current  = retn;
@@ -139,29 +185,24 @@ static unsigned int next(CO(Fibsequence, this))
  * \parm to	The ceiling value which the sequence is to be incremented
  *		beyond.
  *
- * \return	An unsigned integer containing the sequence value above
- *		the specified ceiling.
+ * \return	A size value containing the sequence value above the
+ *		specified ceiling, or SIZE_MAX if the sequence has
+ *		saturated.
  */
 
-static unsigned int getAbove(CO(Fibsequence, this), unsigned int const to)
+static size_t getAbove(CO(Fibsequence, this), size_t const to)
 
 {
-	unsigned int retn,
-		     next;
-
-
-	while ( 1 ) {
-		retn = this->get(this);
-		if ( to <= retn )
-			return(retn);
-		this->next(this);
-		next = this->get(this);
-		if ( next < retn ) {
-			this->state->previous = 0;
-			this->state->current = UINT_MAX;
-			return UINT_MAX;
-		}
+	size_t retn;
+
+
+	while ( (retn = get(this)) < to ) {
+		if ( retn == SIZE_MAX )
+			break;
+		next(this);
 	}
+
+	return retn;
 }
 
 
@@ -177,7 +218,7 @@ static unsigned int getAbove(CO(Fibsequence, this), unsigned int const to)
 static void reset(CO(Fibsequence, this))
 
 {
-	_init_state(this->state);
+	_init_state(_state(this));
 	return;
 }
 
@@ -194,9 +235,12 @@ static void reset(CO(Fibsequence, this))
 static void print(CO(Fibsequence, this))
 
 {
+	Fibsequence_State const S = _state(this);
+
+
 	printf("Fibonacci sequence element: %p\n", this);
-	printf("\tCurrent:  %d\n", this->state->current);
-	printf("\tPrevious: %d\n", this->state->previous);
+	printf("\tCurrent:  %zu\n", S->current);
+	printf("\tPrevious: %zu\n", S->previous);
 
 	return;
 }
@@ -216,11 +260,11 @@ static void print(CO(Fibsequence, this))
 static void dump(CO(Fibsequence, this), int const offset)
 
 {
-	Fibsequence_State S = this->state;
+	Fibsequence_State S = _state(this);
 
 	S->root->iprint(S->root, offset, __FILE__ " dump: %p\n", this);
-	S->root->iprint(S->root, offset, "\tCurrent:  %d\n", S->current);
-	S->root->iprint(S->root, offset, "\tPrevious: %d\n", S->previous);
+	S->root->iprint(S->root, offset, "\tCurrent:  %zu\n", S->current);
+	S->root->iprint(S->root, offset, "\tPrevious: %zu\n", S->previous);
 
 	return;
 }
@@ -237,7 +281,7 @@ static void dump(CO(Fibsequence, this), int const offset)
 static void whack(CO(Fibsequence, this))
 
 {
-	Fibsequence_State S = this->state;
+	Fibsequence_State S = _state(this);
 
 	S->root->whack(S->root, this, S);
 	return;
@@ -245,20 +289,43 @@ static void whack(CO(Fibsequence, this))
 
 	
 /**
- * External constructor call.
+ * The method table which is copied into each Fibsequence object by its
+ * constructor.
+ */
+static const struct HurdLib_Fibsequence Fibsequence_methods = {
+	.print		= print,
+	.get		= get,
+	.next		= next,
+	.getAbove	= getAbove,
+	.reset		= reset,
+	.dump		= dump,
+	.whack		= whack,
+};
+
+
+/**
+ * Internal private function.
  *
- * This function implements a constructor call for a Fibsequence object.
+ * This function implements the construction of a Fibsequence object in either
+ * its full or its compact representation.
  *
- * \return	A pointer to the initialized Fibsequence object.
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
  */
 
-extern Fibsequence HurdLib_Fibsequence_Init(void)
+static void *_create(_Bool const compact)
 
 {
 	Origin root;
 
 	Fibsequence this = NULL;
 
+	Fibsequence_State S;
+
 	struct HurdLib_Origin_Retn retn;
 
 
@@ -266,26 +333,59 @@ extern Fibsequence HurdLib_Fibsequence_Init(void)
 	root = HurdLib_Origin_Init();
 
 	/* Allocate the object and internal state. */
-	retn.object_size   = sizeof(struct HurdLib_Fibsequence);
-	retn.state_size    = sizeof(struct HurdLib_Fibsequence_State);
+	retn.object_size  = sizeof(struct HurdLib_Fibsequence);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Fibsequence_Compact);
+	retn.state_size   = sizeof(struct HurdLib_Fibsequence_State);
 	if ( !root->init(root, HurdLib_LIBID, HurdLib_Fibsequence_OBJID, \
 			 &retn) )
 		return NULL;
-	this	    	  = retn.object;
-	this->state 	  = retn.state;
-	this->state->root = root;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Fibsequence_Compact) this)->methods = &Fibsequence_methods;
+		((Fibsequence_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Fibsequence_methods;
+		this->state = S;
+	}
+	S->root = root;
 
 	/* Initialize object state. */
-	_init_state(this->state);
-
-	/* Method initialization. */
-	this->print	= print;
-	this->get	= get;
-	this->next	= next;
-	this->getAbove	= getAbove;
-	this->reset	= reset;
-	this->dump	= dump;
-	this->whack 	= whack;
+	_init_state(S);
 
 	return this;
 }
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Fibsequence object.
+ *
+ * \return	A pointer to the initialized Fibsequence object.
+ */
+
+extern Fibsequence HurdLib_Fibsequence_Init(void)
+
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Fibsequence object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Fibsequence object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Fibsequence_Compact HurdLib_Fibsequence_Init_compact(void)
+
+{
+	return _create(true);
+}
@@ -17,15 +17,17 @@ typedef struct HurdLib_Fibsequence * Fibsequence;
 
 typedef struct HurdLib_Fibsequence_State * Fibsequence_State;
 
+typedef struct HurdLib_Fibsequence_Compact * Fibsequence_Compact;
+
 /**
  * External Fibsequence object representation.
  */
 struct HurdLib_Fibsequence
 {
 	/* External methods. */
-	unsigned int	(*get)(const Fibsequence);
-	unsigned int	(*next)(const Fibsequence);
-	unsigned int	(*getAbove)(const Fibsequence, unsigned int);
+	size_t		(*get)(const Fibsequence);
+	size_t		(*next)(const Fibsequence);
+	size_t		(*getAbove)(const Fibsequence, size_t);
 	void		(*reset)(const Fibsequence);
 	void		(*print)(const Fibsequence);
 	void		(*dump)(const Fibsequence, int);
@@ -36,7 +38,23 @@ struct HurdLib_Fibsequence
 };
 
 
+/**
+ * Compact Fibsequence object representation.  The object refers to the
+ * method table shared by all Fibsequence objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Fibsequence_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Fibsequence *methods;
+
+	/* Private state. */
+	Fibsequence_State state;
+};
+
+
 /* Fibsequence constructor call. */
 extern HCLINK Fibsequence HurdLib_Fibsequence_Init(void);
+extern HCLINK Fibsequence_Compact HurdLib_Fibsequence_Init_compact(void);
 
 #endif
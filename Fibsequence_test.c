@@ -0,0 +1,121 @@
+/** \file
+ * This file contains a unit test for the Fibsequence object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "HurdLib.h"
+#include "Fibsequence.h"
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned int steps = 0;
+
+	size_t last,
+	       prior,
+	       value;
+
+	Fibsequence seqn = NULL;
+
+
+	INIT(HurdLib, Fibsequence, seqn, goto done);
+
+	/* Verify the start of the sequence. */
+	fputs("Initial sequence:\n", stdout);
+	for (last= 0; steps < 10; ++steps) {
+		value = seqn->get(seqn);
+		fprintf(stdout, "%zu ", value);
+		if ( value <= last ) {
+			fputs("\nSequence is not increasing.\n", stderr);
+			goto done;
+		}
+		last = value;
+		seqn->next(seqn);
+	}
+	fputc('\n', stdout);
+
+
+	/* Verify the sequence continues beyond 32 bits. */
+	fputs("\nStepping beyond 32 bits.\n", stdout);
+	value = seqn->getAbove(seqn, (size_t) UINT32_MAX + 1);
+	fprintf(stdout, "Value: %zu\n", value);
+	if ( (value <= UINT32_MAX) || (value != seqn->get(seqn)) ) {
+		fputs("Sequence did not exceed 32 bits.\n", stderr);
+		goto done;
+	}
+
+
+	/*
+	 * Verify the sequence saturates rather than wrapping, after the
+	 * largest value which can be represented has been returned.
+	 */
+	fputs("\nStepping to saturation.\n", stdout);
+	seqn->reset(seqn);
+	for (steps= 0, prior= 0, last= 0; steps < 200; ++steps) {
+		value = seqn->next(seqn);
+		if ( value == SIZE_MAX )
+			break;
+		if ( (steps > 1) && (value != last + prior) ) {
+			fprintf(stderr, "Sequence incorrect at step %u.\n", \
+				steps);
+			goto done;
+		}
+		prior = last;
+		last  = value;
+	}
+	fprintf(stdout, "Largest value: %zu\n", last);
+	if ( last <= SIZE_MAX - prior ) {
+		fputs("Sequence saturated early.\n", stderr);
+		goto done;
+	}
+#if SIZE_MAX == UINT64_MAX
+	if ( last != 12200160415121876738ULL ) {
+		fputs("Incorrect largest value.\n", stderr);
+		goto done;
+	}
+#endif
+	if ( seqn->next(seqn) != SIZE_MAX )
+		goto done;
+	seqn->print(seqn);
+	if ( (seqn->get(seqn) != SIZE_MAX) || \
+	     (seqn->getAbove(seqn, SIZE_MAX) != SIZE_MAX) ) {
+		fputs("Sequence did not saturate.\n", stderr);
+		goto done;
+	}
+
+
+	/* Verify a reset sequence restarts. */
+	seqn->reset(seqn);
+	if ( seqn->get(seqn) != 1 ) {
+		fputs("Sequence was not reset.\n", stderr);
+		goto done;
+	}
+
+	rc = 0;
+
+
+ done:
+	WHACK(seqn);
+
+	return rc;
+}
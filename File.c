@@ -11,6 +11,9 @@
 /* Size of I/O buffer. */
 #define FILE_BUFSIZE 4069
 
+/* Number of segments written by each writev call. */
+#define FILE_IOVECS 64
+
 /* Include files. */
 #include <stdint.h>
 #include <stdlib.h>
@@ -23,12 +26,15 @@
 #include <errno.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 
 #include "HurdLib.h"
 #include "Origin.h"
 #include "Buffer.h"
 #include "String.h"
+#include "Chain.h"
+#include "Checksum.h"
 #include "File.h"
 
 
@@ -42,7 +48,7 @@
 #endif
 
 /* State initialization macro. */
-#define STATE(var) CO(File_State, var) = this->state
+#define STATE(var) CO(File_State, var) = _state(this)
 
 
 /** HurdLib_File private state information. */
@@ -66,6 +72,9 @@ struct HurdLib_File_State
 	/* File handle. */
 	int fh;
 
+	/* The checksum of the bytes read and written. */
+	Checksum checksum;
+
 	/* File buffer. */
 	unsigned char bufr[FILE_BUFSIZE];
 };
@@ -90,12 +99,68 @@ static void _init_state(CO(File_State, S))
 	S->poisoned = false;
 	S->error    = 0;
 	S->fh	    = -1;
+	S->checksum = NULL;
 
 	memset(S->bufr, '\0', sizeof(FILE_BUFSIZE));
 
 	return;
 }
 
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_File File_methods;
+
+/* Methods used ahead of their definitions. */
+static off_t seek(CO(File, this), off_t);
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a File object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline File_State _state(CO(File, this))
+
+{
+	const struct HurdLib_File *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &File_methods )
+		return ((File_Compact) this)->state;
+	return this->state;
+}
+
+
+
+/**
+ * Internal private function.
+ *
+ * This function adds bytes which have been read or written to the
+ * checksum attached to the file.
+ *
+ * \param S	A pointer to the state of the file.
+ *
+ * \param bp	A pointer to the bytes which were transferred.
+ *
+ * \param cnt	The number of bytes which were transferred.
+ */
+
+static inline void _sum(CO(File_State, S), CO(void *, bp), size_t const cnt)
+
+{
+	if ( (S->checksum != NULL) && (cnt > 0) )
+		S->checksum->update(S->checksum, bp, cnt);
+	return;
+}
+
 
 /**
  * External public method.
@@ -115,7 +180,7 @@ static void _init_state(CO(File_State, S))
 static _Bool open_ro(CO(File, this), CO(char *, fname))
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 
 	S->fh = open(fname, O_RDONLY);
@@ -147,7 +212,7 @@ static _Bool open_ro(CO(File, this), CO(char *, fname))
 static _Bool open_rw(CO(File, this), CO(char *, fname))
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 	struct stat statbuf;
 
@@ -189,7 +254,7 @@ static _Bool open_rw(CO(File, this), CO(char *, fname))
 static _Bool open_wo(CO(File, this), CO(char *, fname))
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 
 	S->fh = open(fname, O_WRONLY);
@@ -228,7 +293,7 @@ static _Bool open_wo(CO(File, this), CO(char *, fname))
 static _Bool read_Buffer(CO(File, this), CO(Buffer, bufr), size_t cnt)
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 	_Bool retn = false;
 
@@ -254,8 +319,10 @@ static _Bool read_Buffer(CO(File, this), CO(Buffer, bufr), size_t cnt)
 				S->error = errno;
 				goto done;
 			}
-			if ( amt_read != 0 )
+			if ( amt_read != 0 ) {
+				_sum(S, S->bufr, amt_read);
 				bufr->add(bufr, S->bufr, amt_read);
+			}
 		}
 		while ( amt_read != 0 );
 
@@ -274,8 +341,10 @@ static _Bool read_Buffer(CO(File, this), CO(Buffer, bufr), size_t cnt)
 			S->error = errno;
 			goto done;
 		}
-		if ( amt_read > 0 )
+		if ( amt_read > 0 ) {
+			_sum(S, S->bufr, amt_read);
 			bufr->add(bufr, S->bufr, amt_read);
+		}
 	}
 
 	if ( residual > 0 ) {
@@ -284,13 +353,15 @@ static _Bool read_Buffer(CO(File, this), CO(Buffer, bufr), size_t cnt)
 			S->error = errno;
 			goto done;
 		}
-		if ( amt_read != 0 )
+		if ( amt_read != 0 ) {
+			_sum(S, S->bufr, amt_read);
 			bufr->add(bufr, S->bufr, amt_read);
-
-		if ( !bufr->poisoned(bufr) )
-			retn = true;
+		}
 	}
 
+	if ( !bufr->poisoned(bufr) )
+		retn = true;
+
 
 done:
 	memset(S->bufr, '\0', FILE_BUFSIZE);
@@ -317,7 +388,7 @@ done:
 static _Bool slurp(CO(File, this), CO(Buffer, bufr))
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 	_Bool retn = false;
 
@@ -327,12 +398,66 @@ static _Bool slurp(CO(File, this), CO(Buffer, bufr))
 	if ( bufr->poisoned(bufr) )
 		goto done;
 
-	if ( this->seek(this, 0) == -1 ) {
+	if ( seek(this, 0) == -1 ) {
 		S->error = errno;
 		goto done;
 	}
 
-	retn = this->read_Buffer(this, bufr, 0);
+	retn = read_Buffer(this, bufr, 0);
+
+
+ done:
+	if ( !retn )
+		S->poisoned = true;
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements making the contents of the file available
+ * in a Buffer object through a memory mapping of the file rather
+ * than by reading it.  This avoids copying the file and shares the
+ * page cache with other processes mapping the file.
+ *
+ * \param this		A pointer to the object whose file is to be
+ *			mapped.
+ *
+ * \param bufr		The empty Buffer object which is to map the
+ *			file.
+ *
+ * \param writable	A flag used to indicate the contents are to be
+ *			modifiable through a private mapping.
+ *
+ * \param access	The pattern in which the contents are expected
+ *			to be accessed.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the file was mapped.
+ */
+
+static _Bool map_Buffer(CO(File, this), CO(Buffer, bufr), \
+			_Bool const writable, enum Buffer_access const access)
+
+{
+	const File_State S = _state(this);
+
+	_Bool retn = false;
+
+
+	if ( S->poisoned || (S->fh == -1) )
+		return false;
+	if ( bufr->poisoned(bufr) )
+		goto done;
+
+	errno = 0;
+	if ( !bufr->map(bufr, S->fh, writable, access) ) {
+		S->error = errno;
+		goto done;
+	}
+	_sum(S, bufr->get(bufr), bufr->size(bufr));
+	retn = true;
 
 
  done:
@@ -387,6 +512,7 @@ static _Bool read_String(CO(File, this), CO(String, str))
 			case 0:
 				goto done;
 		}
+		_sum(S, inbufr, 1);
 		if ( inbufr[0] != '\n' )
 			str->add(str, inbufr);
 	}
@@ -421,7 +547,7 @@ static _Bool read_String(CO(File, this), CO(String, str))
 static _Bool write_Buffer(CO(File, this), CO(Buffer, buffer))
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 	ssize_t size = buffer->size(buffer);
 
@@ -438,6 +564,7 @@ static _Bool write_Buffer(CO(File, this), CO(Buffer, buffer))
 		S->poisoned = true;
 		return false;
 	}
+	_sum(S, buffer->get(buffer), size);
 
 	return true;
 }
@@ -461,7 +588,7 @@ static _Bool write_Buffer(CO(File, this), CO(Buffer, buffer))
 static _Bool write_String(CO(File, this), CO(String, str))
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 	ssize_t size = str->size(str);
 
@@ -478,11 +605,119 @@ static _Bool write_String(CO(File, this), CO(String, str))
 		S->poisoned = true;
 		return false;
 	}
+	_sum(S, str->get(str), size);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements writing the contents of a Chain object to a
+ * file.  The segments of the chain are written in place with writev
+ * rather than being flattened into a single buffer.
+ *
+ * \param this	A pointer to the object being written to.
+ *
+ * \param chain	The object whose contents are to be written.
+ *
+ * \return	A boolean value is returned to indicate the status
+ *		of the write.  A false value indicates an error
+ *		was experienced.
+ */
+
+static _Bool write_Chain(CO(File, this), CO(Chain, chain))
+
+{
+	const File_State S = _state(this);
+
+	int lp;
+
+	size_t first = 0,
+	       cnt;
+
+	ssize_t amt;
+
+	struct iovec iov[FILE_IOVECS],
+		     *vp;
+
+
+	if ( S->poisoned || (S->fh == -1) )
+		return false;
+	if ( chain->poisoned(chain) ) {
+		S->poisoned = true;
+		return false;
+	}
+
+	while ( (cnt = chain->iovec(chain, first, iov, FILE_IOVECS)) > 0 ) {
+		first += cnt;
+		vp     = iov;
+		lp     = cnt;
+
+		/* Continue from the point reached by a short write. */
+		while ( lp > 0 ) {
+			if ( (amt = writev(S->fh, vp, lp)) == -1 ) {
+				if ( errno == EINTR )
+					continue;
+				S->error    = errno;
+				S->poisoned = true;
+				return false;
+			}
+
+			while ( (lp > 0) && ((size_t) amt >= vp->iov_len) ) {
+				_sum(S, vp->iov_base, vp->iov_len);
+				amt -= vp->iov_len;
+				++vp;
+				--lp;
+			}
+			if ( lp > 0 ) {
+				_sum(S, vp->iov_base, amt);
+				vp->iov_base  = (unsigned char *) vp->iov_base \
+					+ amt;
+				vp->iov_len  -= amt;
+			}
+		}
+	}
 
 	return true;
 }
 
 
+/**
+ * External public method.
+ *
+ * This method attaches a checksum to the file.  The bytes read from
+ * and written to the file are added to the checksum as they are
+ * transferred, so the digest of a file which is read or written is
+ * available without another pass over its contents.  The checksum is
+ * not owned by the file and must remain valid while it is attached.
+ *
+ * \param this		A pointer to the object which the checksum is to
+ *			be attached to.
+ *
+ * \param checksum	The checksum to be attached.  A null value
+ *			detaches the current checksum.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the checksum was attached.  A false value
+ *			indicates the object is poisoned.
+ */
+
+static _Bool set_checksum(CO(File, this), CO(Checksum, checksum))
+
+{
+	STATE(S);
+
+
+	if ( S->poisoned )
+		return false;
+
+	S->checksum = checksum;
+	return true;
+}
+
+
 /**
  * External public method.
  *
@@ -503,7 +738,7 @@ static _Bool write_String(CO(File, this), CO(String, str))
 static off_t seek(CO(File, this), off_t locn)
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 	int whence = SEEK_SET;
 
@@ -563,7 +798,7 @@ static int error(CO(File, this))
 static void reset(CO(File, this))
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 
 	if ( S->fh != -1 ) {
@@ -588,7 +823,7 @@ static void reset(CO(File, this))
 static void clear(CO(File, this))
 
 {
-	this->state->poisoned = false;
+	_state(this)->poisoned = false;
 	return;
 }
 
@@ -603,7 +838,7 @@ static void clear(CO(File, this))
 static _Bool poisoned(CO(File, this))
 
 {
-	return this->state->poisoned;
+	return _state(this)->poisoned;
 }
 
 
@@ -618,7 +853,7 @@ static _Bool poisoned(CO(File, this))
 static void whack(CO(File, this))
 
 {
-	const File_State S = this->state;
+	const File_State S = _state(this);
 
 
 	if ( S->fh != -1 )
@@ -630,21 +865,56 @@ static void whack(CO(File, this))
 
 
 /**
- * External constructor call.
+ * The method table which is copied into each File object by its
+ * constructor.
+ */
+static const struct HurdLib_File File_methods = {
+	.open_ro	= open_ro,
+	.open_rw	= open_rw,
+	.open_wo	= open_wo,
+
+	.read_Buffer	= read_Buffer,
+	.slurp		= slurp,
+	.map_Buffer	= map_Buffer,
+	.read_String	= read_String,
+	.write_Buffer	= write_Buffer,
+	.write_String	= write_String,
+	.write_Chain	= write_Chain,
+	.set_checksum	= set_checksum,
+
+	.seek	= seek,
+
+	.error		= error,
+	.reset		= reset,
+	.clear		= clear,
+	.poisoned	= poisoned,
+	.whack		= whack,
+};
+
+
+/**
+ * Internal private function.
  *
- * This function implements a constructor call for a HurdLib_File object.
+ * This function implements the construction of a File object in either
+ * its full or its compact representation.
  *
- * \return	A pointer to the initialized HurdLib_File.  A null value
- *		indicates an error was encountered in object generation.
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
  */
 
-extern File HurdLib_File_Init(void)
+static void *_create(_Bool const compact)
 
 {
 	Origin root;
 
 	File this = NULL;
 
+	File_State S;
+
 	struct HurdLib_Origin_Retn retn;
 
 
@@ -653,36 +923,60 @@ extern File HurdLib_File_Init(void)
 
 	/* Allocate the object and internal state. */
 	retn.object_size  = sizeof(struct HurdLib_File);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_File_Compact);
 	retn.state_size   = sizeof(struct HurdLib_File_State);
 	if ( !root->init(root, HurdLib_LIBID, HurdLib_File_OBJID, &retn) )
 		return NULL;
-	this	    	  = retn.object;
-	this->state 	  = retn.state;
-	this->state->root = root;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((File_Compact) this)->methods = &File_methods;
+		((File_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = File_methods;
+		this->state = S;
+	}
+	S->root = root;
 
 	/* Initialize aggregate objects. */
 
 	/* Initialize object state. */
-	_init_state(this->state);
+	_init_state(S);
+
+	return this;
+}
+
 
-	/* Method initialization. */
-	this->open_ro	= open_ro;
-	this->open_rw	= open_rw;
-	this->open_wo	= open_wo;
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a HurdLib_File object.
+ *
+ * \return	A pointer to the initialized HurdLib_File.  A null value
+ *		indicates an error was encountered in object generation.
+ */
 
-	this->read_Buffer	= read_Buffer;
-	this->slurp		= slurp;
-	this->read_String	= read_String;
-	this->write_Buffer	= write_Buffer;
-	this->write_String	= write_String;
+extern File HurdLib_File_Init(void)
 
-	this->seek	= seek;
+{
+	return _create(false);
+}
 
-	this->error	= error;
-	this->reset	= reset;
-	this->clear	= clear;
-	this->poisoned	= poisoned;
-	this->whack	= whack;
 
-	return this;
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a File object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized File object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern File_Compact HurdLib_File_Init_compact(void)
+
+{
+	return _create(true);
 }
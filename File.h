@@ -16,6 +16,8 @@ typedef struct HurdLib_File * File;
 
 typedef struct HurdLib_File_State * File_State;
 
+typedef struct HurdLib_File_Compact * File_Compact;
+
 /**
  * External HurdLib_File object representation.
  */
@@ -28,9 +30,12 @@ struct HurdLib_File
 
 	_Bool (*read_Buffer)(const File, const Buffer, size_t);
 	_Bool (*slurp)(const File, const Buffer);
+	_Bool (*map_Buffer)(const File, const Buffer, _Bool, enum Buffer_access);
 	_Bool (*read_String)(const File, const String);
 	_Bool (*write_Buffer)(const File, const Buffer);
 	_Bool (*write_String)(const File, const String);
+	_Bool (*write_Chain)(const File, const Chain);
+	_Bool (*set_checksum)(const File, struct HurdLib_Checksum *);
 
 	off_t (*seek)(const File, off_t);
 
@@ -45,7 +50,23 @@ struct HurdLib_File
 };
 
 
+/**
+ * Compact File object representation.  The object refers to the
+ * method table shared by all File objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_File_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_File *methods;
+
+	/* Private state. */
+	File_State state;
+};
+
+
 /* HurdLib_File constructor call. */
 extern HCLINK File HurdLib_File_Init(void);
+extern HCLINK File_Compact HurdLib_File_Init_compact(void);
 
 #endif
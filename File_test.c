@@ -14,11 +14,13 @@
 /* Include files. */
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "HurdLib.h"
 #include "Buffer.h"
 #include "String.h"
+#include "Chain.h"
 #include "File.h"
 
 
@@ -31,6 +33,11 @@ extern int main(int argc, char *argv[])
 {
 	int rc = 1;
 
+	unsigned char *bp;
+
+	Buffer bufr   = NULL,
+	       mapped = NULL;
+
 	String str = NULL;
 
 	File file = NULL;
@@ -71,10 +78,57 @@ extern int main(int argc, char *argv[])
 	}
 
 	fprintf(stdout, "Read: '%s'\n", str->get(str));
+
+
+	/* Test mapping of the file. */
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( !file->slurp(file, bufr) ) {
+		fputs("Unable to read test file.\n", stderr);
+		goto done;
+	}
+
+	INIT(HurdLib, Buffer, mapped, goto done);
+	if ( !file->map_Buffer(file, mapped, false, \
+			       Buffer_access_sequential) ) {
+		fputs("Unable to map test file.\n", stderr);
+		goto done;
+	}
+	if ( !mapped->equal(mapped, bufr) ) {
+		fputs("Mapped file differs.\n", stderr);
+		goto done;
+	}
+	fprintf(stdout, "Mapped: %zu bytes\n", mapped->size(mapped));
+	WHACK(mapped);
+
+	/* A private mapping is modified without changing the file. */
+	INIT(HurdLib, Buffer, mapped, goto done);
+	if ( !file->map_Buffer(file, mapped, true, Buffer_access_random) )
+		goto done;
+	bp = mapped->get(mapped);
+	bp[0] = 'X';
+	if ( !mapped->add(mapped, (unsigned char *) "appended", 8) )
+		goto done;
+	bp = mapped->get(mapped);
+	if ( (bp[0] != 'X') || \
+	     (mapped->size(mapped) != bufr->size(bufr) + 8) ) {
+		fputs("Incorrect private mapping.\n", stderr);
+		goto done;
+	}
+
+	bufr->reset(bufr);
+	if ( !file->slurp(file, bufr) )
+		goto done;
+	if ( bufr->get(bufr)[0] != 'T' ) {
+		fputs("Private mapping modified file.\n", stderr);
+		goto done;
+	}
+
 	rc = 0;
 
 
  done:
+	WHACK(bufr);
+	WHACK(mapped);
 	WHACK(str);
 	WHACK(file);
 
@@ -25,7 +25,7 @@
 
 
 /* State initialization macro. */
-#define STATE(var) CO(Gaggle_State, var) = this->state
+#define STATE(var) CO(Gaggle_State, var) = _state(this)
 
 
 /* Verify library/object header file inclusions. */
@@ -89,6 +89,36 @@ static void _init_state(CO(Gaggle_State, S)) {
 	return;
 }
 
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Gaggle Gaggle_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Gaggle object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Gaggle_State _state(CO(Gaggle, this))
+
+{
+	const struct HurdLib_Gaggle *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Gaggle_methods )
+		return ((Gaggle_Compact) this)->state;
+	return this->state;
+}
+
+
 
 /**
  * External public method.
@@ -244,21 +274,43 @@ static void whack(CO(Gaggle, this))
 
 	
 /**
- * External constructor call.
+ * The method table which is copied into each Gaggle object by its
+ * constructor.
+ */
+static const struct HurdLib_Gaggle Gaggle_methods = {
+	.add	= add,
+	.get	= get,
+
+	.size		= size,
+	.rewind_cursor	= rewind_cursor,
+
+	.whack	= whack,
+};
+
+
+/**
+ * Internal private function.
  *
- * This function implements a constructor call for a Gaggle object.
+ * This function implements the construction of a Gaggle object in either
+ * its full or its compact representation.
  *
- * \return	A pointer to the initialized Gaggle.  A null value
- *		indicates an error was encountered in object generation.
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
  */
 
-extern Gaggle HurdLib_Gaggle_Init(void)
+static void *_create(_Bool const compact)
 
 {
 	Origin root;
 
 	Gaggle this = NULL;
 
+	Gaggle_State S;
+
 	struct HurdLib_Origin_Retn retn;
 
 
@@ -267,34 +319,68 @@ extern Gaggle HurdLib_Gaggle_Init(void)
 
 	/* Allocate the object and internal state. */
 	retn.object_size  = sizeof(struct HurdLib_Gaggle);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Gaggle_Compact);
 	retn.state_size   = sizeof(struct HurdLib_Gaggle_State);
 	if ( !root->init(root, HurdLib_LIBID, HurdLib_Gaggle_OBJID, &retn) )
 		return NULL;
-	this	    	  = retn.object;
-	this->state 	  = retn.state;
-	this->state->root = root;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Gaggle_Compact) this)->methods = &Gaggle_methods;
+		((Gaggle_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Gaggle_methods;
+		this->state = S;
+	}
+	S->root = root;
 
 	/* Initialize object state. */
-	_init_state(this->state);
+	_init_state(S);
 
 	/* Initialize aggregate objects. */
-	INIT(HurdLib, Buffer, this->state->gaggle, goto fail);
-
-	/* Method initialization. */
-	this->add = add;
-	this->get = get;
-
-	this->size	    = size;
-	this->rewind_cursor = rewind_cursor;
-
-	this->whack = whack;
+	INIT(HurdLib, Buffer, S->gaggle, goto fail);
 
 	return this;
 
 
 fail:
-	WHACK(this->state->gaggle);
+	WHACK(S->gaggle);
 
-	root->whack(root, this, this->state);
+	root->whack(root, this, S);
 	return NULL;
 }
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Gaggle object.
+ *
+ * \return	A pointer to the initialized Gaggle.  A null value
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Gaggle HurdLib_Gaggle_Init(void)
+
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Gaggle object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Gaggle object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Gaggle_Compact HurdLib_Gaggle_Init_compact(void)
+
+{
+	return _create(true);
+}
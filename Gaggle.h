@@ -42,6 +42,8 @@ typedef struct HurdLib_Gaggle * Gaggle;
 
 typedef struct HurdLib_Gaggle_State * Gaggle_State;
 
+typedef struct HurdLib_Gaggle_Compact * Gaggle_Compact;
+
 
 /**
  * External Gaggle object representation.
@@ -62,7 +64,23 @@ struct HurdLib_Gaggle
 };
 
 
+/**
+ * Compact Gaggle object representation.  The object refers to the
+ * method table shared by all Gaggle objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Gaggle_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Gaggle *methods;
+
+	/* Private state. */
+	Gaggle_State state;
+};
+
+
 /* Gaggle constructor call. */
 extern Gaggle HurdLib_Gaggle_Init(void);
+extern Gaggle_Compact HurdLib_Gaggle_Init_compact(void);
 
 #endif
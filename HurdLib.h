@@ -33,6 +33,18 @@
 #define INIT(lib, obj, var, action) \
 	if ( (var = _CCALL(lib,obj,Init)()) == NULL ) action
 
+/*
+ * Macros for objects in the compact representation, which refer to
+ * the method table of their type rather than holding the methods.
+ * A compact object is only used through these macros, it cannot be
+ * passed to a method which expects an object of the full type.
+ */
+#define CINIT(lib, obj, var, action) \
+	if ( (var = _CCALL(lib,obj,Init_compact)()) == NULL ) action
+#define CALL(obj, method, ...) \
+	(obj)->methods->method((void *) (obj), ##__VA_ARGS__)
+#define CWHACK(obj) if (obj != NULL) {CALL(obj, whack); obj = NULL;}
+
 /* Macro to clear and initialize the status of an object. */
 #define OBJ_STATE(lib, obj) struct lib##_##obj##_##State
 
@@ -61,4 +73,8 @@
 #define HurdLib_File_OBJID		6
 #define HurdLib_Gaggle_OBJID		7
 #define HurdLib_Process_OBJID		8
+#define HurdLib_Chain_OBJID		9
+#define HurdLib_Ring_OBJID		10
+#define HurdLib_Checksum_OBJID		11
+#define HurdLib_Compressor_OBJID	12
 #endif
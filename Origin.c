@@ -9,10 +9,16 @@
  **************************************************************************/
 
 /* Include files. */
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <execinfo.h>
 
 #include "HurdLib.h"
 #include "Origin.h"
@@ -28,20 +34,343 @@
 #endif
 
 
+/* The cache line size which unified allocations are aligned to. */
+#define ORIGIN_CACHELINE 64
+
+/* Number of slots in the object pool table. */
+#define ORIGIN_POOLS 64
+
+/* Maximum number of blocks held in a per-thread pool cache. */
+#define ORIGIN_THREAD_CACHE 32
+
+/* The default size of an allocation region chunk. */
+#define ORIGIN_CHUNK 16384
+
+/*
+ * The number of objects a thread may allocate or release before its
+ * live object count is added to the shared per-type total.
+ */
+#define ORIGIN_LIVE_BATCH 16
+
+/* The number of hash buckets and stack frames used by the profiler. */
+#define ORIGIN_SITES 256
+#define ORIGIN_SAMPLE_DEPTH 32
+
 /*
- * Static function declarations. These need to be located before 
+ * The default number of free blocks which each object pool will
+ * retain.  Pooling is disabled when building for memory debugging so
+ * that the debugging allocator sees every allocation and release.
+ */
+#if defined(DMALLOC)
+#define ORIGIN_HIGH_WATER 0
+#else
+#define ORIGIN_HIGH_WATER 256
+#endif
+
+
+/*
+ * Static function declarations. These need to be located before
  * HurdLib_Origin structure definition below.
  */
 static _Bool init(const Origin, int, int, struct HurdLib_Origin_Retn *);
 static void whack(const Origin, void *, void *);
 static void iprint(const Origin, int, char const *, ...);
+static void set_layout(const Origin, enum Origin_layout);
+static _Bool region_push(const Origin);
+static _Bool region_pop(const Origin);
+static _Bool pool_limit(const Origin, int, int, size_t);
+static void pool_trim(const Origin);
+static _Bool pool_stats(const Origin, int, int, \
+			struct HurdLib_Origin_Pool_Stats *);
+static void account(const Origin, void *, long int);
+static _Bool object_stats(const Origin, int, int, \
+			  struct HurdLib_Origin_Object_Stats *);
+static size_t snapshot(const Origin, struct HurdLib_Origin_Object_Stats *, \
+		       size_t);
+static void dump(const Origin, int);
+static void profile(const Origin, unsigned int);
+static _Bool profile_dump(const Origin, int);
+
+static void _object_name(int const, int const, char * const, size_t const);
+
+
+/**
+ * The following enumeration defines the methods which are used to
+ * allocate an object block and thus how the block is to be released.
+ */
+enum origin_source {
+	origin_pooled=0,
+	origin_malloc,
+	origin_split,
+	origin_region
+};
+
+
+/**
+ * The following union defines the header which precedes each object
+ * allocation.  In the unified layout the object and its state are
+ * carved out of a single block which follows the header.  The header
+ * is padded to the strictest fundamental alignment so that the object
+ * which follows it is suitably aligned.
+ */
+union origin_header {
+	struct {
+		/*
+		 * The pool servicing the object type, the counters of
+		 * the pool are updated regardless of how the block was
+		 * allocated.
+		 */
+		struct origin_pool *pool;
+
+		/* The method used to allocate the block. */
+		enum origin_source source;
+
+		union {
+			/* Link to the next block on a free list. */
+			union origin_header *next;
+
+			/* The region a block was allocated from. */
+			struct origin_region *region;
+		};
+
+		/* The allocation site of a sampled block. */
+		struct origin_site *site;
+	};
+
+	max_align_t align;
+};
+
+
+/**
+ * The following structure defines a free list of allocation blocks
+ * for a single library/object identifier pair.  The list is shared
+ * by all threads and is refilled from, and drained to, the per-thread
+ * caches in batches.
+ */
+struct origin_pool
+{
+	/*
+	 * The pool key, a combination of the library and object
+	 * identifiers.  A value of zero indicates an unused slot.
+	 */
+	_Atomic uint64_t key;
+
+	/* The library and object identifiers served by the pool. */
+	int libid;
+	int objid;
+
+	/* The size of the block, a value of zero indicates not yet known. */
+	_Atomic size_t size;
+
+	/* The maximum number of blocks retained by the pool. */
+	_Atomic size_t high_water;
+
+	/*
+	 * The number of live objects of the type which have been
+	 * added from the thread shards and the largest value which
+	 * has been observed.
+	 */
+	atomic_long live;
+	atomic_long peak;
+
+	/* Lock protecting the members which follow. */
+	pthread_mutex_t lock;
+
+	/* The number of blocks held by the pool. */
+	size_t cached;
+
+	/* The number of blocks released because the pool was full. */
+	unsigned long int trimmed;
+
+	/* The list of free blocks. */
+	union origin_header *free;
+};
+
+
+/**
+ * The following structure defines an allocation site recorded by the
+ * sampling profiler.  Sites are identified by the object type and
+ * the call stack of the allocation and are retained for the life of
+ * the process.
+ */
+struct origin_site
+{
+	/* The next site in the hash bucket. */
+	struct origin_site *next;
+
+	/* The library and object identifiers of the sampled objects. */
+	int libid;
+	int objid;
+
+	/* The call stack of the allocation, innermost frame first. */
+	int depth;
+	void *frames[ORIGIN_SAMPLE_DEPTH];
+
+	/* The number of sampled objects which have not been released. */
+	atomic_long live;
+
+	/* The total number of objects sampled at the site. */
+	atomic_long sampled;
+};
+
+
+/**
+ * The following structure defines a chunk of memory which objects
+ * in an allocation region are carved from.
+ */
+struct origin_chunk
+{
+	/* The next chunk in the region. */
+	struct origin_chunk *next;
+
+	/* The size of the chunk and the amount which has been used. */
+	size_t size;
+	size_t used;
+
+	/* The chunk memory. */
+	max_align_t data[];
+};
+
+
+/**
+ * The following structure defines an allocation region.  Objects
+ * allocated while a region is active are carved sequentially from
+ * its chunks and the memory is released when the region is popped.
+ */
+struct origin_region
+{
+	/* The enclosing region. */
+	struct origin_region *outer;
+
+	/*
+	 * The number of objects which have not been released, plus a
+	 * reference held by the thread which owns the region.  Objects
+	 * may be whacked by other threads, the region is released by
+	 * whichever thread drops the count to zero.
+	 */
+	atomic_long live;
+
+	/* The number of unreleased objects of each pooled type. */
+	atomic_long objects[ORIGIN_POOLS];
+
+	/* The list of chunks, the first chunk is the current chunk. */
+	struct origin_chunk *chunks;
+};
+
+
+/**
+ * The following structure defines one shard of the allocation
+ * counters.  Each thread owns a shard which only it updates, so the
+ * counters can be maintained without locked instructions while
+ * remaining safe to read from other threads.  The shard of an
+ * exiting thread is folded into a shared shard.
+ */
+struct origin_shard
+{
+	/* The number of objects allocated less those released. */
+	_Alignas(ORIGIN_CACHELINE) atomic_long init_count;
+
+	/* Pool allocation statistics. */
+	atomic_long hits[ORIGIN_POOLS];
+	atomic_long misses[ORIGIN_POOLS];
+
+	/* The total number of objects of each type allocated. */
+	atomic_long allocated[ORIGIN_POOLS];
+
+	/*
+	 * The number of objects of each type allocated less those
+	 * released which have not yet been added to the pool total.
+	 */
+	atomic_long live[ORIGIN_POOLS];
+
+	/* The bytes of backing store reported by each object type. */
+	atomic_long bytes[ORIGIN_POOLS];
+};
+
+
+/**
+ * The following structure defines the per-thread allocation state.
+ * It holds a small free list for each pool which is used without
+ * locking.
+ */
+struct origin_thread
+{
+	/* Flag indicating the thread exit handler has been armed. */
+	_Bool registered;
+
+	/* The list of registered threads. */
+	struct origin_thread *next;
+	struct origin_thread *prev;
+
+	/* The accounting shard owned by the thread. */
+	struct origin_shard shard;
+
+	/* The innermost active allocation region. */
+	struct origin_region *region;
+
+	/* The number of allocations until the next profiler sample. */
+	unsigned int countdown;
+
+	/* The per-pool block caches. */
+	struct {
+		union origin_header *free;
+		size_t count;
+	} cache[ORIGIN_POOLS];
+};
 
 
 /** Origin private state information. */
 struct HurdLib_Origin_State
 {
-	unsigned int init_count;
-} state = { 0 };
+	/* The layout used for object allocation. */
+	_Atomic enum Origin_layout layout;
+
+	/* The high water mark applied to newly created pools. */
+	_Atomic size_t high_water;
+
+	/*
+	 * Lock serializing the creation of pools and the list of
+	 * threads.
+	 */
+	pthread_mutex_t lock;
+
+	/* The table of object pools. */
+	struct origin_pool pools[ORIGIN_POOLS];
+
+	/* The threads which have allocated objects. */
+	struct origin_thread *threads;
+
+	/* The accounting shard of threads which have exited. */
+	struct origin_shard retired;
+
+	/*
+	 * The profiler sampling interval, zero disables sampling, and
+	 * the interval used to scale the recorded samples.
+	 */
+	_Atomic unsigned int sample_rate;
+	_Atomic unsigned int sample_scale;
+
+	/* Lock protecting the table of allocation sites. */
+	pthread_mutex_t site_lock;
+
+	/* The hash table of profiled allocation sites. */
+	struct origin_site *sites[ORIGIN_SITES];
+} state = {
+	.layout	    = Origin_layout_unified,
+	.high_water = ORIGIN_HIGH_WATER,
+	.lock	    = PTHREAD_MUTEX_INITIALIZER,
+	.site_lock  = PTHREAD_MUTEX_INITIALIZER
+};
+
+
+/* One-time initialization control and the thread exit key. */
+static pthread_once_t Once = PTHREAD_ONCE_INIT;
+
+static pthread_key_t Thread_key;
+
+/* The allocation state of the current thread. */
+static _Thread_local struct origin_thread Thread;
+
 
 /**
  * The root structure is the top of the object tree.
@@ -53,6 +382,23 @@ static struct HurdLib_Origin root = {
 	.whack  = whack,
 	.iprint = iprint,
 
+	.set_layout = set_layout,
+
+	.region_push = region_push,
+	.region_pop  = region_pop,
+
+	.pool_limit = pool_limit,
+	.pool_trim  = pool_trim,
+	.pool_stats = pool_stats,
+
+	.account      = account,
+	.object_stats = object_stats,
+	.snapshot     = snapshot,
+	.dump	      = dump,
+
+	.profile      = profile,
+	.profile_dump = profile_dump,
+
 	/* Private object state. */
 	.state = &state,
 };
@@ -63,145 +409,1735 @@ static Origin Root = &root;
 /**
  * Internal private function.
  *
- * This is an internal function which checks the consistency of object
- * allocation.  If a single object initializaiton is carried out an
- * atexit call is registered for this function.
+ * This function increments or decrements a counter in the accounting
+ * shard of the calling thread.  Since only the owning thread writes
+ * to its shard a relaxed load and store is sufficient.
+ *
+ * \param counter	A pointer to the counter to be updated.
+ *
+ * \param delta		The amount to be added to the counter.
  */
 
-static void _check_state(void)
+static inline void _count(atomic_long * const counter, long int const delta)
 
 {
-	if ( Root->state->init_count != 0 ) {
-		fprintf(stderr, "%s[%s]:\n", __FILE__, __FUNCTION__);
-		fprintf(stderr, "\tUnmatched object allocation, " \
-			"count = %d\n", Root->state->init_count);
-	}
-
+	atomic_store_explicit(counter, atomic_load_explicit(counter, \
+			      memory_order_relaxed) + delta, \
+			      memory_order_relaxed);
 	return;
 }
 
 
 /**
- * External public method.
+ * Internal private function.
  *
- * This function is the generic allocator function for all objects.  Object
- * allocation is centralized here so as to minimize the need to do
- * error checking in each constructor.  The object is also placed in the
- * pool table for tracking and reclamation.
+ * This function raises the peak live object count of a pool to the
+ * specified value if it is above the current peak.
  *
- * \param this:	The Origin object which is the base of all objects generated
- * 	        for the project.
+ * \param pool		A pointer to the pool whose peak is to be
+ *			updated.
  *
- * \param libid	The numeric identifier for the library which the the object
- *	        object is being initialized for.
- * 
- * \param objid	The numeric identifier for the object being initialized.
+ * \param live		The live object count which was observed.
+ */
+
+static void _raise_peak(struct origin_pool * const pool, long int const live)
+
+{
+	long int peak = atomic_load_explicit(&pool->peak, memory_order_relaxed);
+
+
+	while ( (live > peak) && \
+		!atomic_compare_exchange_weak(&pool->peak, &peak, live) )
+		continue;
+
+	return;
+}
+
+
+/**
+ * Internal private function.
  *
- * \param retn 	A pointer to a structure which contains the allocation amounts
- *	   	for the object structure and the internal state information of
- *		the object.  The object and state structure pointers will be
- *		returned in this structure.
+ * This function adds the live object count held in the shard of the
+ * calling thread to the total for the pool and updates the peak of
+ * the pool.
  *
- * \return	A boolean value is used to indicate success or failure of
- *		the base object allocation.  A false value indicates an
- *		error condition.
+ * \param S		A pointer to the Origin state containing the
+ *			pool table.
+ *
+ * \param slot		The index of the pool whose count is to be
+ *			added.
  */
 
-static _Bool init(CO(Origin, this), int const libid, int const objid, \
-		  struct HurdLib_Origin_Retn * const retn)
+static void _flush_live(CO(Origin_State, S), unsigned int const slot)
 
 {
-	static _Bool registered = 0;
+	long int live = atomic_load_explicit(&Thread.shard.live[slot], \
+					     memory_order_relaxed);
 
+	struct origin_pool *pool = &S->pools[slot];
 
-	/* Sanity checks. */
-	if ( (this != Root) || (retn == NULL) )
-		return false;
 
-	/* Object allocation. */
-	if ( (retn->object = malloc(retn->object_size)) == NULL )
-		return false;
+	if ( live == 0 )
+		return;
 
-	/* Internal state allocation. */
-	if ( (retn->state = malloc(retn->state_size)) == NULL ) {
-		free(retn->object);
-		return false;
-	}
+	atomic_store_explicit(&Thread.shard.live[slot], 0, \
+			      memory_order_relaxed);
+	live += atomic_fetch_add(&pool->live, live);
+	_raise_peak(pool, live);
 
-	/* Track object allocation count. */
-	this->state->init_count += 1;
-	if ( !registered ) {
-		if ( atexit(_check_state) != 0 ) {
-			fprintf(stderr, "%s[%s]: Failed atexit " \
-				" registration.\n", __FILE__, __FUNCTION__);
-		}
-		else
-			registered = 1;
-	}
+	return;
+}
 
-	return true;
+
+/**
+ * Internal private function.
+ *
+ * This function updates the live object count of a pool.  The count
+ * is accumulated in the shard of the calling thread and added to
+ * the shared total in batches so the shared counter is not updated
+ * on every allocation.  As a result the peak may be understated by
+ * up to ORIGIN_LIVE_BATCH objects for each thread.
+ *
+ * \param S		A pointer to the Origin state containing the
+ *			pool table.
+ *
+ * \param slot		The index of the pool whose count is to be
+ *			updated.
+ *
+ * \param delta		The change in the number of live objects.
+ */
+
+static inline void _count_live(CO(Origin_State, S), unsigned int const slot, \
+			       long int const delta)
+
+{
+	long int live;
+
+
+	_count(&Thread.shard.live[slot], delta);
+
+	live = atomic_load_explicit(&Thread.shard.live[slot], \
+				    memory_order_relaxed);
+	if ( (live >= ORIGIN_LIVE_BATCH) || (live <= -ORIGIN_LIVE_BATCH) )
+		_flush_live(S, slot);
+
+	return;
 }
 
 
 /**
- * External public method. 
+ * Internal private function.
  *
- * This function provides a varargs based print function which prepends
- * the output with a depth classifier.
+ * This function adds the counters in one accounting shard to those
+ * of a second shard.
  *
- * \param object	A pointer to the encapsulation object.
+ * \param sum		A pointer to the shard which the counters are
+ *			to be added to.
  *
- * \param offset	The current depth of the dump.
+ * \param shard		A pointer to the shard whose counters are to
+ *			be added.
+ */
+
+static void _add_shard(struct origin_shard * const sum, \
+		       struct origin_shard * const shard)
+
+{
+	unsigned int lp;
+
+
+	atomic_fetch_add(&sum->init_count, atomic_load(&shard->init_count));
+	for (lp= 0; lp < ORIGIN_POOLS; ++lp) {
+		atomic_fetch_add(&sum->hits[lp], atomic_load(&shard->hits[lp]));
+		atomic_fetch_add(&sum->misses[lp], \
+				 atomic_load(&shard->misses[lp]));
+		atomic_fetch_add(&sum->allocated[lp], \
+				 atomic_load(&shard->allocated[lp]));
+		atomic_fetch_add(&sum->live[lp], atomic_load(&shard->live[lp]));
+		atomic_fetch_add(&sum->bytes[lp], \
+				 atomic_load(&shard->bytes[lp]));
+	}
+
+	return;
+}
+
+
+/**
+ * Internal private function.
  *
- * \param fmt		The printf format string.
+ * This function sums the accounting shards of the retired threads
+ * and all live threads.
  *
- * \return		No return value is defines
+ * \param S		A pointer to the Origin state.
+ *
+ * \param sum		A pointer to the zero initialized shard which
+ *			will be populated with the totals.
  */
 
-static void iprint(const Origin this, int offset, char const * const fmt, ...)
+static void _sum_shards(CO(Origin_State, S), struct origin_shard * const sum)
 
 {
-	va_list ap;
+	struct origin_thread *tp;
 
-	while ( offset-- > 0 )
-		fputc('|', stderr);
 
-	va_start(ap, fmt);
-	vfprintf(stderr, fmt, ap);
-	va_end(ap);
+	pthread_mutex_lock(&S->lock);
 
+	_add_shard(sum, &S->retired);
+	for (tp= S->threads; tp != NULL; tp= tp->next)
+		_add_shard(sum, &tp->shard);
+
+	pthread_mutex_unlock(&S->lock);
 	return;
 }
 
 
 /**
- * External public method.
+ * Internal private function.
  *
- * This function implements a generic object destructor.  It releases
- * the memory allocated for the internal state and general object
- * description structure.  It also decrements the current allocated
- * object count.
+ * This is an internal function which checks the consistency of object
+ * allocation.  If a single object initializaiton is carried out an
+ * atexit call is registered for this function.
+ */
+
+static void _check_state(void)
+
+{
+	long int count;
+
+	struct origin_shard sum;
+
+
+	memset(&sum, '\0', sizeof(sum));
+	_sum_shards(Root->state, &sum);
+	count = atomic_load(&sum.init_count);
+
+	if ( count != 0 ) {
+		fprintf(stderr, "%s[%s]:\n", __FILE__, __FUNCTION__);
+		fprintf(stderr, "\tUnmatched object allocation, " \
+			"count = %ld\n", count);
+	}
+
+	pool_trim(Root);
+	return;
+}
+
+
+/**
+ * Internal private function.
  *
- * \param this		The object to be released/destroyed.
+ * This function releases blocks from a pool until the number of
+ * cached blocks is at or below the specified limit.  The caller is
+ * expected to hold the pool lock.
  *
- * \param object	A pointer to the public encapsulation object.
+ * \param pool		A pointer to the pool to be trimmed.
  *
- * \param state		A pointer to the internal object state.
+ * \param limit		The number of blocks which may remain in the
+ *			pool.
  */
 
-static void whack(CO(Origin, this), void * const object, void * const state)
+static void _trim_pool(struct origin_pool * const pool, size_t const limit)
 
 {
-	free(state);
-	free(object);
+	union origin_header *hdr;
+
 
-	if ( this->state->init_count > 0 )
-		this->state->init_count -= 1;
+	while ( pool->cached > limit ) {
+		hdr	   = pool->free;
+		pool->free = hdr->next;
+		--pool->cached;
+
+		free(hdr);
+	}
 
 	return;
 }
 
-	
+
+/**
+ * Internal private function.
+ *
+ * This function moves blocks from the calling thread's cache for a
+ * pool to the shared pool.  Blocks which would take the pool above
+ * its high water mark are released.
+ *
+ * \param S		A pointer to the Origin state containing the
+ *			pool table.
+ *
+ * \param slot		The index of the pool whose cache is to be
+ *			drained.
+ *
+ * \param keep		The number of blocks which are to be left in
+ *			the thread cache.
+ */
+
+static void _drain_cache(CO(Origin_State, S), unsigned int const slot, \
+			 size_t const keep)
+
+{
+	union origin_header *hdr;
+
+	struct origin_pool *pool = &S->pools[slot];
+
+
+	if ( Thread.cache[slot].count <= keep )
+		return;
+
+	pthread_mutex_lock(&pool->lock);
+
+	while ( Thread.cache[slot].count > keep ) {
+		hdr			 = Thread.cache[slot].free;
+		Thread.cache[slot].free  = hdr->next;
+		--Thread.cache[slot].count;
+
+		if ( pool->cached < atomic_load(&pool->high_water) ) {
+			hdr->next  = pool->free;
+			pool->free = hdr;
+			++pool->cached;
+		}
+		else {
+			++pool->trimmed;
+			free(hdr);
+		}
+	}
+
+	pthread_mutex_unlock(&pool->lock);
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function releases the chunks of an allocation region and the
+ * region itself.
+ *
+ * \param region	A pointer to the region to be released.
+ */
+
+static void _region_free(struct origin_region * const region)
+
+{
+	struct origin_chunk *chunk;
+
+
+	while ( (chunk = region->chunks) != NULL ) {
+		region->chunks = chunk->next;
+		free(chunk);
+	}
+	free(region);
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function reports the objects of an allocation region which
+ * have not been whacked.  The objects of the types served by a pool
+ * are itemized by type.
+ *
+ * \param S		A pointer to the Origin state.
+ *
+ * \param region	A pointer to the region to be reported.
+ *
+ * \param caller	The name of the function reporting the region.
+ */
+
+static void _region_report(CO(Origin_State, S), \
+			   struct origin_region * const region, \
+			   char const * const caller)
+
+{
+	char id[32];
+
+	unsigned int lp;
+
+	long int count;
+
+
+	fprintf(stderr, "%s[%s]:\n", __FILE__, caller);
+	fprintf(stderr, "\tUnreleased region objects, count = %ld\n", \
+		atomic_load(&region->live) - 1);
+
+	for (lp= 0; lp < ORIGIN_POOLS; ++lp) {
+		if ( (count = atomic_load(&region->objects[lp])) == 0 )
+			continue;
+		_object_name(S->pools[lp].libid, S->pools[lp].objid, id, \
+			     sizeof(id));
+		fprintf(stderr, "\t\t%s: %ld\n", id, count);
+	}
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function is registered as the destructor for the thread exit
+ * key.  It returns the blocks held by the exiting thread to the
+ * shared pools, releases any regions which it left active, adds its
+ * live object counts to the pool totals and folds its accounting
+ * shard into the shard of retired threads.  A region which still
+ * holds live objects is reported and left allocated, so the objects
+ * remain valid and are counted by the leak check at exit, and is
+ * released by the thread which whacks the last of them.
+ *
+ * The thread is left unregistered with an empty shard, so an object
+ * allocated or whacked by a later thread specific destructor sets the
+ * thread up again and re-arms this handler.
+ *
+ * \param arg	The value associated with the key, unused.
+ */
+
+static void _thread_exit(void *arg)
+
+{
+	CO(Origin_State, S) = Root->state;
+
+	unsigned int lp;
+
+	struct origin_region *region;
+
+
+	while ( (region = Thread.region) != NULL ) {
+		Thread.region = region->outer;
+		if ( atomic_load(&region->live) > 1 )
+			_region_report(S, region, __FUNCTION__);
+		if ( atomic_fetch_sub(&region->live, 1) == 1 )
+			_region_free(region);
+	}
+
+	for (lp= 0; lp < ORIGIN_POOLS; ++lp) {
+		_drain_cache(S, lp, 0);
+		_flush_live(S, lp);
+	}
+
+	pthread_mutex_lock(&S->lock);
+
+	_add_shard(&S->retired, &Thread.shard);
+
+	if ( Thread.prev != NULL )
+		Thread.prev->next = Thread.next;
+	else
+		S->threads = Thread.next;
+	if ( Thread.next != NULL )
+		Thread.next->prev = Thread.prev;
+
+	pthread_mutex_unlock(&S->lock);
+
+	memset(&Thread.shard, '\0', sizeof(Thread.shard));
+	Thread.registered = false;
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function carries out the one-time initialization of the
+ * Origin object.  It registers the exit time consistency check and
+ * the key used to drain the thread caches when a thread exits.
+ */
+
+static void _setup(void)
+
+{
+	if ( atexit(_check_state) != 0 ) {
+		fprintf(stderr, "%s[%s]: Failed atexit " \
+			" registration.\n", __FILE__, __FUNCTION__);
+	}
+
+	if ( pthread_key_create(&Thread_key, _thread_exit) != 0 ) {
+		fprintf(stderr, "%s[%s]: Failed thread key " \
+			" creation.\n", __FILE__, __FUNCTION__);
+	}
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function prepares the allocation state of the calling thread
+ * the first time it allocates an object.  The thread's accounting
+ * shard is added to the list of threads and its exit handler is
+ * armed.
+ *
+ * \param S	A pointer to the Origin state.
+ */
+
+static inline void _thread_setup(CO(Origin_State, S))
+
+{
+	if ( Thread.registered )
+		return;
+
+	pthread_once(&Once, _setup);
+
+	pthread_mutex_lock(&S->lock);
+	Thread.prev = NULL;
+	Thread.next = S->threads;
+	if ( S->threads != NULL )
+		S->threads->prev = &Thread;
+	S->threads = &Thread;
+	pthread_mutex_unlock(&S->lock);
+
+	pthread_setspecific(Thread_key, &Thread);
+	Thread.registered = true;
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function locates the pool which services the specified
+ * library and object identifier pair.  The pool table is a simple
+ * open addressed hash table indexed by the two identifiers.  Lookups
+ * are lock free, the creation of a pool is serialized.
+ *
+ * \param S		A pointer to the Origin state containing the
+ *			pool table.
+ *
+ * \param libid		The library identifier of the pool.
+ *
+ * \param objid		The object identifier of the pool.
+ *
+ * \param create	A flag variable used to indicate whether or not
+ *			a pool should be created if one does not exist.
+ *
+ * \return		A pointer to the pool is returned.  A NULL value
+ *			indicates the pool does not exist and could not
+ *			be created.
+ */
+
+static struct origin_pool *_find_pool(CO(Origin_State, S), int const libid, \
+				      int const objid, _Bool const create)
+
+{
+	unsigned int lp,
+		     slot;
+
+	uint64_t key,
+		 pool_key;
+
+	struct origin_pool *pool,
+			   *retn = NULL;
+
+
+	key  = ((uint64_t) (uint32_t) libid << 32) | (uint32_t) objid;
+	slot = ((unsigned int) libid * 31 + (unsigned int) objid) % \
+		ORIGIN_POOLS;
+
+	for (lp= 0; lp < ORIGIN_POOLS; ++lp) {
+		pool	 = &S->pools[(slot + lp) % ORIGIN_POOLS];
+		pool_key = atomic_load_explicit(&pool->key, \
+						memory_order_acquire);
+
+		if ( pool_key == key )
+			return pool;
+		if ( pool_key == 0 )
+			break;
+	}
+
+	if ( !create || (lp == ORIGIN_POOLS) )
+		return NULL;
+
+
+	/* Claim a slot while holding the table lock. */
+	pthread_mutex_lock(&S->lock);
+
+	for (lp= 0; lp < ORIGIN_POOLS; ++lp) {
+		pool	 = &S->pools[(slot + lp) % ORIGIN_POOLS];
+		pool_key = atomic_load_explicit(&pool->key, \
+						memory_order_relaxed);
+
+		if ( pool_key == key ) {
+			retn = pool;
+			break;
+		}
+
+		if ( pool_key == 0 ) {
+			pool->libid = libid;
+			pool->objid = objid;
+			atomic_store(&pool->high_water, \
+				     atomic_load(&S->high_water));
+			pthread_mutex_init(&pool->lock, NULL);
+
+			atomic_store_explicit(&pool->key, key, \
+					      memory_order_release);
+			retn = pool;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&S->lock);
+	return retn;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function carves a block out of the current chunk of an
+ * allocation region.  A new chunk is added to the region if the
+ * current chunk does not have sufficient space.
+ *
+ * \param region	A pointer to the region the block is to be
+ *			allocated from.
+ *
+ * \param size		The size of the block to be allocated.
+ *
+ * \return		A pointer to the block is returned.  A NULL
+ *			value indicates a new chunk could not be
+ *			allocated.
+ */
+
+static union origin_header *_region_alloc(struct origin_region * const region,
+					  size_t size)
+
+{
+	size_t chunk_size = ORIGIN_CHUNK;
+
+	struct origin_chunk *chunk = region->chunks;
+
+	union origin_header *retn;
+
+
+	size += sizeof(union origin_header) - 1;
+	size -= size % sizeof(union origin_header);
+
+	if ( (chunk == NULL) || ((chunk->size - chunk->used) < size) ) {
+		if ( size > chunk_size )
+			chunk_size = size;
+		if ( (chunk = malloc(sizeof(*chunk) + chunk_size)) == NULL )
+			return NULL;
+
+		chunk->size    = chunk_size;
+		chunk->used    = 0;
+		chunk->next    = region->chunks;
+		region->chunks = chunk;
+	}
+
+	retn	     = (union origin_header *) \
+		((unsigned char *) chunk->data + chunk->used);
+	chunk->used += size;
+	atomic_fetch_add(&region->live, 1);
+
+	return retn;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function implements the sampling decision of the allocation
+ * profiler.  Every sample_rate'th allocation made by a thread has
+ * its call stack recorded and is accounted to the allocation site
+ * identified by the stack and the object type.
+ *
+ * \param S		A pointer to the Origin state containing the
+ *			site table.
+ *
+ * \param libid		The library identifier of the object.
+ *
+ * \param objid		The object identifier of the object.
+ *
+ * \return		A pointer to the site the allocation is
+ *			accounted to is returned.  A NULL value
+ *			indicates the allocation was not sampled or
+ *			the site could not be recorded.
+ */
+
+static __attribute__((noinline)) struct origin_site * \
+_sample(CO(Origin_State, S), int const libid, int const objid)
+
+{
+	int lp,
+	    depth;
+
+	unsigned int rate = atomic_load_explicit(&S->sample_rate, \
+						 memory_order_relaxed);
+
+	uintptr_t hash;
+
+	void *frames[ORIGIN_SAMPLE_DEPTH + 2];
+
+	struct origin_site *site;
+
+
+	if ( (Thread.countdown == 0) || (Thread.countdown > rate) )
+		Thread.countdown = rate;
+	if ( --Thread.countdown != 0 )
+		return NULL;
+	Thread.countdown = rate;
+
+
+	/* Capture the stack without this function and the init method. */
+	if ( (depth = backtrace(frames, ORIGIN_SAMPLE_DEPTH + 2) - 2) < 0 )
+		depth = 0;
+
+	hash = (uintptr_t) libid * 31 + (uintptr_t) objid;
+	for (lp= 0; lp < depth; ++lp)
+		hash = hash * 1099511628211ULL ^ (uintptr_t) frames[lp + 2];
+
+
+	/* Locate or create the site. */
+	pthread_mutex_lock(&S->site_lock);
+
+	for (site= S->sites[hash % ORIGIN_SITES]; site != NULL; \
+		     site= site->next) {
+		if ( (site->libid == libid) && (site->objid == objid) && \
+		     (site->depth == depth) && \
+		     (memcmp(site->frames, &frames[2], \
+			     depth * sizeof(void *)) == 0) )
+			break;
+	}
+
+	if ( (site == NULL) && \
+	     ((site = calloc(1, sizeof(*site))) != NULL) ) {
+		site->libid = libid;
+		site->objid = objid;
+		site->depth = depth;
+		memcpy(site->frames, &frames[2], depth * sizeof(void *));
+
+		site->next		       = S->sites[hash % ORIGIN_SITES];
+		S->sites[hash % ORIGIN_SITES] = site;
+	}
+
+	pthread_mutex_unlock(&S->site_lock);
+
+	if ( site != NULL ) {
+		atomic_fetch_add(&site->live, 1);
+		atomic_fetch_add(&site->sampled, 1);
+	}
+
+	return site;
+}
+
+
+/**
+ * External public method.
+ *
+ * This function is the generic allocator function for all objects.  Object
+ * allocation is centralized here so as to minimize the need to do
+ * error checking in each constructor.
+ *
+ * In the default unified layout the object and its internal state are
+ * carved out of a single cache line aligned block of memory.  Blocks
+ * are taken from a cache held by the calling thread which is refilled
+ * from a shared per-object pool keyed by the library and object
+ * identifiers.  A new block is only allocated if both are empty.  The
+ * split layout uses separate allocations for the object and its
+ * state.  If the calling thread has an active allocation region, and
+ * the split layout is not selected, the block is carved from the
+ * region instead.
+ *
+ * \param this:	The Origin object which is the base of all objects generated
+ * 	        for the project.
+ *
+ * \param libid	The numeric identifier for the library which the the object
+ *	        object is being initialized for.
+ *
+ * \param objid	The numeric identifier for the object being initialized.
+ *
+ * \param retn 	A pointer to a structure which contains the allocation amounts
+ *	   	for the object structure and the internal state information of
+ *		the object.  The object and state structure pointers will be
+ *		returned in this structure.
+ *
+ * \return	A boolean value is used to indicate success or failure of
+ *		the base object allocation.  A false value indicates an
+ *		error condition.
+ */
+
+static _Bool init(CO(Origin, this), int const libid, int const objid, \
+		  struct HurdLib_Origin_Retn * const retn)
+
+{
+	CO(Origin_State, S) = this->state;
+
+	_Bool pooled = false;
+
+	unsigned int slot = 0;
+
+	size_t object_size,
+	       size,
+	       unsized = 0;
+
+	union origin_header *hdr;
+
+	struct origin_pool *pool;
+
+
+	/* Sanity checks. */
+	if ( (this != Root) || (retn == NULL) )
+		return false;
+
+	_thread_setup(S);
+
+	/*
+	 * Locate the pool for this object type.  The pool accounts for
+	 * every object of the type even if it does not supply the
+	 * block.
+	 */
+	if ( (pool = _find_pool(S, libid, objid, true)) != NULL )
+		slot = pool - S->pools;
+
+	/* Split layout allocation. */
+	if ( atomic_load_explicit(&S->layout, memory_order_relaxed) == \
+	     Origin_layout_split ) {
+		size = sizeof(union origin_header) + retn->object_size;
+		if ( (hdr = malloc(size)) == NULL )
+			return false;
+		if ( (retn->state = malloc(retn->state_size)) == NULL ) {
+			free(hdr);
+			return false;
+		}
+
+		hdr->source  = origin_split;
+		hdr->next    = NULL;
+		retn->object = hdr + 1;
+		goto done;
+	}
+
+	/*
+	 * Size the block so the state follows the object at the
+	 * alignment provided by the header.
+	 */
+	object_size  = retn->object_size + sizeof(union origin_header) - 1;
+	object_size -= object_size % sizeof(union origin_header);
+	size	     = sizeof(union origin_header) + object_size + \
+		retn->state_size;
+
+	/* Allocate from the active region of the thread. */
+	if ( Thread.region != NULL ) {
+		if ( (hdr = _region_alloc(Thread.region, size)) == NULL )
+			return false;
+
+		hdr->source  = origin_region;
+		hdr->region  = Thread.region;
+		retn->object = hdr + 1;
+		retn->state  = (unsigned char *) retn->object + object_size;
+
+		if ( pool != NULL )
+			atomic_fetch_add(&Thread.region->objects[slot], 1);
+		goto done;
+	}
+
+	/*
+	 * Round the block to a multiple of the cache line size so that
+	 * adjacent objects do not share a line.
+	 */
+	size += ORIGIN_CACHELINE - 1;
+	size -= size % ORIGIN_CACHELINE;
+
+	/*
+	 * A pool whose size does not match is bypassed and the block
+	 * is managed directly.
+	 */
+	if ( pool != NULL ) {
+		if ( atomic_load_explicit(&pool->size, memory_order_relaxed) \
+		     == 0 )
+			atomic_compare_exchange_strong(&pool->size, &unsized, \
+						       size);
+		pooled = atomic_load_explicit(&pool->size, \
+					      memory_order_relaxed) == size;
+	}
+
+	/* Refill an empty thread cache from the shared pool. */
+	if ( pooled && (Thread.cache[slot].free == NULL) ) {
+		pthread_mutex_lock(&pool->lock);
+		while ( (pool->free != NULL) && \
+			(Thread.cache[slot].count < ORIGIN_THREAD_CACHE / 2) ) {
+			hdr	   = pool->free;
+			pool->free = hdr->next;
+			--pool->cached;
+
+			hdr->next		= Thread.cache[slot].free;
+			Thread.cache[slot].free = hdr;
+			++Thread.cache[slot].count;
+		}
+		pthread_mutex_unlock(&pool->lock);
+	}
+
+	/* Block allocation. */
+	if ( pooled && (Thread.cache[slot].free != NULL) ) {
+		hdr			= Thread.cache[slot].free;
+		Thread.cache[slot].free = hdr->next;
+		--Thread.cache[slot].count;
+		_count(&Thread.shard.hits[slot], 1);
+	}
+	else {
+		if ( posix_memalign((void **) &hdr, ORIGIN_CACHELINE, size) \
+		     != 0 )
+			return false;
+		if ( pooled )
+			_count(&Thread.shard.misses[slot], 1);
+	}
+
+	hdr->source = pooled ? origin_pooled : origin_malloc;
+	hdr->next   = NULL;
+
+	retn->object = hdr + 1;
+	retn->state  = (unsigned char *) retn->object + object_size;
+
+
+ done:
+	/* Sample the allocation site if the profiler is enabled. */
+	hdr->site = NULL;
+	if ( __builtin_expect(atomic_load_explicit(&S->sample_rate, \
+			      memory_order_relaxed) != 0, 0) && \
+	     (hdr->source != origin_region) )
+		hdr->site = _sample(S, libid, objid);
+
+	/* Track object allocation counts. */
+	hdr->pool = pool;
+	if ( pool != NULL ) {
+		_count(&Thread.shard.allocated[slot], 1);
+		_count_live(S, slot, 1);
+	}
+	_count(&Thread.shard.init_count, 1);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This function provides a varargs based print function which prepends
+ * the output with a depth classifier.
+ *
+ * \param object	A pointer to the encapsulation object.
+ *
+ * \param offset	The current depth of the dump.
+ *
+ * \param fmt		The printf format string.
+ *
+ * \return		No return value is defines
+ */
+
+static void iprint(const Origin this, int offset, char const * const fmt, ...)
+
+{
+	va_list ap;
+
+	while ( offset-- > 0 )
+		fputc('|', stderr);
+
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This function implements a generic object destructor.  It returns
+ * the block holding the internal state and general object description
+ * structure to the cache of the calling thread.  When the cache fills
+ * half of it is drained to the shared pool, blocks beyond the pool's
+ * high water mark are released.  It also decrements the current
+ * allocated object count.
+ *
+ * \param this		The object to be released/destroyed.
+ *
+ * \param object	A pointer to the public encapsulation object.
+ *
+ * \param state		A pointer to the internal object state.
+ */
+
+static void whack(CO(Origin, this), void * const object, void * const state)
+
+{
+	CO(Origin_State, S) = this->state;
+
+	unsigned int slot = 0;
+
+	size_t limit;
+
+	union origin_header *hdr = (union origin_header *) object - 1;
+
+	struct origin_pool *pool = hdr->pool;
+
+	struct origin_region *region;
+
+
+	_thread_setup(S);
+
+	if ( __builtin_expect(hdr->site != NULL, 0) )
+		atomic_fetch_sub(&hdr->site->live, 1);
+
+	if ( pool != NULL ) {
+		slot = pool - S->pools;
+		_count_live(S, slot, -1);
+	}
+
+	switch ( hdr->source ) {
+		case origin_split:
+			free(state);
+			free(hdr);
+			break;
+
+		case origin_region:
+			region = hdr->region;
+			if ( pool != NULL )
+				atomic_fetch_sub(&region->objects[slot], 1);
+			if ( atomic_fetch_sub(&region->live, 1) == 1 )
+				_region_free(region);
+			break;
+
+		case origin_pooled:
+			limit = atomic_load_explicit(&pool->high_water, \
+						     memory_order_relaxed);
+			if ( limit > ORIGIN_THREAD_CACHE )
+				limit = ORIGIN_THREAD_CACHE;
+
+			hdr->next		= Thread.cache[slot].free;
+			Thread.cache[slot].free = hdr;
+			if ( ++Thread.cache[slot].count > limit )
+				_drain_cache(S, slot, limit / 2);
+			break;
+
+		case origin_malloc:
+			free(hdr);
+			break;
+	}
+
+	_count(&Thread.shard.init_count, -1);
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method selects the memory layout used for subsequent object
+ * allocations.  Objects which have already been allocated are
+ * released according to the layout they were allocated with.
+ *
+ * \param this		The Origin object whose allocation layout is
+ *			to be set.
+ *
+ * \param layout	The layout to be used.
+ */
+
+static void set_layout(CO(Origin, this), enum Origin_layout const layout)
+
+{
+	atomic_store(&this->state->layout, layout);
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method opens a new allocation region for the calling thread.
+ * Objects created by the thread while the region is the innermost
+ * active region are allocated sequentially from chunks owned by the
+ * region.  Releasing such an object with its whack method releases
+ * the resources it holds but not its memory, which is reclaimed when
+ * the region is popped.  Regions may be nested.  Objects allocated
+ * from a region may be whacked by any thread.
+ *
+ * \param this		The Origin object which the region is to be
+ *			created in.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the region was created.  A false value
+ *			indicates an allocation failure.
+ */
+
+static _Bool region_push(CO(Origin, this))
+
+{
+	unsigned int lp;
+
+	struct origin_region *region;
+
+
+	_thread_setup(this->state);
+
+	if ( (region = calloc(1, sizeof(*region))) == NULL )
+		return false;
+
+	atomic_init(&region->live, 1);
+	for (lp= 0; lp < ORIGIN_POOLS; ++lp)
+		atomic_init(&region->objects[lp], 0);
+	region->outer = Thread.region;
+
+	Thread.region = region;
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method closes the innermost allocation region of the calling
+ * thread and releases all of the memory allocated from it.  Every
+ * object allocated from the region must have been whacked first, so
+ * the resources the objects hold outside of the region are released
+ * by their destructors.  A region which still holds live objects is
+ * reported and left open, the objects remain valid and the region
+ * can be popped once they have been whacked.
+ *
+ * \param this		The Origin object whose region is to be
+ *			closed.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not a region was closed.  A false value
+ *			indicates the thread has no active region or
+ *			the region holds objects which have not been
+ *			whacked.
+ */
+
+static _Bool region_pop(CO(Origin, this))
+
+{
+	struct origin_region *region = Thread.region;
+
+
+	if ( region == NULL )
+		return false;
+	if ( atomic_load(&region->live) > 1 ) {
+		_region_report(this->state, region, __FUNCTION__);
+		return false;
+	}
+
+	Thread.region = region->outer;
+	_region_free(region);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method sets the number of free blocks which an object pool
+ * will retain.  Blocks released when a pool is at this high water
+ * mark are returned to the system allocator.  Each thread may hold
+ * up to a further ORIGIN_THREAD_CACHE blocks, bounded by the high
+ * water mark, in its private cache.  A value of zero disables pooling
+ * for the object type.
+ *
+ * \param this		The Origin object whose pools are to be
+ *			configured.
+ *
+ * \param libid		The library identifier of the pool to be
+ *			configured.
+ *
+ * \param objid		The object identifier of the pool to be
+ *			configured.  If both the library and object
+ *			identifiers are zero the limit is applied
+ *			to all current pools and becomes the default
+ *			for pools created subsequently.
+ *
+ * \param limit		The maximum number of blocks to be retained.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the limit was set.  A false value indicates
+ *			a pool could not be created for the object
+ *			type.
+ */
+
+static _Bool pool_limit(CO(Origin, this), int const libid, int const objid, \
+			size_t const limit)
+
+{
+	CO(Origin_State, S) = this->state;
+
+	unsigned int lp;
+
+	struct origin_pool *pool;
+
+
+	if ( (libid == 0) && (objid == 0) ) {
+		pthread_mutex_lock(&S->lock);
+		atomic_store(&S->high_water, limit);
+
+		for (lp= 0; lp < ORIGIN_POOLS; ++lp) {
+			pool = &S->pools[lp];
+			if ( atomic_load(&pool->key) == 0 )
+				continue;
+
+			atomic_store(&pool->high_water, limit);
+			_drain_cache(S, lp, limit < ORIGIN_THREAD_CACHE ? \
+				     limit / 2 : ORIGIN_THREAD_CACHE);
+
+			pthread_mutex_lock(&pool->lock);
+			_trim_pool(pool, limit);
+			pthread_mutex_unlock(&pool->lock);
+		}
+
+		pthread_mutex_unlock(&S->lock);
+		return true;
+	}
+
+	if ( (pool = _find_pool(S, libid, objid, true)) == NULL )
+		return false;
+
+	atomic_store(&pool->high_water, limit);
+	_drain_cache(S, pool - S->pools, limit < ORIGIN_THREAD_CACHE ? \
+		     limit / 2 : ORIGIN_THREAD_CACHE);
+
+	pthread_mutex_lock(&pool->lock);
+	_trim_pool(pool, limit);
+	pthread_mutex_unlock(&pool->lock);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method releases all of the free blocks held by the object
+ * pools, and by the cache of the calling thread, back to the system
+ * allocator.  The pool statistics and limits are retained.
+ *
+ * \param this		The Origin object whose pools are to be
+ *			trimmed.
+ */
+
+static void pool_trim(CO(Origin, this))
+
+{
+	CO(Origin_State, S) = this->state;
+
+	unsigned int lp;
+
+	struct origin_pool *pool;
+
+
+	for (lp= 0; lp < ORIGIN_POOLS; ++lp) {
+		pool = &S->pools[lp];
+		if ( atomic_load(&pool->key) == 0 )
+			continue;
+
+		_drain_cache(S, lp, 0);
+
+		pthread_mutex_lock(&pool->lock);
+		_trim_pool(pool, 0);
+		pthread_mutex_unlock(&pool->lock);
+	}
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the allocation statistics for the pool which
+ * services an object type.  The number of cached blocks includes
+ * those held by the calling thread but not those held by the caches
+ * of other threads.
+ *
+ * \param this		The Origin object whose pool statistics are
+ *			to be returned.
+ *
+ * \param libid		The library identifier of the pool.
+ *
+ * \param objid		The object identifier of the pool.
+ *
+ * \param stats		A pointer to the structure which will be
+ *			populated with the pool statistics.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not statistics were returned.  A false value
+ *			indicates no pool exists for the object type.
+ */
+
+static _Bool pool_stats(CO(Origin, this), int const libid, int const objid, \
+			struct HurdLib_Origin_Pool_Stats * const stats)
+
+{
+	CO(Origin_State, S) = this->state;
+
+	unsigned int slot;
+
+	struct origin_pool *pool;
+
+	struct origin_shard sum;
+
+
+	if ( stats == NULL )
+		return false;
+	if ( (pool = _find_pool(S, libid, objid, false)) == NULL )
+		return false;
+	slot = pool - S->pools;
+
+	memset(&sum, '\0', sizeof(sum));
+	_sum_shards(S, &sum);
+
+	stats->block_size = atomic_load(&pool->size);
+	stats->high_water = atomic_load(&pool->high_water);
+	stats->hits	  = atomic_load(&sum.hits[slot]);
+	stats->misses	  = atomic_load(&sum.misses[slot]);
+
+	pthread_mutex_lock(&pool->lock);
+	stats->cached  = pool->cached + Thread.cache[slot].count;
+	stats->trimmed = pool->trimmed;
+	pthread_mutex_unlock(&pool->lock);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method adjusts the number of bytes of backing store which are
+ * accounted to the type of an object.  Objects which manage memory
+ * outside of their Origin allocation call this method when that
+ * memory is allocated, resized or released.
+ *
+ * \param this		The Origin object which allocated the object.
+ *
+ * \param object	A pointer to the object whose backing store has
+ *			changed.
+ *
+ * \param delta		The change in the number of bytes held by the
+ *			object.
+ */
+
+static void account(CO(Origin, this), void * const object, \
+		    long int const delta)
+
+{
+	CO(Origin_State, S) = this->state;
+
+	union origin_header *hdr = (union origin_header *) object - 1;
+
+
+	if ( (hdr->pool == NULL) || (delta == 0) )
+		return;
+
+	_thread_setup(S);
+	_count(&Thread.shard.bytes[hdr->pool - S->pools], delta);
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function populates the accounting statistics for the object
+ * type serviced by a pool.  The live object count is exact once all
+ * allocating threads are quiescent, the peak is raised to the
+ * current live count if it is below it.
+ *
+ * \param S		A pointer to the Origin state containing the
+ *			pool table.
+ *
+ * \param pool		A pointer to the pool whose statistics are to
+ *			be returned.
+ *
+ * \param sum		A pointer to the summed accounting shards.
+ *
+ * \param stats		A pointer to the structure which will be
+ *			populated with the statistics.
+ */
+
+static void _object_stats(CO(Origin_State, S), \
+			  struct origin_pool * const pool, \
+			  struct origin_shard * const sum, \
+			  struct HurdLib_Origin_Object_Stats * const stats)
+
+{
+	unsigned int slot = pool - S->pools;
+
+	long int live;
+
+
+	live = atomic_load(&pool->live) + atomic_load(&sum->live[slot]);
+	if ( live < 0 )
+		live = 0;
+	_raise_peak(pool, live);
+
+	stats->libid	  = pool->libid;
+	stats->objid	  = pool->objid;
+	stats->live	  = live;
+	stats->peak	  = atomic_load(&pool->peak);
+	stats->allocated  = atomic_load(&sum->allocated[slot]);
+	stats->block_size = atomic_load(&pool->size);
+	stats->bytes	  = atomic_load(&sum->bytes[slot]);
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the accounting statistics for an object type.
+ *
+ * \param this		The Origin object whose statistics are to be
+ *			returned.
+ *
+ * \param libid		The library identifier of the object type.
+ *
+ * \param objid		The object identifier of the object type.
+ *
+ * \param stats		A pointer to the structure which will be
+ *			populated with the statistics.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not statistics were returned.  A false value
+ *			indicates no object of the type has been
+ *			allocated.
+ */
+
+static _Bool object_stats(CO(Origin, this), int const libid, \
+			  int const objid, \
+			  struct HurdLib_Origin_Object_Stats * const stats)
+
+{
+	CO(Origin_State, S) = this->state;
+
+	struct origin_pool *pool;
+
+	struct origin_shard sum;
+
+
+	if ( stats == NULL )
+		return false;
+	if ( (pool = _find_pool(S, libid, objid, false)) == NULL )
+		return false;
+
+	memset(&sum, '\0', sizeof(sum));
+	_sum_shards(S, &sum);
+	_object_stats(S, pool, &sum, stats);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method captures the accounting statistics of all object types
+ * which have been allocated.  The statistics of all types are taken
+ * from a single summation of the thread counters.
+ *
+ * \param this		The Origin object whose statistics are to be
+ *			returned.
+ *
+ * \param stats		A pointer to the array which will be populated
+ *			with the statistics.  A NULL value may be
+ *			used to query the number of object types.
+ *
+ * \param count		The number of elements in the array.
+ *
+ * \return		The number of object types is returned.  If
+ *			this is greater than the number of elements
+ *			in the array only the first count types were
+ *			returned.
+ */
+
+static size_t snapshot(CO(Origin, this), \
+		       struct HurdLib_Origin_Object_Stats * const stats, \
+		       size_t const count)
+
+{
+	CO(Origin_State, S) = this->state;
+
+	unsigned int lp;
+
+	size_t types = 0;
+
+	struct origin_pool *pool;
+
+	struct origin_shard sum;
+
+
+	memset(&sum, '\0', sizeof(sum));
+	_sum_shards(S, &sum);
+
+	for (lp= 0; lp < ORIGIN_POOLS; ++lp) {
+		pool = &S->pools[lp];
+		if ( atomic_load(&pool->key) == 0 )
+			continue;
+
+		if ( (stats != NULL) && (types < count) )
+			_object_stats(S, pool, &sum, &stats[types]);
+		++types;
+	}
+
+	return types;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function generates the name used to identify an object type
+ * in the statistics output.  Objects of this library are identified
+ * by name and all others by their library and object identifiers.
+ *
+ * \param libid		The library identifier of the object type.
+ *
+ * \param objid		The object identifier of the object type.
+ *
+ * \param name		A pointer to the buffer which the name is to
+ *			be written to.
+ *
+ * \param size		The size of the name buffer.
+ */
+
+static void _object_name(int const libid, int const objid, \
+			 char * const name, size_t const size)
+
+{
+	static const char * const names[] = {
+		[HurdLib_Origin_OBJID]	    = "Origin",
+		[HurdLib_Fibsequence_OBJID] = "Fibsequence",
+		[HurdLib_Buffer_OBJID]	    = "Buffer",
+		[HurdLib_String_OBJID]	    = "String",
+		[HurdLib_Config_OBJID]	    = "Config",
+		[HurdLib_File_OBJID]	    = "File",
+		[HurdLib_Gaggle_OBJID]	    = "Gaggle",
+		[HurdLib_Process_OBJID]	    = "Process",
+		[HurdLib_Chain_OBJID]	    = "Chain",
+		[HurdLib_Ring_OBJID]	    = "Ring",
+		[HurdLib_Checksum_OBJID]    = "Checksum",
+		[HurdLib_Compressor_OBJID]  = "Compressor"
+	};
+
+
+	if ( (libid == HurdLib_LIBID) && (objid > 0) && \
+	     (objid < sizeof(names) / sizeof(names[0])) && \
+	     (names[objid] != NULL) )
+		snprintf(name, size, "%s", names[objid]);
+	else
+		snprintf(name, size, "%d/%d", libid, objid);
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method prints a table of the accounting statistics of each
+ * object type.  The objects of this library are identified by name.
+ * Backing store bytes are accounted to the object which manages the
+ * memory, the storage of a String for example is reported by its
+ * Buffer.
+ *
+ * \param this		The Origin object whose statistics are to be
+ *			printed.
+ *
+ * \param offset	The number of levels to indent the output.
+ */
+
+static void dump(CO(Origin, this), int offset)
+
+{
+	char id[32];
+
+	size_t lp,
+	       types;
+
+	struct HurdLib_Origin_Object_Stats stats[ORIGIN_POOLS],
+					   *sp;
+
+
+	if ( offset == 0 )
+		offset = 1;
+
+	types = this->snapshot(this, stats, ORIGIN_POOLS);
+
+	this->iprint(this, offset, __FILE__ " dump: %zu object types\n", \
+		     types);
+	this->iprint(this, offset, "\t%-16s %10s %10s %12s %8s %14s\n", \
+		     "object", "live", "peak", "allocated", "block", \
+		     "bytes");
+
+	for (lp= 0; lp < types; ++lp) {
+		sp = &stats[lp];
+		_object_name(sp->libid, sp->objid, id, sizeof(id));
+		this->iprint(this, offset, "\t%-16s %10zu %10zu %12lu %8zu " \
+			     "%14ld\n", id, sp->live, sp->peak, sp->allocated, \
+			     sp->block_size, sp->bytes);
+	}
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method configures the allocation site profiler.  When enabled
+ * every rate'th object allocated by each thread has its call stack
+ * recorded.  Objects allocated from a region are not sampled.  The
+ * sites recorded are retained when the profiler is disabled.
+ *
+ * \param this		The Origin object which is to be profiled.
+ *
+ * \param rate		The sampling interval, a value of zero disables
+ *			the profiler.
+ */
+
+static void profile(CO(Origin, this), unsigned int const rate)
+
+{
+	CO(Origin_State, S) = this->state;
+
+
+	if ( rate != 0 )
+		atomic_store(&S->sample_scale, rate);
+	atomic_store(&S->sample_rate, rate);
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function generates the name of a stack frame from the symbol
+ * information returned by the backtrace_symbols function.  Frames
+ * without a symbol name are identified by their module and offset,
+ * or by their address if no symbol information is available.
+ *
+ * \param symbol	A pointer to the symbol information for the
+ *			frame.
+ *
+ * \param frame		The return address of the frame.
+ *
+ * \param name		A pointer to the buffer which the name is to
+ *			be written to.
+ *
+ * \param size		The size of the name buffer.
+ */
+
+static void _frame_name(char const * const symbol, void * const frame, \
+			char * const name, size_t const size)
+
+{
+	char const *bp,
+		   *ep,
+		   *module;
+
+
+	if ( (symbol == NULL) || ((bp = strchr(symbol, '(')) == NULL) || \
+	     ((ep = strchr(bp, ')')) == NULL) ) {
+		snprintf(name, size, "%p", frame);
+		return;
+	}
+
+	if ( bp[1] != '+' ) {
+		snprintf(name, size, "%.*s", (int) strcspn(bp + 1, "+)"), \
+			 bp + 1);
+		return;
+	}
+
+	for (module= bp; (module > symbol) && (module[-1] != '/'); --module)
+		continue;
+	snprintf(name, size, "%.*s%.*s", (int) (bp - module), module, \
+		 (int) (ep - bp - 1), bp + 1);
+
+	return;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method writes the live object profile in the folded stack
+ * format used by flame graph tools.  Each line describes one
+ * allocation site with the object type followed by the frames of
+ * the call stack, outermost first, separated by semicolons.  The
+ * value which follows is the estimated number of live objects
+ * allocated at the site, the number of live samples scaled by the
+ * sampling interval.
+ *
+ * \param this		The Origin object whose profile is to be
+ *			output.
+ *
+ * \param fd		The file descriptor the profile is to be
+ *			written to.
+ *
+ * \return		A boolean value is used to indicate whether or
+ *			not the profile was written.  A false value
+ *			indicates an error in symbol lookup or output.
+ */
+
+static _Bool profile_dump(CO(Origin, this), int const fd)
+
+{
+	CO(Origin_State, S) = this->state;
+
+	_Bool retn = false;
+
+	char **symbols,
+	     id[32],
+	     name[256];
+
+	int lp;
+
+	unsigned int bucket,
+		     scale = atomic_load(&S->sample_scale);
+
+	long int live;
+
+	struct origin_site *site;
+
+
+	pthread_mutex_lock(&S->site_lock);
+
+	for (bucket= 0; bucket < ORIGIN_SITES; ++bucket) {
+		for (site= S->sites[bucket]; site != NULL; site= site->next) {
+			if ( (live = atomic_load(&site->live)) <= 0 )
+				continue;
+
+			symbols = backtrace_symbols(site->frames, site->depth);
+			if ( (symbols == NULL) && (site->depth > 0) )
+				goto done;
+
+			_object_name(site->libid, site->objid, id, sizeof(id));
+			if ( dprintf(fd, "%s", id) < 0 ) {
+				free(symbols);
+				goto done;
+			}
+
+			for (lp= site->depth - 1; lp >= 0; --lp) {
+				_frame_name(symbols[lp], site->frames[lp], \
+					    name, sizeof(name));
+				dprintf(fd, ";%s", name);
+			}
+			free(symbols);
+
+			if ( dprintf(fd, " %ld\n", live * scale) < 0 )
+				goto done;
+		}
+	}
+
+	retn = true;
+
+
+ done:
+	pthread_mutex_unlock(&S->site_lock);
+
+	return retn;
+}
+
+
 /**
  * External public function.
  *
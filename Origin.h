@@ -16,6 +16,20 @@ typedef struct HurdLib_Origin * Origin;
 
 typedef struct HurdLib_Origin_State * Origin_State;
 
+/**
+ * The following enumeration defines the memory layouts which can be
+ * used for object allocation.  The split layout places the object and
+ * its state in separate allocations and bypasses the object pools,
+ * it is primarily useful when debugging with an external memory
+ * checker.  The unified layout places the object and state in a
+ * single cache line aligned block.
+ */
+enum Origin_layout {
+	Origin_layout_split=0,
+	Origin_layout_unified
+};
+
+
 /**
  * The following struct is used to pass and return object information to
  * and from the generic object constructor.
@@ -32,6 +46,60 @@ struct HurdLib_Origin_Retn
 };
 
 
+/**
+ * The following structure is used to return the allocation statistics
+ * of the object pool which services a given library/object identifier
+ * pair.
+ */
+struct HurdLib_Origin_Pool_Stats
+{
+	/* The size of the combined object and state allocation. */
+	size_t block_size;
+
+	/* The number of blocks currently held in the pool. */
+	size_t cached;
+
+	/* The maximum number of blocks the pool will retain. */
+	size_t high_water;
+
+	/* The number of allocations satisfied from the pool. */
+	unsigned long int hits;
+
+	/* The number of allocations which required a new block. */
+	unsigned long int misses;
+
+	/* The number of blocks released because the pool was full. */
+	unsigned long int trimmed;
+};
+
+
+/**
+ * The following structure is used to return the accounting statistics
+ * for the objects of a given library/object identifier pair.
+ */
+struct HurdLib_Origin_Object_Stats
+{
+	/* The library and object identifiers of the object type. */
+	int libid;
+	int objid;
+
+	/* The number of objects currently allocated. */
+	size_t live;
+
+	/* The largest number of objects observed to be allocated. */
+	size_t peak;
+
+	/* The total number of objects which have been allocated. */
+	unsigned long int allocated;
+
+	/* The size of the pooled object and state allocation. */
+	size_t block_size;
+
+	/* The number of backing store bytes held by the objects. */
+	long int bytes;
+};
+
+
 /**
  * External Origin object representation.
  */
@@ -42,6 +110,26 @@ struct HurdLib_Origin
 	void (*whack)(const Origin, void *, void *);
 	void (*iprint)(const Origin, int, char const *, ...);
 
+	void (*set_layout)(const Origin, enum Origin_layout);
+
+	_Bool (*region_push)(const Origin);
+	_Bool (*region_pop)(const Origin);
+
+	_Bool (*pool_limit)(const Origin, int, int, size_t);
+	void (*pool_trim)(const Origin);
+	_Bool (*pool_stats)(const Origin, int, int, \
+			    struct HurdLib_Origin_Pool_Stats *);
+
+	void (*account)(const Origin, void *, long int);
+	_Bool (*object_stats)(const Origin, int, int, \
+			      struct HurdLib_Origin_Object_Stats *);
+	size_t (*snapshot)(const Origin, struct HurdLib_Origin_Object_Stats *, \
+			   size_t);
+	void (*dump)(const Origin, int);
+
+	void (*profile)(const Origin, unsigned int);
+	_Bool (*profile_dump)(const Origin, int);
+
 	/* Private state. */
 	Origin_State state;
 };
@@ -0,0 +1,234 @@
+/** \file
+ * This file contains a benchmark which compares the object allocation
+ * layouts supported by the Origin object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "HurdLib.h"
+#include "Origin.h"
+#include "Buffer.h"
+#include "String.h"
+
+
+/* Default number of benchmark iterations. */
+#define ITERATIONS 1000000
+
+/* Number of objects held live by the locality benchmark. */
+#define LIVE_OBJECTS 65536
+
+/* Number of objects created in each allocation region. */
+#define REGION_OBJECTS 64
+
+
+/**
+ * Private function.
+ *
+ * This function returns the current value of the monotonic clock in
+ * nanoseconds.
+ */
+
+static double now(void)
+
+{
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the cost of creating and destroying a
+ * String object, which also creates a Buffer and a Fibsequence.
+ *
+ * \param iterations	The number of create/destroy cycles to run.
+ *
+ * \param region	A flag used to indicate the objects are to be
+ *			created in allocation regions of REGION_OBJECTS
+ *			objects each.
+ *
+ * \return		The average number of nanoseconds per cycle.  A
+ *			negative value indicates an allocation failure.
+ */
+
+static double churn(unsigned long int const iterations, _Bool const region)
+
+{
+	unsigned long int lp;
+
+	double start;
+
+	String str = NULL;
+
+	Origin root = HurdLib_Origin_Init();
+
+
+	start = now();
+	for (lp= 0; lp < iterations; ++lp) {
+		if ( region && ((lp % REGION_OBJECTS) == 0) ) {
+			if ( lp > 0 )
+				root->region_pop(root);
+			if ( !root->region_push(root) )
+				return -1;
+		}
+
+		INIT(HurdLib, String, str, return -1);
+		WHACK(str);
+	}
+	if ( region )
+		root->region_pop(root);
+
+	return (now() - start) / iterations;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures method dispatch through a large population
+ * of Buffer objects.  Unrelated allocations are interleaved with the
+ * objects so that split allocations are scattered through the heap
+ * as they would be in a long running application.
+ *
+ * \param iterations	The number of method calls to run.
+ *
+ * \param region	A flag used to indicate the objects are to be
+ *			created in an allocation region.
+ *
+ * \return		The average number of nanoseconds per call.  A
+ *			negative value indicates an allocation failure.
+ */
+
+static double locality(unsigned long int const iterations, \
+		       _Bool const region)
+
+{
+	unsigned long int lp;
+
+	volatile size_t sum = 0;
+
+	double retn = -1,
+	       start;
+
+	Buffer bufr;
+
+	Origin root = HurdLib_Origin_Init();
+
+	static void *noise[LIVE_OBJECTS];
+
+	static Buffer bufrs[LIVE_OBJECTS];
+
+
+	for (lp= 0; lp < LIVE_OBJECTS; ++lp) {
+		bufrs[lp] = NULL;
+		noise[lp] = NULL;
+	}
+
+	if ( region && !root->region_push(root) )
+		return retn;
+	for (lp= 0; lp < LIVE_OBJECTS; ++lp) {
+		INIT(HurdLib, Buffer, bufrs[lp], goto done);
+		if ( (noise[lp] = malloc(lp % 256 + 16)) == NULL )
+			goto done;
+	}
+
+	start = now();
+	for (lp= 0; lp < iterations; ++lp) {
+		bufr = bufrs[(lp * 40503) % LIVE_OBJECTS];
+		sum += bufr->size(bufr);
+	}
+	retn = (now() - start) / iterations;
+
+
+ done:
+	for (lp= 0; lp < LIVE_OBJECTS; ++lp) {
+		WHACK(bufrs[lp]);
+		free(noise[lp]);
+	}
+	if ( region )
+		root->region_pop(root);
+
+	return retn;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned int lp;
+
+	unsigned long int iterations = ITERATIONS;
+
+	double churn_time,
+	       call_time;
+
+	Origin root = HurdLib_Origin_Init();
+
+	static const struct {
+		const char *name;
+		enum Origin_layout layout;
+		size_t limit;
+		_Bool region;
+		unsigned int sample;
+	} modes[] = {
+		{"split (two malloc)", Origin_layout_split,	0, false,  0},
+		{"unified",	       Origin_layout_unified,	0, false,  0},
+		{"unified + pool",     Origin_layout_unified, 256, false,  0},
+		{"region",	       Origin_layout_unified, 256, true,   0},
+		{"pool + profile/64",  Origin_layout_unified, 256, false, 64}
+	};
+
+
+	if ( argc > 1 )
+		iterations = strtoul(argv[1], NULL, 0);
+	if ( iterations == 0 ) {
+		fputs("Invalid iteration count.\n", stderr);
+		goto done;
+	}
+
+	fprintf(stdout, "%-20s %16s %16s\n", "Layout", "create/whack ns", \
+		"method call ns");
+
+	for (lp= 0; lp < sizeof(modes) / sizeof(modes[0]); ++lp) {
+		root->set_layout(root, modes[lp].layout);
+		root->pool_limit(root, 0, 0, modes[lp].limit);
+		root->profile(root, modes[lp].sample);
+
+		if ( (churn_time = churn(iterations, modes[lp].region)) < 0 )
+			goto done;
+		if ( (call_time = locality(iterations, modes[lp].region)) < 0 )
+			goto done;
+
+		fprintf(stdout, "%-20s %16.1f %16.1f\n", modes[lp].name, \
+			churn_time, call_time);
+	}
+
+	rc = 0;
+
+
+ done:
+	return rc;
+}
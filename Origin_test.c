@@ -0,0 +1,540 @@
+/** \file
+ * This file contains a unit test for the Origin object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "HurdLib.h"
+#include "Origin.h"
+#include "Buffer.h"
+#include "String.h"
+
+
+/* Number of threads and iterations used by the threaded test. */
+#define THREADS 4
+#define ITERATIONS 100000
+
+/* The barrier which starts the releasing threads together. */
+static pthread_barrier_t start;
+
+/* The key whose destructor whacks an object at thread exit. */
+static pthread_key_t Exit_key;
+
+
+/**
+ * Private function.
+ *
+ * This function prints the statistics for the Buffer object pool.
+ *
+ * \param root	The Origin object whose pool statistics are to be
+ *		printed.
+ *
+ * \param stats	A pointer to the structure which will be populated
+ *		with the statistics.
+ *
+ * \return	A boolean value is used to indicate whether or not
+ *		the statistics were available.
+ */
+
+static _Bool print_stats(CO(Origin, root), \
+			 struct HurdLib_Origin_Pool_Stats * const stats)
+
+{
+	if ( !root->pool_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+			       stats) ) {
+		fputs("No Buffer pool statistics available.\n", stderr);
+		return false;
+	}
+
+	fprintf(stdout, "Buffer pool: size=%zu, cached=%zu, limit=%zu, " \
+		"hits=%lu, misses=%lu, trimmed=%lu\n", stats->block_size, \
+		stats->cached, stats->high_water, stats->hits, stats->misses, \
+		stats->trimmed);
+
+	return true;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function is the entry point for the threads used to exercise
+ * concurrent object allocation.
+ *
+ * \param arg	Unused thread argument.
+ *
+ * \return	A NULL value is returned if all allocations succeeded.
+ */
+
+static void * worker(void *arg)
+
+{
+	unsigned int lp;
+
+	String str = NULL;
+
+
+	for (lp= 0; lp < ITERATIONS; ++lp) {
+		INIT(HurdLib, String, str, return arg);
+		if ( !str->add(str, "worker") )
+			return arg;
+		WHACK(str);
+	}
+
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function is the entry point for a thread which exits with an
+ * allocation region holding a live object.
+ *
+ * \param arg	A pointer to the location the object is to be
+ *		returned in.
+ *
+ * \return	A NULL value is returned if the object was created.
+ */
+
+static void * orphan(void *arg)
+
+{
+	Buffer *bufr = arg;
+
+	Origin root = HurdLib_Origin_Init();
+
+
+	if ( !root->region_push(root) )
+		return arg;
+	INIT(HurdLib, Buffer, *bufr, return arg);
+	if ( !(*bufr)->add(*bufr, (unsigned char *) "orphan", 6) )
+		return arg;
+
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function is the entry point for a thread which whacks an
+ * object allocated from the region of another thread.
+ *
+ * \param arg	A pointer to the object to be whacked.
+ *
+ * \return	A NULL value is returned if the object held its
+ *		contents.
+ */
+
+static void * release(void *arg)
+
+{
+	Buffer bufr = arg;
+
+
+	if ( memcmp(bufr->get(bufr), "shared", 6) != 0 )
+		return arg;
+	pthread_barrier_wait(&start);
+	WHACK(bufr);
+
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function is the destructor for the thread exit key.  It runs
+ * after the thread exit handler of the Origin object.
+ *
+ * \param arg	The object to be whacked.
+ */
+
+static void exit_whack(void *arg)
+
+{
+	Buffer bufr = arg;
+
+
+	WHACK(bufr);
+	return;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function is the entry point for a thread which leaves an
+ * object to be whacked by a thread specific destructor.
+ *
+ * \param arg	Unused thread argument.
+ *
+ * \return	A NULL value is returned if the object was created.
+ */
+
+static void * exiting(void *arg)
+
+{
+	Buffer bufr = NULL;
+
+
+	INIT(HurdLib, Buffer, bufr, return arg);
+	if ( !bufr->add(bufr, (unsigned char *) "exiting", 7) )
+		return arg;
+	if ( pthread_setspecific(Exit_key, bufr) != 0 )
+		return arg;
+
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function writes the allocation profile to a temporary file
+ * and reports whether any String objects are live in it.
+ *
+ * \param root	The Origin object whose profile is to be checked.
+ *
+ * \param live	A pointer to the variable which will be set to
+ *		indicate whether a String allocation site was found.
+ *
+ * \return	A boolean value is used to indicate whether or not
+ *		the profile was read.
+ */
+
+static _Bool profiled_strings(CO(Origin, root), _Bool * const live)
+
+{
+	_Bool retn = false;
+
+	char bufr[1024];
+
+	FILE *profile;
+
+
+	if ( (profile = tmpfile()) == NULL )
+		return false;
+	if ( !root->profile_dump(root, fileno(profile)) )
+		goto done;
+
+	*live = false;
+	rewind(profile);
+	while ( fgets(bufr, sizeof(bufr), profile) != NULL ) {
+		fputs(bufr, stdout);
+		if ( strncmp(bufr, "String;", 7) == 0 )
+			*live = true;
+	}
+	retn = true;
+
+
+ done:
+	fclose(profile);
+	return retn;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	_Bool live;
+
+	unsigned int lp;
+
+	unsigned long int allocated;
+
+	void *status;
+
+	pthread_t threads[THREADS];
+
+	Origin root = HurdLib_Origin_Init();
+
+	Buffer bufrs[8] = { NULL };
+
+	String strs[4] = { NULL };
+
+	struct HurdLib_Origin_Pool_Stats stats;
+
+	struct HurdLib_Origin_Object_Stats objects;
+
+
+	/* Allocate and release a set of objects to populate the pool. */
+	fputs("Populating Buffer pool.\n", stdout);
+	for (lp= 0; lp < 8; ++lp)
+		INIT(HurdLib, Buffer, bufrs[lp], goto done);
+	for (lp= 0; lp < 8; ++lp)
+		WHACK(bufrs[lp]);
+
+	if ( !print_stats(root, &stats) )
+		goto done;
+	if ( (stats.misses != 8) || (stats.cached != 8) ) {
+		fputs("Unexpected pool population.\n", stderr);
+		goto done;
+	}
+
+
+	/* Verify that re-allocation is satisfied from the pool. */
+	fputs("\nRe-allocating from Buffer pool.\n", stdout);
+	for (lp= 0; lp < 8; ++lp)
+		INIT(HurdLib, Buffer, bufrs[lp], goto done);
+
+	if ( !print_stats(root, &stats) )
+		goto done;
+	if ( (stats.hits != 8) || (stats.cached != 0) ) {
+		fputs("Allocation not satisfied from pool.\n", stderr);
+		goto done;
+	}
+
+
+	/* Verify high water trimming. */
+	fputs("\nReleasing with a high water mark of 2.\n", stdout);
+	if ( !root->pool_limit(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, 2) )
+		goto done;
+	for (lp= 0; lp < 8; ++lp)
+		WHACK(bufrs[lp]);
+
+	if ( !print_stats(root, &stats) )
+		goto done;
+	if ( (stats.cached > 4) || (stats.cached + stats.trimmed != 8) ) {
+		fputs("Pool not trimmed to high water mark.\n", stderr);
+		goto done;
+	}
+
+	root->pool_trim(root);
+	if ( !print_stats(root, &stats) )
+		goto done;
+	if ( stats.cached != 0 ) {
+		fputs("Pool not released.\n", stderr);
+		goto done;
+	}
+
+
+	/* Verify region allocation bypasses the pools. */
+	fputs("\nAllocating from nested regions.\n", stdout);
+	allocated = stats.hits + stats.misses;
+
+	if ( !root->region_push(root) )
+		goto done;
+	for (lp= 0; lp < 8; ++lp)
+		INIT(HurdLib, Buffer, bufrs[lp], goto done);
+	WHACK(bufrs[0]);
+
+	if ( !root->region_push(root) )
+		goto done;
+	INIT(HurdLib, Buffer, bufrs[0], goto done);
+	if ( !bufrs[0]->add(bufrs[0], (unsigned char *) "region", 6) )
+		goto done;
+
+	/* A region holding live objects is not popped. */
+	fputs("Expecting report of unreleased region object.\n", stdout);
+	if ( root->region_pop(root) ) {
+		fputs("Region popped with live object.\n", stderr);
+		goto done;
+	}
+	if ( (bufrs[0]->size(bufrs[0]) != 6) || \
+	     (memcmp(bufrs[0]->get(bufrs[0]), "region", 6) != 0) )
+		goto done;
+	WHACK(bufrs[0]);
+	if ( !root->region_pop(root) )
+		goto done;
+
+	if ( !bufrs[1]->add(bufrs[1], (unsigned char *) "region", 6) )
+		goto done;
+	for (lp= 1; lp < 8; ++lp)
+		WHACK(bufrs[lp]);
+	if ( !root->region_pop(root) )
+		goto done;
+
+	if ( root->region_pop(root) ) {
+		fputs("Region pop without active region.\n", stderr);
+		goto done;
+	}
+
+	/*
+	 * The region of a thread which exits with a live object remains
+	 * valid until the object is whacked.
+	 */
+	fputs("Expecting report of orphaned region object.\n", stdout);
+	if ( pthread_create(&threads[0], NULL, orphan, &bufrs[0]) != 0 )
+		goto done;
+	pthread_join(threads[0], &status);
+	if ( status != NULL )
+		goto done;
+	if ( memcmp(bufrs[0]->get(bufrs[0]), "orphan", 6) != 0 )
+		goto done;
+	WHACK(bufrs[0]);
+
+	/* Region objects may be whacked by other threads. */
+	if ( pthread_barrier_init(&start, NULL, THREADS) != 0 )
+		goto done;
+	if ( !root->region_push(root) )
+		goto done;
+	for (lp= 0; lp < THREADS; ++lp) {
+		INIT(HurdLib, Buffer, bufrs[lp], goto done);
+		if ( !bufrs[lp]->add(bufrs[lp], (unsigned char *) "shared", \
+				     6) )
+			goto done;
+	}
+	for (lp= 0; lp < THREADS; ++lp) {
+		if ( pthread_create(&threads[lp], NULL, release, \
+				    bufrs[lp]) != 0 )
+			goto done;
+	}
+	for (lp= 0; lp < THREADS; ++lp) {
+		pthread_join(threads[lp], &status);
+		if ( status != NULL )
+			goto done;
+		bufrs[lp] = NULL;
+	}
+	pthread_barrier_destroy(&start);
+	if ( !root->region_pop(root) ) {
+		fputs("Region not released by other threads.\n", stderr);
+		goto done;
+	}
+
+	if ( !print_stats(root, &stats) )
+		goto done;
+	if ( stats.hits + stats.misses != allocated ) {
+		fputs("Region allocation used object pool.\n", stderr);
+		goto done;
+	}
+
+
+	/* Verify accounting with concurrent allocation. */
+	fprintf(stdout, "\nAllocating from %d threads.\n", THREADS);
+	root->pool_limit(root, 0, 0, 256);
+	allocated = stats.hits + stats.misses;
+
+	for (lp= 0; lp < THREADS; ++lp) {
+		if ( pthread_create(&threads[lp], NULL, worker, \
+				    (void *) root) != 0 ) {
+			fputs("Unable to create thread.\n", stderr);
+			goto done;
+		}
+	}
+	for (lp= 0; lp < THREADS; ++lp) {
+		pthread_join(threads[lp], &status);
+		if ( status != NULL ) {
+			fputs("Thread allocation failed.\n", stderr);
+			goto done;
+		}
+	}
+
+	if ( !print_stats(root, &stats) )
+		goto done;
+	if ( stats.hits + stats.misses - allocated != THREADS * ITERATIONS ) {
+		fputs("Threaded allocation count mismatch.\n", stderr);
+		goto done;
+	}
+
+
+	/* Verify object accounting. */
+	fputs("\nAccounting for live objects.\n", stdout);
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_String_OBJID, \
+				 &objects) )
+		goto done;
+	if ( (objects.live != 0) || \
+	     (objects.allocated < THREADS * ITERATIONS) ) {
+		fputs("Unexpected String accounting.\n", stderr);
+		goto done;
+	}
+
+	for (lp= 0; lp < 8; ++lp) {
+		INIT(HurdLib, Buffer, bufrs[lp], goto done);
+		if ( !bufrs[lp]->reserve(bufrs[lp], 128) )
+			goto done;
+	}
+	root->dump(root, 0);
+
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &objects) )
+		goto done;
+	if ( (objects.live != 8) || (objects.peak < 8) || \
+	     (objects.bytes < 8 * 128) ) {
+		fputs("Unexpected Buffer accounting.\n", stderr);
+		goto done;
+	}
+
+	for (lp= 0; lp < 8; ++lp)
+		WHACK(bufrs[lp]);
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &objects) )
+		goto done;
+	if ( (objects.live != 0) || (objects.peak < 8) || \
+	     (objects.bytes != 0) ) {
+		fputs("Buffer release not accounted.\n", stderr);
+		goto done;
+	}
+
+	if ( pthread_key_create(&Exit_key, exit_whack) != 0 )
+		goto done;
+	if ( pthread_create(&threads[0], NULL, exiting, NULL) != 0 )
+		goto done;
+	pthread_join(threads[0], &status);
+	if ( status != NULL )
+		goto done;
+	if ( !root->object_stats(root, HurdLib_LIBID, HurdLib_Buffer_OBJID, \
+				 &objects) )
+		goto done;
+	if ( objects.live != 0 ) {
+		fputs("Buffer release at thread exit not accounted.\n", \
+		      stderr);
+		goto done;
+	}
+
+
+	/* Verify the allocation site profile. */
+	fputs("\nProfiling String allocations.\n", stdout);
+	root->profile(root, 1);
+	for (lp= 0; lp < 4; ++lp)
+		INIT(HurdLib, String, strs[lp], goto done);
+	root->profile(root, 0);
+
+	if ( !profiled_strings(root, &live) )
+		goto done;
+	if ( !live ) {
+		fputs("String allocation site not profiled.\n", stderr);
+		goto done;
+	}
+
+	for (lp= 0; lp < 4; ++lp)
+		WHACK(strs[lp]);
+	if ( !profiled_strings(root, &live) )
+		goto done;
+	if ( live ) {
+		fputs("String release not profiled.\n", stderr);
+		goto done;
+	}
+
+	rc = 0;
+
+
+ done:
+	for (lp= 0; lp < 8; ++lp)
+		WHACK(bufrs[lp]);
+	for (lp= 0; lp < 4; ++lp)
+		WHACK(strs[lp]);
+
+	return rc;
+}
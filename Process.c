@@ -28,7 +28,7 @@
 
 
 /* State initialization macro. */
-#define STATE(var) CO(Process_State, var) = this->state
+#define STATE(var) CO(Process_State, var) = _state(this)
 
 
 /* Verify library/object header file inclusions. */
@@ -91,6 +91,36 @@ static void _init_state(CO(Process_State, S)) {
 	return;
 }
 
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Process Process_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Process object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Process_State _state(CO(Process, this))
+
+{
+	const struct HurdLib_Process *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Process_methods )
+		return ((Process_Compact) this)->state;
+	return this->state;
+}
+
+
 
 /**
  * External public method.
@@ -189,7 +219,7 @@ static _Bool set_executable(CO(Process, this), CO(char *, executable))
 
 	/* Add the name of the executable. */
 	S->have_executable = true;
-	if ( !this->add_argument(this, executable) )
+	if ( !add_argument(this, executable) )
 		goto done;
 	retn = true;
 
@@ -235,7 +265,7 @@ static _Bool run(CO(Process, this))
 
 
 	/* Add the pointers to the new argv variable including a NULL. */
-	if ( !this->add_argument(this, NULL) )
+	if ( !add_argument(this, NULL) )
 		goto done;
 	argv_base = (char **) S->argv->get(S->argv);
 
@@ -293,19 +323,19 @@ static _Bool run_command(CO(Process, this), int argc, char *argv[])
 
 
 	/* Specify the executable as the first argument. */
-	if ( !this->set_executable(this, argv[0]) )
+	if ( !set_executable(this, argv[0]) )
 		goto done;
 
 
 	/* Add the remainder of the arguments. */
 	for (lp= 1; lp < argc; ++lp) {
-		if ( !this->add_argument(this, argv[lp]) )
+		if ( !add_argument(this, argv[lp]) )
 			goto done;
 	}
 
 
 	/* Execute the command. */
-	this->run(this);
+	run(this);
 
 
  done:
@@ -367,7 +397,7 @@ static _Bool run_command_line(CO(Process, this), int argc, char *argv[])
 
 	/* Execute the command-line. */
 	argc -= argv_size;
-	if ( !this->run_command(this, argc, &argv[argv_size]) )
+	if ( !run_command(this, argc, &argv[argv_size]) )
 			goto done;
 
 
@@ -399,21 +429,44 @@ static void whack(CO(Process, this))
 
 
 /**
- * External constructor call.
+ * The method table which is copied into each Process object by its
+ * constructor.
+ */
+static const struct HurdLib_Process Process_methods = {
+	.add_argument	= add_argument,
+	.set_executable	= set_executable,
+
+	.run			= run,
+	.run_command		= run_command,
+	.run_command_line	= run_command_line,
+
+	.whack	= whack,
+};
+
+
+/**
+ * Internal private function.
  *
- * This function implements a constructor call for a Process object.
+ * This function implements the construction of a Process object in either
+ * its full or its compact representation.
  *
- * \return	A pointer to the initialized Process.  A null value
- *		indicates an error was encountered in object generation.
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
  */
 
-extern Process HurdLib_Process_Init(void)
+static void *_create(_Bool const compact)
 
 {
 	Origin root;
 
 	Process this = NULL;
 
+	Process_State S;
+
 	struct HurdLib_Origin_Retn retn;
 
 
@@ -422,38 +475,70 @@ extern Process HurdLib_Process_Init(void)
 
 	/* Allocate the object and internal state. */
 	retn.object_size  = sizeof(struct HurdLib_Process);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Process_Compact);
 	retn.state_size   = sizeof(struct HurdLib_Process_State);
 	if ( !root->init(root, HurdLib_LIBID, HurdLib_Process_OBJID, &retn) )
 		return NULL;
-	this	    	  = retn.object;
-	this->state 	  = retn.state;
-	this->state->root = root;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Process_Compact) this)->methods = &Process_methods;
+		((Process_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Process_methods;
+		this->state = S;
+	}
+	S->root = root;
 
 	/* Initialize object state. */
-	_init_state(this->state);
+	_init_state(S);
 
 	/* Initialize aggregate objects. */
-	INIT(HurdLib, Buffer, this->state->argv, goto fail);
-	INIT(HurdLib, Gaggle, this->state->args, goto fail);
+	INIT(HurdLib, Buffer, S->argv, goto fail);
+	INIT(HurdLib, Gaggle, S->args, goto fail);
 
+	return this;
 
-	/* Method initialization. */
-	this->add_argument   = add_argument;
-	this->set_executable = set_executable;
 
-	this->run	       = run;
-	this->run_command      = run_command;
-	this->run_command_line = run_command_line;
+fail:
+	WHACK(S->argv);
+	WHACK(S->args);
 
-	this->whack = whack;
+	root->whack(root, this, S);
+	return NULL;
+}
 
-	return this;
 
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Process object.
+ *
+ * \return	A pointer to the initialized Process.  A null value
+ *		indicates an error was encountered in object generation.
+ */
 
-fail:
-	WHACK(this->state->argv);
-	WHACK(this->state->args);
+extern Process HurdLib_Process_Init(void)
 
-	root->whack(root, this, this->state);
-	return NULL;
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Process object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Process object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Process_Compact HurdLib_Process_Init_compact(void)
+
+{
+	return _create(true);
 }
@@ -19,6 +19,8 @@ typedef struct HurdLib_Process * Process;
 
 typedef struct HurdLib_Process_State * Process_State;
 
+typedef struct HurdLib_Process_Compact * Process_Compact;
+
 /**
  * External Process object representation.
  */
@@ -39,7 +41,23 @@ struct HurdLib_Process
 };
 
 
+/**
+ * Compact Process object representation.  The object refers to the
+ * method table shared by all Process objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Process_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Process *methods;
+
+	/* Private state. */
+	Process_State state;
+};
+
+
 /* Process constructor call. */
 extern Process HurdLib_Process_Init(void);
+extern Process_Compact HurdLib_Process_Init_compact(void);
 
 #endif
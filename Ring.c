@@ -0,0 +1,823 @@
+/** \file
+ * This file contains the implementation of a Ring object.  This
+ * object implements a bounded ring of bytes which is written by one
+ * producer thread and read by one consumer thread without locking.
+ * The ring can carry either a stream of bytes or a sequence of
+ * length prefixed records, a single ring should not be used for
+ * both.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "HurdLib.h"
+#include "Origin.h"
+#include "Buffer.h"
+#include "Ring.h"
+
+
+/* State initialization macro. */
+#define STATE(var) CO(Ring_State, var) = _state(this)
+
+
+/* Verify library/object header file inclusions. */
+#if !defined(HurdLib_LIBID)
+#error Library identifier not defined.
+#endif
+
+#if !defined(HurdLib_Ring_OBJID)
+#error Object identifier not defined.
+#endif
+
+
+/* The size of a processor cache line. */
+#define RING_CACHELINE 64
+
+/* The smallest capacity of a ring. */
+#define RING_MINIMUM 64
+
+/* The size of the length which prefixes each record. */
+#define RING_HEADER sizeof(uint32_t)
+
+
+/** Ring private state information. */
+struct HurdLib_Ring_State
+{
+	/* The root object. */
+	Origin root;
+
+	/* Library identifier. */
+	uint32_t libid;
+
+	/* Object identifier. */
+	uint32_t objid;
+
+	/* Object status. */
+	_Bool poisoned;
+
+	/* The memory holding the ring and its size, a power of two. */
+	unsigned char *bf;
+	size_t capacity;
+
+	/*
+	 * The positions are free running counts of the bytes written
+	 * and read.  Each is written by only one of the threads and is
+	 * kept on its own cache line, along with that thread's most
+	 * recently seen value of the other position, so the threads
+	 * only exchange cache lines when the ring appears full or
+	 * empty.
+	 */
+	unsigned char pad1[RING_CACHELINE];
+
+	/* The producer's position and view of the consumer. */
+	atomic_size_t tail;
+	size_t head_seen;
+
+	unsigned char pad2[RING_CACHELINE];
+
+	/* The consumer's position and view of the producer. */
+	atomic_size_t head;
+	size_t tail_seen;
+
+	unsigned char pad3[RING_CACHELINE];
+};
+
+
+/**
+ * Internal private method.
+ *
+ * This method is responsible for initializing the HurdLib_Ring_State
+ * structure which holds state information for each instantiated object.
+ *
+ * \param S	A pointer to the object containing the state information
+ *		which is to be initialized.
+ */
+
+static void _init_state(CO(Ring_State, S)) {
+
+	S->libid = HurdLib_LIBID;
+	S->objid = HurdLib_Ring_OBJID;
+
+	S->poisoned = false;
+
+	S->bf	    = NULL;
+	S->capacity = 0;
+
+	atomic_init(&S->tail, 0);
+	S->head_seen = 0;
+	atomic_init(&S->head, 0);
+	S->tail_seen = 0;
+
+	return;
+}
+
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_Ring Ring_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a Ring object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline Ring_State _state(CO(Ring, this))
+
+{
+	const struct HurdLib_Ring *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &Ring_methods )
+		return ((Ring_Compact) this)->state;
+	return this->state;
+}
+
+
+
+/**
+ * Internal private function.
+ *
+ * This function copies bytes into the ring, wrapping around the end
+ * of the memory if needed.
+ *
+ * \param S	A pointer to the state of the ring.
+ *
+ * \param posn	The position at which the bytes are to be written.
+ *
+ * \param src	A pointer to the bytes to be written.
+ *
+ * \param cnt	The number of bytes to be written.
+ */
+
+static void _copy_in(CO(Ring_State, S), size_t const posn, \
+		     unsigned char const *src, size_t const cnt)
+
+{
+	size_t idx   = posn & (S->capacity - 1),
+	       first = S->capacity - idx;
+
+
+	if ( first > cnt )
+		first = cnt;
+	memcpy(S->bf + idx, src, first);
+	if ( cnt > first )
+		memcpy(S->bf, src + first, cnt - first);
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function copies bytes out of the ring, wrapping around the
+ * end of the memory if needed.
+ *
+ * \param S	A pointer to the state of the ring.
+ *
+ * \param posn	The position from which the bytes are to be read.
+ *
+ * \param dest	A pointer to the memory the bytes are to be copied to.
+ *
+ * \param cnt	The number of bytes to be read.
+ */
+
+static void _copy_out(CO(Ring_State, S), size_t const posn, \
+		      unsigned char *dest, size_t const cnt)
+
+{
+	size_t idx   = posn & (S->capacity - 1),
+	       first = S->capacity - idx;
+
+
+	if ( first > cnt )
+		first = cnt;
+	memcpy(dest, S->bf + idx, first);
+	if ( cnt > first )
+		memcpy(dest + first, S->bf, cnt - first);
+
+	return;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the space available to the producer.  The
+ * position of the consumer is only re-loaded if the last value seen
+ * does not leave enough space.
+ *
+ * \param S	A pointer to the state of the ring.
+ *
+ * \param tail	The position of the producer.
+ *
+ * \param need	The amount of space which is wanted.
+ *
+ * \return	The number of bytes which can be written.
+ */
+
+static inline size_t _room(CO(Ring_State, S), size_t const tail, \
+			   size_t const need)
+
+{
+	size_t room = S->capacity - (tail - S->head_seen);
+
+
+	if ( room < need ) {
+		S->head_seen = atomic_load_explicit(&S->head, \
+						    memory_order_acquire);
+		room = S->capacity - (tail - S->head_seen);
+	}
+
+	return room;
+}
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the number of bytes available to the
+ * consumer.  The position of the producer is only re-loaded if the
+ * last value seen does not cover the number of bytes wanted.
+ *
+ * \param S	A pointer to the state of the ring.
+ *
+ * \param head	The position of the consumer.
+ *
+ * \param need	The number of bytes which are wanted.
+ *
+ * \return	The number of bytes which can be read.
+ */
+
+static inline size_t _available(CO(Ring_State, S), size_t const head, \
+				size_t const need)
+
+{
+	size_t available = S->tail_seen - head;
+
+
+	if ( available < need ) {
+		S->tail_seen = atomic_load_explicit(&S->tail, \
+						    memory_order_acquire);
+		available = S->tail_seen - head;
+	}
+
+	return available;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method allocates the memory for the ring.  It must be called
+ * before the ring is shared between threads.  The capacity is rounded
+ * up to a power of two.
+ *
+ * \param this	A pointer to the object whose capacity is to be set.
+ *
+ * \param size	The minimum number of bytes the ring is to hold.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		ring was allocated.  A false value indicates the ring
+ *		already has a capacity or the memory could not be
+ *		allocated.
+ */
+
+static _Bool set_capacity(CO(Ring, this), size_t const size)
+
+{
+	STATE(S);
+
+	_Bool retn = false;
+
+	void *bf;
+
+	size_t capacity = RING_MINIMUM;
+
+
+	if ( S->poisoned || (S->bf != NULL) )
+		return false;
+	if ( (size == 0) || (size > SIZE_MAX / 2 + 1) )
+		goto done;
+
+	while ( capacity < size )
+		capacity *= 2;
+	if ( posix_memalign(&bf, RING_CACHELINE, capacity) != 0 )
+		goto done;
+
+	S->bf	    = bf;
+	S->capacity = capacity;
+	S->root->account(S->root, this, (long int) capacity);
+	retn = true;
+
+
+ done:
+	if ( !retn )
+		S->poisoned = true;
+
+	return retn;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of bytes to the ring by the
+ * producer.  As many of the bytes as will fit are added and made
+ * visible to the consumer at once.
+ *
+ * \param this	A pointer to the ring which bytes are to be added to.
+ *
+ * \param src	A pointer to the bytes which are to be added.
+ *
+ * \param cnt	The number of bytes which are to be added.
+ *
+ * \return	The number of bytes which were added.
+ */
+
+static size_t write(CO(Ring, this), unsigned char const * const src, \
+		    size_t cnt)
+
+{
+	STATE(S);
+
+	size_t tail,
+	       room;
+
+
+	if ( S->poisoned || (S->bf == NULL) || (cnt == 0) )
+		return 0;
+
+	tail = atomic_load_explicit(&S->tail, memory_order_relaxed);
+	if ( (room = _room(S, tail, cnt)) < cnt )
+		cnt = room;
+	if ( cnt == 0 )
+		return 0;
+
+	_copy_in(S, tail, src, cnt);
+	atomic_store_explicit(&S->tail, tail + cnt, memory_order_release);
+
+	return cnt;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the transfer of the contents of a Buffer to
+ * the ring by the producer.  As many bytes as will fit are added to
+ * the ring and consumed from the front of the Buffer, so the Buffer
+ * holds whatever remains to be sent.
+ *
+ * \param this	A pointer to the ring which bytes are to be added to.
+ *
+ * \param bufr	The object whose contents are to be added.
+ *
+ * \return	The number of bytes which were added.
+ */
+
+static size_t write_Buffer(CO(Ring, this), CO(Buffer, bufr))
+
+{
+	size_t cnt;
+
+
+	if ( bufr->poisoned(bufr) )
+		return 0;
+
+	cnt = write(this, bufr->get(bufr), bufr->size(bufr));
+	bufr->consume(bufr, NULL, cnt);
+
+	return cnt;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the removal of bytes from the ring by the
+ * consumer.
+ *
+ * \param this	A pointer to the ring which bytes are to be removed
+ *		from.
+ *
+ * \param dest	A pointer to the memory the bytes are to be copied to.
+ *
+ * \param cnt	The maximum number of bytes which are to be removed.
+ *
+ * \return	The number of bytes which were removed.
+ */
+
+static size_t read(CO(Ring, this), unsigned char * const dest, size_t cnt)
+
+{
+	STATE(S);
+
+	size_t head,
+	       available;
+
+
+	if ( S->poisoned || (S->bf == NULL) || (cnt == 0) )
+		return 0;
+
+	head = atomic_load_explicit(&S->head, memory_order_relaxed);
+	if ( (available = _available(S, head, cnt)) < cnt )
+		cnt = available;
+	if ( cnt == 0 )
+		return 0;
+
+	_copy_out(S, head, dest, cnt);
+	atomic_store_explicit(&S->head, head + cnt, memory_order_release);
+
+	return cnt;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the removal of bytes from the ring by the
+ * consumer into a Buffer.  The bytes are copied directly into the
+ * capacity of the Buffer.
+ *
+ * \param this	A pointer to the ring which bytes are to be removed
+ *		from.
+ *
+ * \param bufr	The object which the bytes are to be added to.
+ *
+ * \param cnt	The maximum number of bytes which are to be removed.
+ *		A value of zero removes all of the available bytes.
+ *
+ * \return	The number of bytes which were removed.
+ */
+
+static size_t read_Buffer(CO(Ring, this), CO(Buffer, bufr), size_t cnt)
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+	size_t head,
+	       available;
+
+
+	if ( S->poisoned || (S->bf == NULL) )
+		return 0;
+
+	if ( cnt == 0 )
+		cnt = S->capacity;
+	head = atomic_load_explicit(&S->head, memory_order_relaxed);
+	if ( (available = _available(S, head, cnt)) < cnt )
+		cnt = available;
+	if ( cnt == 0 )
+		return 0;
+
+	if ( (bp = bufr->extend(bufr, cnt)) == NULL )
+		return 0;
+	_copy_out(S, head, bp, cnt);
+	bufr->sum(bufr);
+	atomic_store_explicit(&S->head, head + cnt, memory_order_release);
+
+	return cnt;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of a record to the ring by the
+ * producer.  The record is added in its entirety or not at all.
+ *
+ * \param this	A pointer to the ring which the record is to be added
+ *		to.
+ *
+ * \param src	A pointer to the contents of the record.
+ *
+ * \param cnt	The size of the record.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		record was added.  A false value indicates the ring
+ *		does not have space for the record.
+ */
+
+static _Bool put(CO(Ring, this), unsigned char const * const src, \
+		 size_t const cnt)
+
+{
+	STATE(S);
+
+	uint32_t length = cnt;
+
+	size_t tail;
+
+
+	if ( S->poisoned || (S->bf == NULL) )
+		return false;
+	if ( (cnt > S->capacity - RING_HEADER) || (cnt > UINT32_MAX) )
+		return false;
+
+	tail = atomic_load_explicit(&S->tail, memory_order_relaxed);
+	if ( _room(S, tail, RING_HEADER + cnt) < RING_HEADER + cnt )
+		return false;
+
+	_copy_in(S, tail, (unsigned char *) &length, RING_HEADER);
+	if ( cnt > 0 )
+		_copy_in(S, tail + RING_HEADER, src, cnt);
+	atomic_store_explicit(&S->tail, tail + RING_HEADER + cnt, \
+			      memory_order_release);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the addition of the contents of a Buffer to
+ * the ring as a record.
+ *
+ * \param this	A pointer to the ring which the record is to be added
+ *		to.
+ *
+ * \param bufr	The object holding the contents of the record.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		record was added.  A false value indicates the ring
+ *		does not have space for the record.
+ */
+
+static _Bool put_Buffer(CO(Ring, this), CO(Buffer, bufr))
+
+{
+	if ( bufr->poisoned(bufr) )
+		return false;
+	return put(this, bufr->get(bufr), bufr->size(bufr));
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements the removal of the next record from the
+ * ring by the consumer.  The contents of the record are added to a
+ * Buffer.
+ *
+ * \param this	A pointer to the ring which the record is to be
+ *		removed from.
+ *
+ * \param bufr	The object which the record is to be added to.
+ *
+ * \return	A boolean value is used to indicate whether or not a
+ *		record was removed.  A false value indicates the ring
+ *		is empty or the Buffer could not be extended, in
+ *		which case the record remains in the ring.
+ */
+
+static _Bool take(CO(Ring, this), CO(Buffer, bufr))
+
+{
+	STATE(S);
+
+	unsigned char *bp;
+
+	uint32_t length;
+
+	size_t head;
+
+
+	if ( S->poisoned || (S->bf == NULL) )
+		return false;
+
+	head = atomic_load_explicit(&S->head, memory_order_relaxed);
+	if ( _available(S, head, RING_HEADER) < RING_HEADER )
+		return false;
+	_copy_out(S, head, (unsigned char *) &length, RING_HEADER);
+
+	/* The record was made visible along with its length. */
+	if ( length > 0 ) {
+		if ( (bp = bufr->extend(bufr, length)) == NULL )
+			return false;
+		_copy_out(S, head + RING_HEADER, bp, length);
+		bufr->sum(bufr);
+	}
+	atomic_store_explicit(&S->head, head + RING_HEADER + length, \
+			      memory_order_release);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the number of bytes held by the ring.  The
+ * value is only a snapshot when the ring is in use by other threads.
+ *
+ * \param this	A pointer to the object whose size is to be returned.
+ *
+ * \return	The number of bytes held by the ring, including the
+ *		lengths of any records.
+ */
+
+static size_t size(CO(Ring, this))
+
+{
+	STATE(S);
+
+	size_t head;
+
+
+	head = atomic_load_explicit(&S->head, memory_order_acquire);
+	return atomic_load_explicit(&S->tail, memory_order_acquire) - head;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the number of bytes the ring can hold.
+ *
+ * \param this	A pointer to the object whose capacity is to be
+ *		returned.
+ *
+ * \return	The capacity of the ring.
+ */
+
+static size_t capacity(CO(Ring, this))
+
+{
+	return _state(this)->capacity;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method returns the status of the object.
+ *
+ * \param this	A pointer to the object whose status is being
+ *		requested.
+ */
+
+static _Bool poisoned(CO(Ring, this))
+
+{
+	return _state(this)->poisoned;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements a destructor for a Ring object.
+ *
+ * \param this	A pointer to the object which is to be destroyed.
+ */
+
+static void whack(CO(Ring, this))
+
+{
+	STATE(S);
+
+
+	if ( S->bf != NULL ) {
+		free(S->bf);
+		S->root->account(S->root, this, -(long int) S->capacity);
+	}
+
+	S->root->whack(S->root, this, S);
+	return;
+}
+
+
+/**
+ * The method table which is copied into each Ring object by its
+ * constructor.
+ */
+static const struct HurdLib_Ring Ring_methods = {
+	.set_capacity	= set_capacity,
+
+	.write		= write,
+	.write_Buffer	= write_Buffer,
+	.read		= read,
+	.read_Buffer	= read_Buffer,
+
+	.put		= put,
+	.put_Buffer	= put_Buffer,
+	.take		= take,
+
+	.size		= size,
+	.capacity	= capacity,
+
+	.poisoned	= poisoned,
+	.whack		= whack,
+};
+
+
+/**
+ * Internal private function.
+ *
+ * This function implements the construction of a Ring object in either
+ * its full or its compact representation.
+ *
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
+ */
+
+static void *_create(_Bool const compact)
+
+{
+	Origin root;
+
+	Ring this = NULL;
+
+	Ring_State S;
+
+	struct HurdLib_Origin_Retn retn;
+
+
+	/* Get the root object. */
+	root = HurdLib_Origin_Init();
+
+	/* Allocate the object and internal state. */
+	retn.object_size  = sizeof(struct HurdLib_Ring);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_Ring_Compact);
+	retn.state_size   = sizeof(struct HurdLib_Ring_State);
+	if ( !root->init(root, HurdLib_LIBID, HurdLib_Ring_OBJID, &retn) )
+		return NULL;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((Ring_Compact) this)->methods = &Ring_methods;
+		((Ring_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = Ring_methods;
+		this->state = S;
+	}
+	S->root = root;
+
+	/* Initialize object state. */
+	_init_state(S);
+
+	return this;
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Ring object.
+ *
+ * \return	A pointer to the initialized Ring.  A null value
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Ring HurdLib_Ring_Init(void)
+
+{
+	return _create(false);
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a Ring object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized Ring object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern Ring_Compact HurdLib_Ring_Init_compact(void)
+
+{
+	return _create(true);
+}
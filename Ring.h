@@ -0,0 +1,76 @@
+/** \file
+ * This file contains API definitions for the Ring object which
+ * implements a bounded queue of bytes or records passed from one
+ * producer thread to one consumer thread without locking.  It should
+ * be included by any applications which desire to create or use this
+ * object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+#ifndef HurdLib_Ring_HEADER
+#define HurdLib_Ring_HEADER
+
+
+/* Object type definitions. */
+typedef struct HurdLib_Ring * Ring;
+
+typedef struct HurdLib_Ring_State * Ring_State;
+
+typedef struct HurdLib_Ring_Compact * Ring_Compact;
+
+
+/**
+ * External Ring object representation.
+ */
+struct HurdLib_Ring
+{
+	/* External methods. */
+	_Bool (*set_capacity)(const Ring, size_t);
+
+	size_t (*write)(const Ring, unsigned char const *, size_t);
+	size_t (*write_Buffer)(const Ring, const Buffer);
+	size_t (*read)(const Ring, unsigned char *, size_t);
+	size_t (*read_Buffer)(const Ring, const Buffer, size_t);
+
+	_Bool (*put)(const Ring, unsigned char const *, size_t);
+	_Bool (*put_Buffer)(const Ring, const Buffer);
+	_Bool (*take)(const Ring, const Buffer);
+
+	size_t (*size)(const Ring);
+	size_t (*capacity)(const Ring);
+
+	_Bool (*poisoned)(const Ring);
+	void (*whack)(const Ring);
+
+	/* Private state. */
+	Ring_State state;
+};
+
+
+/**
+ * Compact Ring object representation.  The object refers to the
+ * method table shared by all Ring objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_Ring_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_Ring *methods;
+
+	/* Private state. */
+	Ring_State state;
+};
+
+
+/* Ring constructor call. */
+extern HCLINK Ring HurdLib_Ring_Init(void);
+extern HCLINK Ring_Compact HurdLib_Ring_Init_compact(void);
+
+#endif
@@ -0,0 +1,499 @@
+/** \file
+ * This file contains a benchmark which measures the throughput and
+ * latency of passing data between two threads through a Ring object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "HurdLib.h"
+#include "Buffer.h"
+#include "Ring.h"
+
+
+/* The capacity of the rings which are measured. */
+#define RING_CAPACITY (256 * 1024)
+
+/* The number of bytes streamed for each transfer size. */
+#define STREAM_BYTES (1024 * 1024 * 1024)
+
+/* The default number of records and round trips. */
+#define ITERATIONS 1000000
+
+
+/**
+ * The following structure describes the work of the producer thread.
+ */
+struct transfer {
+	/* The ring the producer writes. */
+	Ring ring;
+
+	/* The ring the producer reads for round trips. */
+	Ring reply;
+
+	/* A queue protected by a lock used as the baseline. */
+	struct locked_queue *queue;
+
+	/* The size of each write or record. */
+	size_t size;
+
+	/* The number of bytes, records or round trips. */
+	size_t count;
+};
+
+
+/**
+ * The following structure implements a queue of records protected by
+ * a mutex, the approach used to pass data between threads before the
+ * Ring object was available.
+ */
+struct locked_queue {
+	pthread_mutex_t lock;
+	Buffer fifo;
+};
+
+
+/**
+ * Private function.
+ *
+ * This function returns the current value of the monotonic clock in
+ * nanoseconds.
+ *
+ * \return	The current time in nanoseconds.
+ */
+
+static double now(void)
+
+{
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements the producer of the streaming benchmark.
+ *
+ * \param arg	A pointer to the description of the transfer.
+ *
+ * \return	A null value.
+ */
+
+static void *stream_producer(void *arg)
+
+{
+	struct transfer *xfer = arg;
+
+	unsigned char *bf;
+
+	size_t sent,
+	       cnt;
+
+
+	if ( (bf = malloc(xfer->size)) == NULL )
+		return NULL;
+	memset(bf, 0xa5, xfer->size);
+
+	for (sent= 0; sent < xfer->count; sent += cnt) {
+		cnt = xfer->ring->write(xfer->ring, bf, xfer->size);
+		if ( cnt == 0 )
+			sched_yield();
+	}
+
+	free(bf);
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the rate at which bytes are streamed through
+ * a ring in writes and reads of a given size.
+ *
+ * \param size	The size of the writes and reads.
+ *
+ * \return	The transfer rate in GB/s.  A negative value indicates
+ *		the benchmark failed.
+ */
+
+static double stream(size_t const size)
+
+{
+	unsigned char *bf = NULL;
+
+	size_t received,
+	       cnt;
+
+	double start,
+	       rate = -1;
+
+	pthread_t thread;
+
+	struct transfer xfer;
+
+
+	memset(&xfer, '\0', sizeof(xfer));
+	xfer.size  = size;
+	xfer.count = STREAM_BYTES;
+
+	if ( (bf = malloc(size)) == NULL )
+		goto done;
+	INIT(HurdLib, Ring, xfer.ring, goto done);
+	if ( !xfer.ring->set_capacity(xfer.ring, RING_CAPACITY) )
+		goto done;
+
+	start = now();
+	if ( pthread_create(&thread, NULL, stream_producer, &xfer) != 0 )
+		goto done;
+	for (received= 0; received < STREAM_BYTES; received += cnt) {
+		if ( (cnt = xfer.ring->read(xfer.ring, bf, size)) == 0 )
+			sched_yield();
+	}
+	pthread_join(thread, NULL);
+	rate = STREAM_BYTES / (now() - start);
+
+
+ done:
+	free(bf);
+	WHACK(xfer.ring);
+
+	return rate;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements the producer of the record benchmark.
+ * Records are added to either the ring or the locked queue.
+ *
+ * \param arg	A pointer to the description of the transfer.
+ *
+ * \return	A null value.
+ */
+
+static void *record_producer(void *arg)
+
+{
+	struct transfer *xfer = arg;
+
+	_Bool added;
+
+	uint32_t length = xfer->size;
+
+	size_t lp;
+
+	Buffer bufr = NULL;
+
+
+	INIT(HurdLib, Buffer, bufr, return NULL);
+	if ( bufr->extend(bufr, xfer->size) == NULL )
+		goto done;
+	memset(bufr->get(bufr), 0x5a, xfer->size);
+
+	for (lp= 0; lp < xfer->count; ++lp) {
+		if ( xfer->queue == NULL ) {
+			while ( !xfer->ring->put_Buffer(xfer->ring, bufr) )
+				sched_yield();
+			continue;
+		}
+
+		pthread_mutex_lock(&xfer->queue->lock);
+		added = xfer->queue->fifo->add(xfer->queue->fifo, \
+					       (unsigned char *) &length, \
+					       sizeof(length)) && \
+			xfer->queue->fifo->add_Buffer(xfer->queue->fifo, \
+						      bufr);
+		pthread_mutex_unlock(&xfer->queue->lock);
+		if ( !added )
+			goto done;
+	}
+
+
+ done:
+	WHACK(bufr);
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the cost of passing records of a given size
+ * through a ring or through a queue protected by a mutex.
+ *
+ * \param size		The size of the records.
+ *
+ * \param count		The number of records to be passed.
+ *
+ * \param locked	A flag used to indicate the locked queue is to
+ *			be used.
+ *
+ * \return		The average number of nanoseconds per record.  A
+ *			negative value indicates the benchmark failed.
+ */
+
+static double records(size_t const size, size_t const count, \
+		      _Bool const locked)
+
+{
+	_Bool taken;
+
+	uint32_t length;
+
+	size_t lp;
+
+	double start,
+	       time = -1;
+
+	pthread_t thread;
+
+	Buffer bufr = NULL;
+
+	struct transfer xfer;
+
+	struct locked_queue queue;
+
+
+	memset(&xfer, '\0', sizeof(xfer));
+	xfer.size  = size;
+	xfer.count = count;
+
+	pthread_mutex_init(&queue.lock, NULL);
+	queue.fifo = NULL;
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( locked ) {
+		INIT(HurdLib, Buffer, queue.fifo, goto done);
+		xfer.queue = &queue;
+	} else {
+		INIT(HurdLib, Ring, xfer.ring, goto done);
+		if ( !xfer.ring->set_capacity(xfer.ring, RING_CAPACITY) )
+			goto done;
+	}
+
+	start = now();
+	if ( pthread_create(&thread, NULL, record_producer, &xfer) != 0 )
+		goto done;
+
+	for (lp= 0; lp < count; ++lp) {
+		bufr->clear(bufr);
+		if ( !locked ) {
+			while ( !xfer.ring->take(xfer.ring, bufr) )
+				sched_yield();
+			continue;
+		}
+
+		do {
+			pthread_mutex_lock(&queue.lock);
+			taken = queue.fifo->consume(queue.fifo, \
+						    (unsigned char *) &length, \
+						    sizeof(length));
+			if ( taken ) {
+				queue.fifo->consume(queue.fifo, \
+						    bufr->extend(bufr, length), \
+						    length);
+			}
+			pthread_mutex_unlock(&queue.lock);
+			if ( !taken )
+				sched_yield();
+		} while ( !taken );
+	}
+
+	pthread_join(thread, NULL);
+	if ( bufr->size(bufr) != size )
+		goto done;
+	time = (now() - start) / count;
+
+
+ done:
+	pthread_mutex_destroy(&queue.lock);
+	WHACK(bufr);
+	WHACK(queue.fifo);
+	WHACK(xfer.ring);
+
+	return time;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements the thread which returns each message of
+ * the latency benchmark.
+ *
+ * \param arg	A pointer to the description of the transfer.
+ *
+ * \return	A null value.
+ */
+
+static void *echo(void *arg)
+
+{
+	struct transfer *xfer = arg;
+
+	unsigned char msg[8];
+
+	size_t lp,
+	       cnt;
+
+
+	for (lp= 0; lp < xfer->count; ++lp) {
+		for (cnt= 0; cnt < sizeof(msg);) {
+			cnt += xfer->ring->read(xfer->ring, msg + cnt, \
+						sizeof(msg) - cnt);
+			if ( cnt < sizeof(msg) )
+				sched_yield();
+		}
+		while ( xfer->reply->write(xfer->reply, msg, \
+					   sizeof(msg)) == 0 )
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function measures the round trip time of an eight byte message
+ * passed to another thread and back through a pair of rings.
+ *
+ * \param count		The number of round trips.
+ *
+ * \return		The average number of nanoseconds per round
+ *			trip.  A negative value indicates the benchmark
+ *			failed.
+ */
+
+static double latency(size_t const count)
+
+{
+	unsigned char msg[8];
+
+	size_t lp,
+	       cnt;
+
+	double start,
+	       time = -1;
+
+	pthread_t thread;
+
+	struct transfer xfer;
+
+
+	memset(&xfer, '\0', sizeof(xfer));
+	memset(msg, '\0', sizeof(msg));
+	xfer.count = count;
+
+	INIT(HurdLib, Ring, xfer.ring, goto done);
+	INIT(HurdLib, Ring, xfer.reply, goto done);
+	if ( !xfer.ring->set_capacity(xfer.ring, 64) || \
+	     !xfer.reply->set_capacity(xfer.reply, 64) )
+		goto done;
+
+	if ( pthread_create(&thread, NULL, echo, &xfer) != 0 )
+		goto done;
+
+	start = now();
+	for (lp= 0; lp < count; ++lp) {
+		while ( xfer.ring->write(xfer.ring, msg, sizeof(msg)) == 0 )
+			sched_yield();
+		for (cnt= 0; cnt < sizeof(msg);) {
+			cnt += xfer.reply->read(xfer.reply, msg + cnt, \
+						sizeof(msg) - cnt);
+			if ( cnt < sizeof(msg) )
+				sched_yield();
+		}
+	}
+	time = (now() - start) / count;
+	pthread_join(thread, NULL);
+
+
+ done:
+	WHACK(xfer.ring);
+	WHACK(xfer.reply);
+
+	return time;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	size_t size;
+
+	unsigned long int iterations = ITERATIONS;
+
+	double rate,
+	       time,
+	       locked_time;
+
+
+	if ( argc > 1 )
+		iterations = strtoul(argv[1], NULL, 0);
+	if ( iterations == 0 ) {
+		fputs("Invalid number of iterations.\n", stderr);
+		goto done;
+	}
+
+	fprintf(stdout, "byte stream: %u bytes, ring of %u bytes\n", \
+		STREAM_BYTES, RING_CAPACITY);
+	fprintf(stdout, "%-10s %10s\n", "Size", "GB/s");
+	for (size= 64; size <= 64 * 1024; size *= 16) {
+		if ( (rate = stream(size)) < 0 )
+			goto done;
+		fprintf(stdout, "%-10zu %10.3f\n", size, rate);
+	}
+
+	fprintf(stdout, "\nrecords: %lu per size, ns per record\n", \
+		iterations);
+	fprintf(stdout, "%-10s %10s %10s %10s\n", "Size", "locked", \
+		"ring", "speedup");
+	for (size= 16; size <= 4096; size *= 16) {
+		locked_time = records(size, iterations, true);
+		time	    = records(size, iterations, false);
+		if ( (locked_time < 0) || (time < 0) )
+			goto done;
+		fprintf(stdout, "%-10zu %10.1f %10.1f %9.1fx\n", size, \
+			locked_time, time, locked_time / time);
+	}
+
+	if ( (time = latency(iterations / 10)) < 0 )
+		goto done;
+	fprintf(stdout, "\nround trip latency: %.1f ns\n", time);
+
+	rc = 0;
+
+
+ done:
+	return rc;
+}
@@ -0,0 +1,333 @@
+/** \file
+ * This file contains a unit test for the Ring object.
+ */
+
+/**************************************************************************
+ * Copyright (c) 2026, Enjellic Systems Development, LLC. All rights reserved.
+ *
+ *
+ * Please refer to the file named COPYING in the top of the source tree
+ * for licensing information.
+ **************************************************************************/
+
+
+/* Include files. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "HurdLib.h"
+#include "Buffer.h"
+#include "Ring.h"
+
+
+/* The number of bytes streamed between the threads. */
+#define STREAM_BYTES (16 * 1024 * 1024)
+
+/* The number of records passed between the threads. */
+#define RECORDS 200000
+
+
+/**
+ * Private function.
+ *
+ * This function returns the value of the byte at a position in the
+ * stream of bytes passed through a ring.
+ *
+ * \param posn	The position of the byte.
+ *
+ * \return	The value of the byte.
+ */
+
+static inline unsigned char pattern(size_t const posn)
+
+{
+	return (posn * 131 + (posn >> 9)) & 0xff;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function implements the producer thread of the threaded tests.
+ * It streams bytes through the ring in uneven pieces, followed by a
+ * sequence of records.
+ *
+ * \param arg	The ring which is to be written.
+ *
+ * \return	A null value if the data was written, otherwise the
+ *		argument.
+ */
+
+static void *producer(void *arg)
+
+{
+	Ring ring = arg;
+
+	unsigned char piece[1000];
+
+	size_t lp,
+	       posn = 0,
+	       cnt,
+	       sent;
+
+	uint32_t record[64];
+
+	Buffer bufr = NULL;
+
+
+	while ( posn < STREAM_BYTES ) {
+		cnt = 1 + (posn * 7) % sizeof(piece);
+		if ( cnt > STREAM_BYTES - posn )
+			cnt = STREAM_BYTES - posn;
+		for (lp= 0; lp < cnt; ++lp)
+			piece[lp] = pattern(posn + lp);
+		for (sent= 0; sent < cnt;) {
+			if ( (lp = ring->write(ring, piece + sent, \
+					       cnt - sent)) == 0 )
+				sched_yield();
+			sent += lp;
+		}
+		posn += cnt;
+	}
+
+	/* Wait for the stream to be drained before sending records. */
+	while ( ring->size(ring) > 0 )
+		sched_yield();
+
+	INIT(HurdLib, Buffer, bufr, return arg);
+	for (lp= 0; lp < RECORDS; ++lp) {
+		for (cnt= 0; cnt <= lp % 64; ++cnt)
+			record[cnt] = lp;
+		bufr->reset(bufr);
+		if ( !bufr->add(bufr, (unsigned char *) record, \
+				cnt * sizeof(uint32_t)) )
+			return arg;
+		while ( !ring->put_Buffer(ring, bufr) )
+			sched_yield();
+	}
+	WHACK(bufr);
+
+	return NULL;
+}
+
+
+/**
+ * Private function.
+ *
+ * This function verifies the contents of a ring which is written by
+ * another thread.
+ *
+ * \param ring	The ring which is to be read.
+ *
+ * \return	A boolean value is used to indicate whether or not the
+ *		data read from the ring was correct.
+ */
+
+static _Bool consumer(CO(Ring, ring))
+
+{
+	_Bool retn = false;
+
+	unsigned char *bp;
+
+	size_t lp,
+	       posn = 0,
+	       cnt;
+
+	uint32_t *record;
+
+	Buffer bufr = NULL;
+
+
+	INIT(HurdLib, Buffer, bufr, goto done);
+	while ( posn < STREAM_BYTES ) {
+		bufr->reset(bufr);
+		if ( (cnt = ring->read_Buffer(ring, bufr, 0)) == 0 ) {
+			sched_yield();
+			continue;
+		}
+		bp = bufr->get(bufr);
+		for (lp= 0; lp < cnt; ++lp) {
+			if ( bp[lp] != pattern(posn + lp) ) {
+				fprintf(stderr, "Stream error at %zu.\n", \
+					posn + lp);
+				goto done;
+			}
+		}
+		posn += cnt;
+	}
+
+	for (lp= 0; lp < RECORDS; ++lp) {
+		bufr->reset(bufr);
+		while ( !ring->take(ring, bufr) )
+			sched_yield();
+		if ( bufr->size(bufr) != (lp % 64 + 1) * sizeof(uint32_t) )
+			goto done;
+		record = (uint32_t *) bufr->get(bufr);
+		for (cnt= 0; cnt <= lp % 64; ++cnt) {
+			if ( record[cnt] != lp ) {
+				fprintf(stderr, "Record error at %zu.\n", lp);
+				goto done;
+			}
+		}
+	}
+	retn = true;
+
+
+ done:
+	WHACK(bufr);
+
+	return retn;
+}
+
+
+/*
+ * Program entry point.
+ */
+
+extern int main(int argc, char *argv[])
+
+{
+	int rc = 1;
+
+	unsigned char bytes[300],
+		      out[300];
+
+	unsigned int lp;
+
+	size_t posn = 0,
+	       read = 0,
+	       cnt;
+
+	void *result;
+
+	pthread_t thread;
+
+	Buffer bufr = NULL;
+
+	Ring ring = NULL;
+
+
+	INIT(HurdLib, Ring, ring, goto done);
+	INIT(HurdLib, Buffer, bufr, goto done);
+
+	fputs("Sizing ring.\n", stdout);
+	if ( ring->write(ring, (unsigned char *) "A", 1) != 0 )
+		goto done;
+	if ( !ring->set_capacity(ring, 200) )
+		goto done;
+	if ( ring->set_capacity(ring, 400) || ring->poisoned(ring) )
+		goto done;
+	fprintf(stdout, "Capacity: %zu\n", ring->capacity(ring));
+	if ( ring->capacity(ring) != 256 )
+		goto done;
+
+	/* Stream bytes across the end of the ring. */
+	fputs("\nStreaming bytes.\n", stdout);
+	for (lp= 0; lp < 1000; ++lp) {
+		cnt = 1 + (lp * 37) % sizeof(bytes);
+		for (posn= 0; posn < cnt; ++posn)
+			bytes[posn] = pattern(read + ring->size(ring) + posn);
+		cnt = ring->write(ring, bytes, cnt);
+		if ( ring->size(ring) > ring->capacity(ring) )
+			goto done;
+
+		cnt = ring->read(ring, out, 1 + (lp * 53) % sizeof(out));
+		for (posn= 0; posn < cnt; ++posn) {
+			if ( out[posn] != pattern(read + posn) ) {
+				fprintf(stderr, "Stream error at %zu.\n", \
+					read + posn);
+				goto done;
+			}
+		}
+		read += cnt;
+	}
+	fprintf(stdout, "Bytes streamed: %zu\n", read);
+
+	/* Transfer bytes from and to Buffers. */
+	fputs("\nTransferring buffers.\n", stdout);
+	read += ring->read(ring, out, sizeof(out));
+	for (posn= 0; posn < sizeof(bytes); ++posn)
+		bytes[posn] = posn;
+	if ( !bufr->add(bufr, bytes, sizeof(bytes)) )
+		goto done;
+	if ( ring->write_Buffer(ring, bufr) != ring->capacity(ring) )
+		goto done;
+	if ( (bufr->size(bufr) != sizeof(bytes) - ring->capacity(ring)) || \
+	     (*bufr->get(bufr) != (unsigned char) ring->capacity(ring)) )
+		goto done;
+	bufr->reset(bufr);
+	if ( ring->read_Buffer(ring, bufr, 100) != 100 )
+		goto done;
+	if ( ring->read_Buffer(ring, bufr, 0) != ring->capacity(ring) - 100 )
+		goto done;
+	if ( (bufr->size(bufr) != ring->capacity(ring)) || \
+	     (memcmp(bufr->get(bufr), bytes, bufr->size(bufr)) != 0) )
+		goto done;
+	if ( ring->read_Buffer(ring, bufr, 0) != 0 )
+		goto done;
+
+	/* Pass records across the end of the ring. */
+	fputs("\nPassing records.\n", stdout);
+	for (lp= 0; lp < 1000; ++lp) {
+		memset(bytes, lp, sizeof(bytes));
+		cnt = (lp * 13) % 100;
+		if ( !ring->put(ring, bytes, cnt) )
+			goto done;
+		if ( (lp % 3) == 0 ) {
+			if ( !ring->put(ring, bytes, 0) )
+				goto done;
+		}
+
+		bufr->reset(bufr);
+		if ( !ring->take(ring, bufr) )
+			goto done;
+		if ( (bufr->size(bufr) != cnt) || \
+		     ((cnt > 0) && (memcmp(bufr->get(bufr), bytes, cnt) != 0)) )
+			goto done;
+		if ( (lp % 3) == 0 ) {
+			if ( !ring->take(ring, bufr) || \
+			     (bufr->size(bufr) != cnt) )
+				goto done;
+		}
+	}
+	if ( ring->take(ring, bufr) )
+		goto done;
+	if ( ring->put(ring, bytes, ring->capacity(ring)) )
+		goto done;
+	while ( ring->put(ring, bytes, 50) )
+		continue;
+	if ( ring->size(ring) + 54 <= ring->capacity(ring) )
+		goto done;
+	WHACK(ring);
+
+	/* Pass bytes and records between threads. */
+	fputs("\nPassing data between threads.\n", stdout);
+	INIT(HurdLib, Ring, ring, goto done);
+	if ( !ring->set_capacity(ring, 4096) )
+		goto done;
+	if ( pthread_create(&thread, NULL, producer, ring) != 0 )
+		goto done;
+	if ( !consumer(ring) ) {
+		fputs("Threaded transfer failed.\n", stderr);
+		goto done;
+	}
+	pthread_join(thread, &result);
+	if ( result != NULL )
+		goto done;
+	fprintf(stdout, "Bytes: %u, records: %u\n", STREAM_BYTES, RECORDS);
+
+	rc = 0;
+
+
+ done:
+	WHACK(bufr);
+	WHACK(ring);
+
+	return rc;
+}
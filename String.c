@@ -19,7 +19,7 @@
 #include "String.h"
 
 /* State initialization macro. */
-#define STATE(var) CO(String_State, var) = this->state
+#define STATE(var) CO(String_State, var) = _state(this)
 
 
 /* Verify library/object header file inclusions. */
@@ -73,6 +73,36 @@ static void _init_state(CO(String_State, S)) {
 	return;
 }
 
+/* The method table of the object, defined following the methods. */
+static const struct HurdLib_String String_methods;
+
+
+/**
+ * Internal private function.
+ *
+ * This function returns the state of a String object in either of its
+ * representations.  A compact object is recognized by its first
+ * member, which refers to the method table of the type rather than
+ * to a method.
+ *
+ * \param this	A pointer to the object whose state is to be returned.
+ *
+ * \return	A pointer to the state of the object.
+ */
+
+static inline String_State _state(CO(String, this))
+
+{
+	const struct HurdLib_String *methods;
+
+
+	memcpy(&methods, this, sizeof(methods));
+	if ( methods == &String_methods )
+		return ((String_Compact) this)->state;
+	return this->state;
+}
+
+
 
 /**
  * External public method.
@@ -97,7 +127,7 @@ static void _init_state(CO(String_State, S)) {
 static _Bool add(CO(String, this), CO(char *, src))
 
 {
-	String_State S = this->state;
+	String_State S = _state(this);
 
 
 	if ( S->buffer->poisoned(S->buffer) )
@@ -202,6 +232,150 @@ static _Bool add_sprintf(CO(String, this), CO(char *, fmt), ...)
 }
 
 
+/**
+ * External public method.
+ *
+ * This method implements appending the contents of a Buffer object,
+ * such as a view of a field within a larger payload, to the string.
+ * The contents must not contain a null character.
+ *
+ * \param this	A pointer to the object which the contents are to be
+ *		added to.
+ *
+ * \param bf	The Buffer object whose contents are to be added.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition.  A true value indicates success.
+ */
+
+static _Bool add_Buffer(CO(String, this), CO(Buffer, bf))
+
+{
+	STATE(S);
+
+	size_t size;
+
+	unsigned char *src,
+		      *bp;
+
+
+	if ( S->buffer->poisoned(S->buffer) || bf->poisoned(bf) )
+		return false;
+
+	if ( (src = bf->get(bf)) == NULL )
+		size = 0;
+	else
+		size = bf->size(bf);
+	if ( (size > 0) && (memchr(src, '\0', size) != NULL) )
+		return false;
+
+	S->buffer->shrink(S->buffer, 1);
+	if ( (bp = S->buffer->extend(S->buffer, size + 1)) == NULL )
+		return false;
+	if ( size > 0 )
+		memcpy(bp, src, size);
+	bp[size] = '\0';
+	S->buffer->sum(S->buffer);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements appending the lower case hexadecimal
+ * encoding of the contents of a Buffer object to the string.  The
+ * encoding is generated directly in the memory of the string.
+ *
+ * \param this	A pointer to the object which the encoding is to be
+ *		added to.
+ *
+ * \param bf	The Buffer object whose contents are to be encoded.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition.  A true value indicates success.
+ */
+
+static _Bool add_hex(CO(String, this), CO(Buffer, bf))
+
+{
+	STATE(S);
+
+	size_t size;
+
+	unsigned char *bp;
+
+
+	if ( S->buffer->poisoned(S->buffer) || bf->poisoned(bf) )
+		return false;
+	if ( bf->size(bf) > (SIZE_MAX - 1) / 2 )
+		return false;
+	size = 2 * bf->size(bf) + 1;
+
+	S->buffer->shrink(S->buffer, 1);
+	if ( (bp = S->buffer->extend(S->buffer, size)) == NULL )
+		return false;
+
+	if ( !bf->encode_hex(bf, (char *) bp, size) )
+		return false;
+	S->buffer->sum(S->buffer);
+
+	return true;
+}
+
+
+/**
+ * External public method.
+ *
+ * This method implements appending the base64 encoding of the
+ * contents of a Buffer object to the string.  The encoding is
+ * generated directly in the memory of the string.
+ *
+ * \param this	A pointer to the object which the encoding is to be
+ *		added to.
+ *
+ * \param bf	The Buffer object whose contents are to be encoded.
+ *
+ * \param mode	The alphabet which is to be used for the encoding.
+ *
+ * \return	A boolean value is used to indicate the success or
+ *		failure of the addition.  A true value indicates success.
+ */
+
+static _Bool add_base64(CO(String, this), CO(Buffer, bf), \
+			enum Buffer_base64 const mode)
+
+{
+	STATE(S);
+
+	size_t cnt,
+	       size;
+
+	unsigned char *bp;
+
+
+	if ( S->buffer->poisoned(S->buffer) || bf->poisoned(bf) )
+		return false;
+	if ( (cnt = bf->size(bf)) / 3 > (SIZE_MAX - 5) / 4 )
+		return false;
+
+	/* The URL alphabet is unpadded. */
+	size = 4 * (cnt / 3) + 1;
+	if ( (cnt % 3) != 0 )
+		size += (mode & Buffer_base64_url) ? cnt % 3 + 1 : 4;
+
+	S->buffer->shrink(S->buffer, 1);
+	if ( (bp = S->buffer->extend(S->buffer, size)) == NULL )
+		return false;
+
+	if ( !bf->encode_base64(bf, (char *) bp, size, mode) )
+		return false;
+	S->buffer->sum(S->buffer);
+
+	return true;
+}
+
 /**
  * External public method.
  *
@@ -218,10 +392,13 @@ static _Bool add_sprintf(CO(String, this), CO(char *, fmt), ...)
 static char * get(CO(String, this))
 
 {
-	if ( this->state->buffer->poisoned(this->state->buffer) )
+	STATE(S);
+
+
+	if ( S->buffer->poisoned(S->buffer) )
 		return NULL;
 
-	return (char *) this->state->buffer->get(this->state->buffer);
+	return (char *) S->buffer->get(S->buffer);
 }
 
 
@@ -240,7 +417,7 @@ static char * get(CO(String, this))
 static size_t size(CO(String, this))
 
 {
-	String_State S = this->state;
+	String_State S = _state(this);
 
 	size_t size = S->buffer->size(S->buffer);
 
@@ -268,7 +445,7 @@ static size_t size(CO(String, this))
 static void print(CO(String, this))
 
 {
-	String_State S = this->state;
+	String_State S = _state(this);
 
 
 	if ( S->buffer->poisoned(S->buffer) )
@@ -291,7 +468,10 @@ static void print(CO(String, this))
 static _Bool poisoned(CO(String, this))
 
 {
-	return this->state->buffer->poisoned(this->state->buffer);
+	STATE(S);
+
+
+	return S->buffer->poisoned(S->buffer);
 }
 
 
@@ -308,7 +488,10 @@ static _Bool poisoned(CO(String, this))
 static void reset(CO(String, this))
 
 {
-	return this->state->buffer->reset(this->state->buffer);
+	STATE(S);
+
+
+	return S->buffer->reset(S->buffer);
 }
 	
 	
@@ -323,7 +506,7 @@ static void reset(CO(String, this))
 static void whack(CO(String, this))
 
 {
-	String_State S = this->state;
+	String_State S = _state(this);
 
 
 	S->buffer->whack(S->buffer);
@@ -334,21 +517,50 @@ static void whack(CO(String, this))
 
 	
 /**
- * External constructor call.
+ * The method table which is copied into each String object by its
+ * constructor.
+ */
+static const struct HurdLib_String String_methods = {
+	.add		= add,
+	.add_sprintf	= add_sprintf,
+	.add_Buffer	= add_Buffer,
+	.add_hex	= add_hex,
+	.add_base64	= add_base64,
+
+	.get	= get,
+	.size	= size,
+
+	.print		= print,
+	.poisoned	= poisoned,
+
+	.reset	= reset,
+	.whack	= whack,
+};
+
+
+/**
+ * Internal private function.
  *
- * This function implements a constructor call for a String object.
+ * This function implements the construction of a String object in either
+ * its full or its compact representation.
  *
- * \return	A pointer to the initialized String object.  A null pointer
- *		indicates an error was encountered in object generation.
+ * \param compact	A flag used to indicate whether or not the compact
+ *			representation is to be constructed.
+ *
+ * \return		A pointer to the initialized object.  A null
+ *			pointer indicates an error was encountered in
+ *			object generation.
  */
 
-extern String HurdLib_String_Init(void)
+static void *_create(_Bool const compact)
 
 {
 	Origin root;
 
 	String this = NULL;
 
+	String_State S;
+
 	struct HurdLib_Origin_Retn retn;
 
 
@@ -357,36 +569,66 @@ extern String HurdLib_String_Init(void)
 
 	/* Allocate the object and internal state. */
 	retn.object_size  = sizeof(struct HurdLib_String);
+	if ( compact )
+		retn.object_size = sizeof(struct HurdLib_String_Compact);
 	retn.state_size   = sizeof(struct HurdLib_String_State);
 	if ( !root->init(root, HurdLib_LIBID, HurdLib_String_OBJID, &retn) )
 		return NULL;
-	this	    	  = retn.object;
-	this->state 	  = retn.state;
-	this->state->root = root;
+	this = retn.object;
+	S    = retn.state;
+	if ( compact ) {
+		((String_Compact) this)->methods = &String_methods;
+		((String_Compact) this)->state   = S;
+	}
+	else {
+		*this	    = String_methods;
+		this->state = S;
+	}
+	S->root = root;
 
 	/* Initialize aggregate objects. */
-	if ( (this->state->buffer = HurdLib_Buffer_Init()) == NULL ) {
-		root->whack(root, this, this->state);
+	if ( (S->buffer = HurdLib_Buffer_Init()) == NULL ) {
+		root->whack(root, this, S);
 		return NULL;
 	}
 
 	/* Initialize object state. */
-	_init_state(this->state);
+	_init_state(S);
+
+	return this;
+}
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a String object.
+ *
+ * \return	A pointer to the initialized String object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
+
+extern String HurdLib_String_Init(void)
 
-	/* Method initialization. */
-	this->add	  = add;
-	this->add_sprintf = add_sprintf;
+{
+	return _create(false);
+}
 
-	this->get	= get;
-	this->size	= size;
 
-	this->print	= print;
-	this->poisoned	= poisoned;
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a String object in its
+ * compact representation.
+ *
+ * \return	A pointer to the initialized String object.  A null pointer
+ *		indicates an error was encountered in object generation.
+ */
 
-	this->reset	= reset;
-	this->whack	= whack;
+extern String_Compact HurdLib_String_Init_compact(void)
 
-	return this;
+{
+	return _create(true);
 }
 
 
@@ -421,3 +663,35 @@ extern String HurdLib_String_Init_cstr(char const * const cstr)
 
 	return this;
 }
+
+
+/**
+ * External constructor call.
+ *
+ * This function implements a constructor call for a String object
+ * which is initialized with the contents of a Buffer object.
+ *
+ * \param bf	The Buffer object whose contents are to be used to
+ *		initialize the String object.
+ *
+ * \return	A pointer to the initialized String.  A NULL value
+ *		indicates an error was encountered in object
+ *		initialization.
+ */
+
+extern String HurdLib_String_Init_Buffer(CO(Buffer, bf))
+
+{
+	String this;
+
+
+	if ( (this = HurdLib_String_Init()) == NULL )
+		return NULL;
+
+	if ( !this->add_Buffer(this, bf) ) {
+		this->whack(this);
+		return NULL;
+	}
+
+	return this;
+}
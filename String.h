@@ -20,6 +20,8 @@ typedef struct HurdLib_String * String;
 
 typedef struct HurdLib_String_State * String_State;
 
+typedef struct HurdLib_String_Compact * String_Compact;
+
 /**
  * External String object representation.
  */
@@ -28,6 +30,9 @@ struct HurdLib_String
 	/* External methods. */
 	_Bool (*add)(const String, char const *);
 	_Bool (*add_sprintf)(const String, const char *, ...);
+	_Bool (*add_Buffer)(const String, const Buffer);
+	_Bool (*add_hex)(const String, const Buffer);
+	_Bool (*add_base64)(const String, const Buffer, enum Buffer_base64);
 
 	char * (*get)(const String);
 	size_t (*size)(const String);
@@ -43,8 +48,25 @@ struct HurdLib_String
 };
 
 
+/**
+ * Compact String object representation.  The object refers to the
+ * method table shared by all String objects rather than holding a copy
+ * of it, its methods are called with the CALL macro.
+ */
+struct HurdLib_String_Compact
+{
+	/* The shared method table. */
+	const struct HurdLib_String *methods;
+
+	/* Private state. */
+	String_State state;
+};
+
+
 /* String constructor calls. */
 extern HCLINK String HurdLib_String_Init(void);
 extern HCLINK String HurdLib_String_Init_cstr(const char *);
+extern HCLINK String HurdLib_String_Init_Buffer(const Buffer);
+extern HCLINK String_Compact HurdLib_String_Init_compact(void);
 
 #endif
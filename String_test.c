@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include "HurdLib.h"
+#include "Buffer.h"
 #include "String.h"
 
 
@@ -31,8 +32,13 @@ extern int main(int argc, char *argv[])
 
 	char bf[512];
 
+	Buffer bufr = NULL,
+	       view = NULL;
+
 	String str = NULL;
 
+	String_Compact cstr = NULL;
+
 
 	INIT(HurdLib, String, str, goto done);
 
@@ -73,12 +79,79 @@ extern int main(int argc, char *argv[])
 		goto done;
 	str->print(str);
 
+	fputs("\nAppending hexadecimal encoding:\n", stdout);
+	INIT(HurdLib, Buffer, bufr, goto done);
+	if ( !bufr->add_hexstring(bufr, "00017f80feff") )
+		goto done;
+	str->reset(str);
+	if ( !str->add(str, "hex: ") )
+		goto done;
+	if ( !str->add_hex(str, bufr) )
+		goto done;
+	str->print(str);
+	if ( strcmp(str->get(str), "hex: 00017f80feff") != 0 ) {
+		fputs("Incorrect hexadecimal encoding.\n", stderr);
+		goto done;
+	}
+
+	fputs("\nAppending base64 encoding:\n", stdout);
+	str->reset(str);
+	if ( !str->add(str, "base64: ") )
+		goto done;
+	if ( !str->add_base64(str, bufr, Buffer_base64_standard) )
+		goto done;
+	if ( !str->add(str, ", url: ") )
+		goto done;
+	if ( !str->add_base64(str, bufr, Buffer_base64_url) )
+		goto done;
+	str->print(str);
+	if ( strcmp(str->get(str), "base64: AAF/gP7/, url: AAF_gP7_") != 0 ) {
+		fputs("Incorrect base64 encoding.\n", stderr);
+		goto done;
+	}
+
+	fputs("\nConstructing from a buffer view:\n", stdout);
+	WHACK(str);
+	bufr->reset(bufr);
+	if ( !bufr->add(bufr, (unsigned char *) "name: value", 11) )
+		goto done;
+	INIT(HurdLib, Buffer, view, goto done);
+	if ( !view->view(view, bufr, 6, 5) )
+		goto done;
+	if ( (str = HurdLib_String_Init_Buffer(view)) == NULL )
+		goto done;
+	str->print(str);
+	if ( strcmp(str->get(str), "value") != 0 ) {
+		fputs("Incorrect string from view.\n", stderr);
+		goto done;
+	}
+
+	fputs("\nUsing a compact string:\n", stdout);
+	CINIT(HurdLib, String, cstr, goto done);
+	if ( !CALL(cstr, add, "compact") )
+		goto done;
+	if ( !CALL(cstr, add_sprintf, ", %d", 2) )
+		goto done;
+	if ( !CALL(cstr, add_hex, bufr) )
+		goto done;
+	CALL(cstr, print);
+	if ( CALL(cstr, size) != 32 )
+		goto done;
+	if ( strcmp(CALL(cstr, get), \
+		    "compact, 26e616d653a2076616c7565") != 0 ) {
+		fputs("Incorrect compact string.\n", stderr);
+		goto done;
+	}
+
 	rc = 0;
 
 
 
  done:
+	WHACK(bufr);
+	WHACK(view);
 	WHACK(str);
+	CWHACK(cstr);
 
 	return rc;
 }